@@ -7,6 +7,7 @@
 #include <errno.h>
 
 #include "aht10.h"
+#include "boot_prof.h"
 
 // 注册日志模块，标签为 AHT10_DRV
 LOG_MODULE_REGISTER(AHT10_DRV, LOG_LEVEL_INF);
@@ -50,6 +51,7 @@ int aht10_init_sensor(const struct i2c_dt_spec *i2c_spec)
 {
     int ret;
     uint8_t init_args[2] = {0x08, 0x00}; // 校准参数，参考数据手册或原厂代码
+    uint8_t status = 0;
 
     // 1. 发送初始化/校准命令 0xE1 0x08 0x00
     ret = aht10_write_cmd(i2c_spec, AHT10_CMD_INIT, init_args, 2);
@@ -58,11 +60,19 @@ int aht10_init_sensor(const struct i2c_dt_spec *i2c_spec)
         return ret;
     }
 
-    // 2. 等待校准完成，手册建议延时几百毫秒
-    k_msleep(400);
+    // 2. 等待校准完成：轮询状态字，空闲且校准位置位即可，不再固定等待 400ms
+    for (int waited = 0; waited < AHT10_INIT_TIMEOUT_MS; waited += AHT10_INIT_POLL_MS) {
+        boot_prof_sleep(AHT10_INIT_POLL_MS);
 
-    LOG_INF("AHT10 initialized.");
-    return 0;
+        ret = i2c_read_dt(i2c_spec, &status, 1);
+        if (ret == 0 && !(status & AHT10_STATUS_BUSY) && (status & AHT10_STATUS_CALIBRATED)) {
+            LOG_INF("AHT10 initialized (%d ms).", waited + AHT10_INIT_POLL_MS);
+            return 0;
+        }
+    }
+
+    LOG_ERR("AHT10 calibration timeout, status 0x%02x", status);
+    return -ETIMEDOUT;
 }
 
 int aht10_read_data(const struct i2c_dt_spec *i2c_spec, aht10_data_t *data)
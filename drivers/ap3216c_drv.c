@@ -7,6 +7,7 @@
 #include <errno.h> 
 
 #include "ap3216c.h"
+#include "boot_prof.h"
 
 // 启用日志记录
 LOG_MODULE_REGISTER(AP3216C_DRV, LOG_LEVEL_INF);
@@ -79,7 +80,7 @@ int ap3216c_reset_sensor(const struct i2c_dt_spec *i2c_spec)
     if (ret != 0) {
         return ret;
     }
-    k_msleep(15); /* 软件复位后需要短暂延时 */
+    boot_prof_sleep(15); /* 软件复位后需要短暂延时 */
     return 0;
 }
 
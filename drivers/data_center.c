@@ -1,7 +1,13 @@
 #include <zephyr/init.h>
+#include <zephyr/linker/section_tags.h>
+#include <zephyr/sys/crc.h>
+#include <errno.h>
+#include <stddef.h>
 #include <string.h>
 #include "data_center.h"
 
+#define DC_SNAPSHOT_CHANNELS  (DC_EVT_ENV | DC_EVT_LUX)
+
 // 实例化全局变量
 /* ：
  * 1. 确保 4 字节对齐（ARM 访问速度最快）
@@ -11,13 +17,51 @@
 // __attribute__((aligned(4)))
 system_data_t g_sys_data = {0};
 
+/* 数据变化事件 (DC_EVT_*) */
+static K_EVENT_DEFINE(dc_events);
+
+/* 无锁副本 (data_center_peek_*)：温度 x100 在高 16 位，湿度 x100 在低 16 位 */
+static atomic_t peek_env;
+static atomic_t peek_lux;
+
+// 调用方需持有 g_sys_data.lock
+static void peek_publish(void)
+{
+    int16_t temp = (int16_t)(g_sys_data.env.temperature * 100.0f);
+    uint16_t humi = (uint16_t)(g_sys_data.env.humidity * 100.0f);
+
+    atomic_set(&peek_env, ((uint32_t)(uint16_t)temp << 16) | humi);
+    atomic_set(&peek_lux, g_sys_data.lux);
+}
+
+/* 热启动快照：放在 __noinit 段，复位时启动代码不会清零，靠 magic + CRC 判断是否有效 */
+static __noinit struct dc_snapshot retained;
+
+static uint32_t snapshot_crc(const struct dc_snapshot *snap)
+{
+    return crc32_ieee((const uint8_t *)snap, offsetof(struct dc_snapshot, crc));
+}
+
+// 调用方需持有 g_sys_data.lock
+static void snapshot_build(struct dc_snapshot *snap)
+{
+    memset(snap, 0, sizeof(*snap));
+    snap->magic = DC_SNAPSHOT_MAGIC;
+    snap->valid = (g_sys_data.fresh | g_sys_data.stale) & DC_SNAPSHOT_CHANNELS;
+    snap->lux = g_sys_data.lux;
+    snap->temp_c100 = (int16_t)(g_sys_data.env.temperature * 100.0f);
+    snap->humi_c100 = (uint16_t)(g_sys_data.env.humidity * 100.0f);
+    snap->crc = snapshot_crc(snap);
+}
+
 void data_center_init(void) {
-    k_mutex_init(&g_sys_data.lock);
     // 注意：手动分配到特殊段的变量，有时不会被系统自动清零，
-    // 所以初始化时最好显式清空。
-    k_mutex_lock(&g_sys_data.lock, K_FOREVER);
+    // 所以初始化时最好显式清空 (先清空再初始化互斥锁，否则锁本身也被清掉)。
     memset(&g_sys_data, 0, sizeof(system_data_t));
-    k_mutex_unlock(&g_sys_data.lock);
+    k_mutex_init(&g_sys_data.lock);
+
+    // 复位前的最近值仍在 RAM 中时，直接恢复为 stale，首帧即可显示
+    data_center_restore_snapshot(&retained);
 }
 
 // 传感器调用：更新温湿度
@@ -25,7 +69,12 @@ void data_center_update_env(aht10_data_t *data) {
     k_mutex_lock(&g_sys_data.lock, K_FOREVER);
     g_sys_data.env = *data;
     g_sys_data.last_update = k_uptime_get_32();
+    g_sys_data.fresh |= DC_EVT_ENV;
+    g_sys_data.stale &= ~DC_EVT_ENV;
+    snapshot_build(&retained);
+    peek_publish();
     k_mutex_unlock(&g_sys_data.lock);
+    k_event_post(&dc_events, DC_EVT_ENV);
 }
 
 // 传感器调用：更新光照
@@ -33,7 +82,12 @@ void data_center_update_lux(uint16_t lux) {
     k_mutex_lock(&g_sys_data.lock, K_FOREVER);
     g_sys_data.lux = lux;
     g_sys_data.last_update = k_uptime_get_32();
+    g_sys_data.fresh |= DC_EVT_LUX;
+    g_sys_data.stale &= ~DC_EVT_LUX;
+    snapshot_build(&retained);
+    peek_publish();
     k_mutex_unlock(&g_sys_data.lock);
+    k_event_post(&dc_events, DC_EVT_LUX);
 }
 
 // 传感器调用：更新IMU数据
@@ -41,7 +95,9 @@ void data_center_update_imu(icm20608_data_t *data) {
     k_mutex_lock(&g_sys_data.lock, K_FOREVER);
     g_sys_data.imu_accel_gyro = *data;
     g_sys_data.last_update = k_uptime_get_32();
+    g_sys_data.fresh |= DC_EVT_IMU;
     k_mutex_unlock(&g_sys_data.lock);
+    k_event_post(&dc_events, DC_EVT_IMU);
 }
 
 // 业务线程调用：获取一份完整的数据快照
@@ -52,6 +108,60 @@ void data_center_get_snapshot(system_data_t *dest) {
     k_mutex_unlock(&g_sys_data.lock);
 }
 
+// 高频调用方：无锁读取最近值
+void data_center_peek_env(int16_t *temp_c100, uint16_t *humi_c100) {
+    uint32_t v = (uint32_t)atomic_get(&peek_env);
+
+    *temp_c100 = (int16_t)(v >> 16);
+    *humi_c100 = (uint16_t)v;
+}
+
+uint16_t data_center_peek_lux(void) {
+    return (uint16_t)atomic_get(&peek_lux);
+}
+
+// 业务线程调用：等待数据变化
+uint32_t data_center_wait(uint32_t mask, k_timeout_t timeout) {
+    if (k_event_wait(&dc_events, mask, false, timeout) == 0) {
+        return 0;
+    }
+    // 等待返回后再原子地取走并清除 mask 内当前置位的事件：
+    // 返回值与清除的位完全一致，两步之间新到的更新也会包含在返回值里，不会丢失
+    return k_event_clear(&dc_events, mask) & mask;
+}
+
+int data_center_export_snapshot(struct dc_snapshot *out) {
+    k_mutex_lock(&g_sys_data.lock, K_FOREVER);
+    snapshot_build(out);
+    k_mutex_unlock(&g_sys_data.lock);
+    return (out->valid != 0) ? 0 : -ENODATA;
+}
+
+int data_center_restore_snapshot(const struct dc_snapshot *snap) {
+    uint8_t todo;
+
+    if (snap->magic != DC_SNAPSHOT_MAGIC || snap->crc != snapshot_crc(snap)) {
+        return -EINVAL;
+    }
+
+    k_mutex_lock(&g_sys_data.lock, K_FOREVER);
+    // 已有实时值或已恢复过的通道保持不变
+    todo = snap->valid & DC_SNAPSHOT_CHANNELS & ~(g_sys_data.fresh | g_sys_data.stale);
+    if (todo & DC_EVT_ENV) {
+        g_sys_data.env.temperature = snap->temp_c100 / 100.0f;
+        g_sys_data.env.humidity = snap->humi_c100 / 100.0f;
+    }
+    if (todo & DC_EVT_LUX) {
+        g_sys_data.lux = snap->lux;
+    }
+    g_sys_data.stale |= todo;
+    peek_publish();
+    k_mutex_unlock(&g_sys_data.lock);
+
+    // 不发布数据变化事件：恢复值不是新的测量，不应触发记录
+    return todo;
+}
+
 static int auto_init_data_center(void)
 {
     data_center_init();
@@ -8,6 +8,7 @@
 #include <zephyr/sys/byteorder.h>
 #include <zephyr/logging/log.h>
 #include "icm20608.h"
+#include "boot_prof.h"
 
 LOG_MODULE_REGISTER(ICM20608_DRV, LOG_LEVEL_INF);
 
@@ -37,13 +38,21 @@ static int icm20608_basic_setup(const struct i2c_dt_spec *i2c_spec)
         return -EIO;
     }
 
-    /* 复位设备 */
+    /* 复位设备：DEVICE_RESET 位由芯片在复位完成后自动清零，轮询它而不是固定等 100ms */
     write_reg(i2c_spec, ICM20608_PWR_MGMT_1, 0x80);
-    k_msleep(100);
+    for (int waited = 0; waited < ICM20608_RESET_TIMEOUT_MS; waited++) {
+        uint8_t pwr = 0x80;
+
+        boot_prof_sleep(1);
+        if (i2c_write_read_dt(i2c_spec, (uint8_t[]){ICM20608_PWR_MGMT_1}, 1, &pwr, 1) == 0 &&
+            !(pwr & 0x80)) {
+            break;
+        }
+    }
 
     /* 唤醒并设置时钟源 (Auto selects best clock) */
     write_reg(i2c_spec, ICM20608_PWR_MGMT_1, 0x01);     
-    k_msleep(10);
+    boot_prof_sleep(10);
     /* 启用加速度计和陀螺仪所有轴 */
     write_reg(i2c_spec, ICM20608_PWR_MGMT_2, 0x00);
     
@@ -58,7 +67,7 @@ static int icm20608_basic_setup(const struct i2c_dt_spec *i2c_spec)
     write_reg(i2c_spec, ICM20608_SMPLRT_DIV, 0x09); // 1kHz / (1 + 9) = 100Hz 输出数据率
 
     LOG_DBG("ICM20608 Basic Setup Done (Range: ±2g, ±250dps)");
-    k_msleep(100); // 等待稳定
+    boot_prof_sleep(ICM20608_GYRO_STARTUP_MS); // 等待陀螺仪启动 (手册典型值 35ms)
     
     return 0;
 }
@@ -122,30 +131,60 @@ int icm20608_init_interrupt(const struct i2c_dt_spec *i2c_spec,
     return 0;
 }
 
-/* 突发读取并转换数据 */
-int icm20608_read_data(const struct i2c_dt_spec *i2c_spec, icm20608_data_t *data)
+/* 突发读取原始数据 */
+int icm20608_read_raw(const struct i2c_dt_spec *i2c_spec, int16_t raw[ICM20608_RAW_WORDS])
 {
-    uint8_t raw[14];
-    int ret = i2c_burst_read_dt(i2c_spec, ICM20608_ACCEL_XOUT_H, raw, 14);
+    uint8_t buf[ICM20608_RAW_WORDS * 2];
+    int ret = i2c_burst_read_dt(i2c_spec, ICM20608_ACCEL_XOUT_H, buf, sizeof(buf));
     if (ret != 0) return ret;
 
-    /* 拼接 16 位有符号数 */
-    int16_t ax = (int16_t)((raw[0] << 8) | raw[1]);
-    int16_t ay = (int16_t)((raw[2] << 8) | raw[3]);
-    int16_t az = (int16_t)((raw[4] << 8) | raw[5]);
-    int16_t temp = (int16_t)((raw[6] << 8) | raw[7]);
-    int16_t gx = (int16_t)((raw[8] << 8) | raw[9]);
-    int16_t gy = (int16_t)((raw[10] << 8) | raw[11]);
-    int16_t gz = (int16_t)((raw[12] << 8) | raw[13]);
+    /* 拼接 16 位有符号数 (寄存器为大端) */
+    for (int i = 0; i < ICM20608_RAW_WORDS; i++) {
+        raw[i] = (int16_t)sys_get_be16(&buf[i * 2]);
+    }
+    return 0;
+}
 
+/* 原始值转换为物理量 */
+void icm20608_convert(const int16_t raw[ICM20608_RAW_WORDS], icm20608_data_t *data)
+{
     /* 物理量转换 (以默认量程为例) */
-    data->accel_x = (float)ax / 16384.0f; // ±2g
-    data->accel_y = (float)ay / 16384.0f;
-    data->accel_z = (float)az / 16384.0f;
-    data->temp = (float)temp / 326.8f + 25.0f;
-    data->gyro_x = (float)gx / 131.0f;   // ±250dps
-    data->gyro_y = (float)gy / 131.0f;
-    data->gyro_z = (float)gz / 131.0f;
+    data->accel_x = (float)raw[0] / 16384.0f; // ±2g
+    data->accel_y = (float)raw[1] / 16384.0f;
+    data->accel_z = (float)raw[2] / 16384.0f;
+    data->temp = (float)raw[3] / 326.8f + 25.0f;
+    data->gyro_x = (float)raw[4] / 131.0f;   // ±250dps
+    data->gyro_y = (float)raw[5] / 131.0f;
+    data->gyro_z = (float)raw[6] / 131.0f;
+}
+
+/* 突发读取并转换数据 */
+int icm20608_read_data(const struct i2c_dt_spec *i2c_spec, icm20608_data_t *data)
+{
+    int16_t raw[ICM20608_RAW_WORDS];
+    int ret = icm20608_read_raw(i2c_spec, raw);
+    if (ret != 0) return ret;
 
+    icm20608_convert(raw, data);
     return 0;
-}
\ No newline at end of file
+}
+
+/* 设置输出数据率 */
+int icm20608_set_odr(const struct i2c_dt_spec *i2c_spec, uint16_t odr_hz)
+{
+    uint8_t div;
+    int ret;
+
+    odr_hz = CLAMP(odr_hz, 4, ICM20608_INTERNAL_RATE_HZ);
+    div = (uint8_t)(ICM20608_INTERNAL_RATE_HZ / odr_hz - 1);
+
+    /* SMPLRT_DIV 只在 DLPF_CFG 为 1~6 时生效：选 DLPF_CFG=1 (陀螺带宽 176Hz)，内部采样率 1kHz */
+    ret = write_reg(i2c_spec, ICM20608_CONFIG, 0x01);
+    ret |= write_reg(i2c_spec, ICM20608_SMPLRT_DIV, div);
+    if (ret != 0) {
+        return -EIO;
+    }
+
+    LOG_DBG("ODR set to %d Hz (SMPLRT_DIV=%d)", ICM20608_INTERNAL_RATE_HZ / (1 + div), div);
+    return ICM20608_INTERNAL_RATE_HZ / (1 + div);
+}
@@ -22,6 +22,11 @@
 #define AHT10_STATUS_BUSY           (1 << 7) /* Bit7: 忙指示 (1=忙, 0=空闲) */
 #define AHT10_STATUS_CALIBRATED     (1 << 3) /* Bit3: 校准使能位 (1=已校准) */
 
+/* 初始化时序 */
+#define AHT10_POWER_ON_MS           40      /* 上电后到可以发送命令的时间 */
+#define AHT10_INIT_POLL_MS          10      /* 校准完成的轮询间隔 */
+#define AHT10_INIT_TIMEOUT_MS       400     /* 校准超时 */
+
 /**
  * @brief AHT10 数据结构体，用于存储转换后的温湿度
  */
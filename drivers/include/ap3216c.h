@@ -13,6 +13,9 @@
 // I2C 地址
 #define AP3216C_ADDR 0x1e /* 7-bit address */
 
+/* ALS + PS 模式下一轮转换的时间 (ALS 100ms + PS 12.5ms)，之后才有第一个有效读数 */
+#define AP3216C_ALS_PS_CONV_MS 120
+
 /* 【声明】外部消息队列：这行代码不产生实际队列，只是一个“入场券” */
 /* 调用文件只要包含此头文件，就能合法地使用 als_msgq */
 extern struct k_msgq als_msgq; 
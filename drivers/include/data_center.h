@@ -18,11 +18,36 @@ typedef struct {
     icm20608_data_t imu_accel_gyro;       // 加速度和陀螺仪数据
     
     uint32_t last_update;    // 最后一次更新的时间戳
+
+    uint8_t fresh;           // 开机后已收到实时数据的通道 (DC_EVT_*)
+    uint8_t stale;           // 当前值来自上次运行的快照、尚未被实时数据替换的通道 (DC_EVT_*)
 } system_data_t;
 
 /* 声明全局变量，让其他 .c 文件都能看到它 */
 extern system_data_t g_sys_data;
 
+/* 数据变化通知：每次 update_* 都会置位对应的事件位 */
+#define DC_EVT_ENV   BIT(0)   // 温湿度
+#define DC_EVT_LUX   BIT(1)   // 光照
+#define DC_EVT_IMU   BIT(2)   // 加速度/陀螺仪
+
+/*
+ * 热启动快照：温湿度和光照的最近值 (IMU 是瞬时量，不保存)。
+ * 数据中心在 __noinit RAM 中随更新维护一份，软件复位/看门狗复位后直接可用；
+ * 断电后 RAM 失效，由 warm_start.c 定期保存到 /lfs 的副本兜底。
+ */
+#define DC_SNAPSHOT_MAGIC  0x50534344u   // "DCSP"
+
+struct dc_snapshot {
+    uint32_t magic;
+    uint8_t valid;           // 有值的通道 (DC_EVT_ENV | DC_EVT_LUX)
+    uint8_t reserved;
+    uint16_t lux;
+    int16_t temp_c100;       // 温度 x100
+    uint16_t humi_c100;      // 湿度 x100
+    uint32_t crc;            // 以上字段的 CRC32
+};
+
 /* 提供线程安全的读写接口 */
 void data_center_init(void);
 void data_center_update_env(aht10_data_t *data);
@@ -30,5 +55,38 @@ void data_center_update_lux(uint16_t lux);
 void data_center_update_imu(icm20608_data_t *data);
 void data_center_get_snapshot(system_data_t *dest);
 
+/**
+ * @brief 无锁读取温湿度/光照的最近值 (×100 定点，与 dc_snapshot 相同)
+ *
+ * 每个通道的值存放在一个原子字里，读取不拿 g_sys_data.lock，
+ * 供 1 kHz 的 IMU 线程等不能等待互斥锁的调用方使用。同一通道内的值总是一致的。
+ */
+void data_center_peek_env(int16_t *temp_c100, uint16_t *humi_c100);
+uint16_t data_center_peek_lux(void);
+
+/**
+ * @brief 等待数据变化通知
+ *
+ * 返回后对应的事件位被清除，所以同一组事件位只应有一个等待者。
+ * @param mask    关心的事件位 (DC_EVT_*)
+ * @param timeout 最长等待时间
+ * @return 期间发生过更新的事件位，超时返回 0
+ */
+uint32_t data_center_wait(uint32_t mask, k_timeout_t timeout);
+
+/**
+ * @brief 导出最近值的快照 (实时值，以及尚未被替换的恢复值)
+ * @return 0 成功, -ENODATA 没有任何可保存的值
+ */
+int data_center_export_snapshot(struct dc_snapshot *out);
+
+/**
+ * @brief 用快照填充还没有实时数据的通道，并标记为 stale
+ *
+ * 已有实时数据 (或已经恢复过) 的通道不会被覆盖，实时数据到来时 stale 位自动清除。
+ * @return 恢复的通道 (DC_EVT_*)，快照无效返回 -EINVAL
+ */
+int data_center_restore_snapshot(const struct dc_snapshot *snap);
+
 
 #endif
\ No newline at end of file
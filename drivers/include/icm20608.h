@@ -29,6 +29,17 @@
 #define ICM20608_PWR_MGMT_2         0x6C
 #define ICM20608_WHO_AM_I           0x75
 
+/* 输出数据率：内部采样率 1kHz (DLPF 开启时)，ODR = 1kHz / (1 + SMPLRT_DIV) */
+#define ICM20608_INTERNAL_RATE_HZ   1000
+#define ICM20608_DEFAULT_ODR_HZ     100
+
+/* 初始化时序 */
+#define ICM20608_RESET_TIMEOUT_MS   100     /* 软复位最长等待时间 */
+#define ICM20608_GYRO_STARTUP_MS    35      /* 陀螺仪从睡眠到输出有效数据的时间 */
+
+/* 一次突发读取的原始寄存器数：Accel XYZ, Temp, Gyro XYZ */
+#define ICM20608_RAW_WORDS          7
+
 /* --- 数据结构定义 --- */
 typedef struct {
     float accel_x, accel_y, accel_z;
@@ -70,4 +81,25 @@ int icm20608_init_interrupt(const struct i2c_dt_spec *i2c_spec,
  */
 int icm20608_read_data(const struct i2c_dt_spec *i2c_spec, icm20608_data_t *data);
 
+/**
+ * @brief 突发读取原始寄存器值 (不做浮点转换，高速采集用)
+ * @param i2c_spec I2C设备规范
+ * @param raw 输出: ax, ay, az, temp, gx, gy, gz
+ * @return 0 成功, 负数 失败
+ */
+int icm20608_read_raw(const struct i2c_dt_spec *i2c_spec, int16_t raw[ICM20608_RAW_WORDS]);
+
+/**
+ * @brief 把原始寄存器值转换为物理量
+ */
+void icm20608_convert(const int16_t raw[ICM20608_RAW_WORDS], icm20608_data_t *data);
+
+/**
+ * @brief 设置输出数据率
+ * @param i2c_spec I2C设备规范
+ * @param odr_hz 目标输出数据率 (4 ~ 1000 Hz)，实际值按分频取整
+ * @return 实际输出数据率 (Hz)，失败返回负数
+ */
+int icm20608_set_odr(const struct i2c_dt_spec *i2c_spec, uint16_t odr_hz);
+
 #endif /* ICM20608_DRIVER_H */
\ No newline at end of file
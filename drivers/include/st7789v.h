@@ -7,12 +7,15 @@
 #define ST7789V_DRIVER_H__
 
 #include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/display.h>
 
 #define ST7789V_CMD_NOP				0x00
 #define ST7789V_CMD_SW_RESET			0x01
 
 #define ST7789V_CMD_SLEEP_IN			0x10
 #define ST7789V_CMD_SLEEP_OUT			0x11
+#define ST7789V_CMD_NORON			0x13	/* 退出局部/滚动模式 */
 #define ST7789V_CMD_INV_OFF			0x20
 #define ST7789V_CMD_INV_ON			0x21
 #define ST7789V_CMD_GAMSET			0x26
@@ -22,6 +25,14 @@
 #define ST7789V_CMD_CASET			0x2a
 #define ST7789V_CMD_RASET			0x2b
 #define ST7789V_CMD_RAMWR			0x2c
+#define ST7789V_CMD_RAMWRC			0x3c	/* 从上次写入结束处继续写 */
+
+#define ST7789V_CMD_VSCRDEF			0x33	/* 垂直滚动区域定义 */
+#define ST7789V_CMD_VSCSAD			0x37	/* 垂直滚动起始地址 */
+
+/* 控制器显存 240 列 x 320 行，小于此尺寸的面板只显示其中一部分 (由 x/y-offset 指定) */
+#define ST7789V_RAM_COLS			240
+#define ST7789V_RAM_ROWS			320
 
 #define ST7789V_CMD_MADCTL			0x36
 #define ST7789V_MADCTL_MY_TOP_TO_BOTTOM		0x00
@@ -68,4 +79,70 @@
 #define ST7789V_CMD_PVGAMCTRL			0xe0
 #define ST7789V_CMD_NVGAMCTRL			0xe1
 
+/* 复位/休眠时序 (ms) */
+#define ST7789V_RESET_READY_MS			5	/* 复位后到可以发送命令 */
+#define ST7789V_SLEEP_OUT_AFTER_RESET_MS	120	/* 复位后到可以发送 SLEEP_OUT */
+#define ST7789V_SLEEP_OUT_READY_MS		5	/* SLEEP_OUT 后到可以发送下一条命令 */
+
+/* 传输统计 (自上电起累计) */
+struct st7789v_stats {
+	uint32_t writes;        /* 像素写入次数 (每次 LVGL flush 一次) */
+	uint32_t transfers;     /* SPI 传输次数 (每次 DC 切换都要单独一次传输) */
+	uint32_t cs_cycles;     /* 片选拉低次数 */
+	uint32_t window_skips;  /* 省略 CASET/RASET 的写入次数 */
+	uint32_t pixel_bytes;   /* 线上发送的像素字节数 (RGB444 时为像素数 x 1.5) */
+};
+
+/**
+ * @brief 读取传输统计
+ */
+void st7789v_get_stats(const struct device *dev, struct st7789v_stats *out);
+
+/**
+ * @brief 切换接口像素格式：RGB444 (12 位) 或 RGB565 (16 位)
+ *
+ * 调用方始终提供 RGB565 像素 (线上字节序，高字节在前)；RGB444 模式下驱动在发送前
+ * 把每两个像素压成 3 字节，SPI 数据量减少 25%。每个通道只剩 16 级，渐变会出现色带。
+ */
+int st7789v_set_rgb444(const struct device *dev, bool enable);
+bool st7789v_is_rgb444(const struct device *dev);
+
+/**
+ * @brief 进入硬件滚动模式 (滚动图)
+ *
+ * 垂直滚动只能沿显存的行方向进行。进入时通过 MADCTL (MX|MV) 把画面旋转 90°，
+ * 使逻辑 x 轴 (时间轴) 沿显存行方向，整屏定义为滚动区。
+ * 之后逻辑分辨率为 高 x 宽，每来一个采样只需写入一列 (宽 1 像素) 再移动滚动起点。
+ */
+int st7789v_scroll_begin(const struct device *dev);
+
+/**
+ * @brief 设置滚动起点：逻辑第 first_col 列显示在屏幕最左侧 (按滚动区宽度取模)
+ */
+int st7789v_scroll_to(const struct device *dev, uint16_t first_col);
+
+/**
+ * @brief 退出滚动模式，恢复原来的方向 (屏幕内容需要整屏重绘)
+ */
+int st7789v_scroll_end(const struct device *dev);
+
+/* 异步写入完成回调，在驱动的传输线程中调用 */
+typedef void (*st7789v_done_cb_t)(const struct device *dev, int result, void *user_data);
+
+/**
+ * @brief 异步写入一块像素数据
+ *
+ * 上一次传输未结束时先等待其完成；提交后立即返回，传输由驱动线程通过 SPI DMA 完成，
+ * 结束时调用 cb。回调之前 buf 必须保持有效且不被修改。
+ */
+int st7789v_write_async(const struct device *dev, uint16_t x, uint16_t y,
+			const struct display_buffer_descriptor *desc, const void *buf,
+			st7789v_done_cb_t cb, void *user_data);
+
+/**
+ * @brief 等待进行中的异步传输结束
+ * @retval -EAGAIN 超时
+ */
+int st7789v_wait_idle(const struct device *dev, k_timeout_t timeout);
+
 #endif
@@ -15,6 +15,7 @@
 
 #include <zephyr/device.h>
 #include <zephyr/drivers/mipi_dbi.h>
+#include <zephyr/drivers/spi.h>
 #include <zephyr/pm/device.h>
 #include <zephyr/sys/byteorder.h>
 #include <zephyr/drivers/display.h>
@@ -31,6 +32,11 @@ LOG_MODULE_REGISTER(st7789_direct, LOG_LEVEL_INF);
 
 #define CONFIG_ST7789V_RGB565
 
+/* 一次 SPI 传输中最多的分散缓冲数 (跨度大于宽度时每行一项，超过时分多次传输) */
+#define ST7789V_SG_MAX_ROWS 32
+/* RGB444 打包缓冲：960 像素 (240 宽时 4 行)，必须是 3 的倍数 */
+#define ST7789V_PACK_BYTES  1440
+
 struct st7789v_config {
 	struct spi_dt_spec spi;       // SPI 总线配置
     struct gpio_dt_spec dc_gpio;  // DC 引脚
@@ -56,12 +62,44 @@ struct st7789v_config {
 	uint8_t rgb_param[3];
 	uint16_t height;
 	uint16_t width;
+	uint16_t x_offset;
+	uint16_t y_offset;
 	uint8_t ready_time_ms;
 };
 
+/* 异步写入请求：LVGL 的缓冲区在完成回调之前保持不变 */
+struct st7789v_async_req {
+	uint16_t x;
+	uint16_t y;
+	struct display_buffer_descriptor desc;
+	const void *buf;
+	st7789v_done_cb_t cb;
+	void *user_data;
+};
+
 struct st7789v_data {
+	/* 当前方向下的逻辑分辨率和显存偏移 (随 MADCTL 变化) */
 	uint16_t x_offset;
 	uint16_t y_offset;
+	uint16_t width;
+	uint16_t height;
+	uint8_t madctl;
+	enum display_orientation orientation;
+	bool scrolling;
+	struct k_sem idle;                 // 总线空闲 (没有进行中的传输)
+	struct st7789v_async_req req;
+	/* 像素写入用的 SPI 配置：整次写入保持片选，结束时 spi_release() */
+	struct spi_config hold_cfg;
+	struct spi_buf sg[ST7789V_SG_MAX_ROWS];
+	/* 控制器当前的写窗口 (RAM 坐标)，以及下一次 RAMWRC 会写到的行 */
+	bool win_valid;
+	uint16_t win_x0;
+	uint16_t win_x1;
+	uint16_t win_y1;
+	uint16_t next_y;
+	struct st7789v_stats stats;
+	bool rgb444;                       // 接口为 12 位 RGB444，发送前打包
+	uint8_t pack_buf[ST7789V_PACK_BYTES];
 };
 
 #ifdef CONFIG_ST7789V_RGB888
@@ -85,9 +123,12 @@ static void st7789v_set_lcd_margins(const struct device *dev,
 static int st7789v_spi_write(const struct device *dev, const uint8_t *data, size_t len)
 {
     const struct st7789v_config *config = dev->config;
+    struct st7789v_data *dev_data = dev->data;
     struct spi_buf buf = {.buf = (void *)data, .len = len};
     struct spi_buf_set tx = {.buffers = &buf, .count = 1};
 
+    dev_data->stats.transfers++;
+    dev_data->stats.cs_cycles++;
     // 使用 Zephyr 标准 SPI 写函数
     return spi_write_dt(&config->spi, &tx);
 }
@@ -130,16 +171,72 @@ static int st7789v_transmit(const struct device *dev, uint8_t cmd,
 	return ret;
 }
 
+/* 各方向相对设备树 mdac 需要翻转的位 (顺时针旋转) */
+static const uint8_t st7789v_orient_madctl[] = {
+	[DISPLAY_ORIENTATION_NORMAL] = 0,
+	[DISPLAY_ORIENTATION_ROTATED_90] = ST7789V_MADCTL_MX_RIGHT_TO_LEFT |
+					   ST7789V_MADCTL_MV_REVERSE_MODE,
+	[DISPLAY_ORIENTATION_ROTATED_180] = ST7789V_MADCTL_MX_RIGHT_TO_LEFT |
+					    ST7789V_MADCTL_MY_BOTTOM_TO_TOP,
+	[DISPLAY_ORIENTATION_ROTATED_270] = ST7789V_MADCTL_MY_BOTTOM_TO_TOP |
+					    ST7789V_MADCTL_MV_REVERSE_MODE,
+};
+
+/*
+ * 写入 MADCTL 并更新逻辑分辨率和偏移。
+ * MY/MX 总是镜像显存的行 (320) / 列 (240) 方向，镜像后面板对应的显存区间从另一端算起；
+ * MV 交换行列，逻辑 x 沿显存行方向。
+ */
+static int st7789v_apply_madctl(const struct device *dev, uint8_t madctl)
+{
+	const struct st7789v_config *config = dev->config;
+	struct st7789v_data *data = dev->data;
+	uint16_t row_ofs = config->y_offset;
+	uint16_t col_ofs = config->x_offset;
+	int ret;
+
+	ret = st7789v_transmit(dev, ST7789V_CMD_MADCTL, &madctl, 1);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (madctl & ST7789V_MADCTL_MY_BOTTOM_TO_TOP) {
+		row_ofs = ST7789V_RAM_ROWS - config->height - config->y_offset;
+	}
+	if (madctl & ST7789V_MADCTL_MX_RIGHT_TO_LEFT) {
+		col_ofs = ST7789V_RAM_COLS - config->width - config->x_offset;
+	}
+
+	if (madctl & ST7789V_MADCTL_MV_REVERSE_MODE) {
+		st7789v_set_lcd_margins(dev, row_ofs, col_ofs);
+		data->width = config->height;
+		data->height = config->width;
+	} else {
+		st7789v_set_lcd_margins(dev, col_ofs, row_ofs);
+		data->width = config->width;
+		data->height = config->height;
+	}
+	data->madctl = madctl;
+	data->win_valid = false;
+	return 0;
+}
+
+/* 最近一次复位完成的时刻，SLEEP_OUT 必须在其后 120ms 才能发送 */
+static int64_t reset_done_ms;
+
 static int st7789v_exit_sleep(const struct device *dev)
 {
 	int ret;
 
+	k_sleep(K_TIMEOUT_ABS_MS(reset_done_ms + ST7789V_SLEEP_OUT_AFTER_RESET_MS));
+
 	ret = st7789v_transmit(dev, ST7789V_CMD_SLEEP_OUT, NULL, 0);
 	if (ret < 0) {
 		return ret;
 	}
 
-	k_sleep(K_MSEC(120));
+	// 退出休眠后 5ms 即可继续发送命令 (120ms 的限制只针对再次进入休眠)
+	k_sleep(K_MSEC(ST7789V_SLEEP_OUT_READY_MS));
 	return ret;
 }
 
@@ -151,36 +248,97 @@ static int st7789v_reset_display(const struct device *dev)
 
 	LOG_DBG("Resetting display");
 
-	k_sleep(K_MSEC(1));
+	/*
+	 * 手册时序：复位脉冲 >= 10us，释放后 5ms 即可发送命令；
+	 * 复位后 120ms 内不能发送 SLEEP_OUT，这一段由 st7789v_exit_sleep() 按绝对时间等待，
+	 * 期间先发送寄存器初始化序列，不再串行地固定等待。
+	 */
 	if (config->rst_gpio.port != NULL) {
-		gpio_pin_set_dt(&config->rst_gpio, 0); // 释放复位
-		k_sleep(K_MSEC(20));
 		gpio_pin_set_dt(&config->rst_gpio, 1); // 拉低复位引脚
-		k_sleep(K_MSEC(50));
+		k_sleep(K_MSEC(1));
 		gpio_pin_set_dt(&config->rst_gpio, 0); // 拉高恢复
-		k_sleep(K_MSEC(150));
+		reset_done_ms = k_uptime_get();
+		k_sleep(K_MSEC(ST7789V_RESET_READY_MS));
 	} else {
 		// 硬件复位引脚不可用时，使用软件复位命令
 		ret = st7789v_transmit(dev, ST7789V_CMD_SW_RESET, NULL, 0);
 		if (ret < 0) {
 			return ret;
 		}
-		k_sleep(K_MSEC(120));
+		reset_done_ms = k_uptime_get();
+		k_sleep(K_MSEC(ST7789V_RESET_READY_MS));
 	}
 
 	return ret;
 }
 
+/* 显示 API 中单独发送的命令，与异步传输互斥 */
+static int st7789v_transmit_locked(const struct device *dev, uint8_t cmd,
+				   const uint8_t *tx_data, size_t tx_count)
+{
+	struct st7789v_data *data = dev->data;
+	int ret;
+
+	k_sem_take(&data->idle, K_FOREVER);
+	ret = st7789v_transmit(dev, cmd, tx_data, tx_count);
+	k_sem_give(&data->idle);
+	return ret;
+}
+
 static int st7789v_blanking_on(const struct device *dev)
 {
-	return st7789v_transmit(dev, ST7789V_CMD_DISP_OFF, NULL, 0);
+	return st7789v_transmit_locked(dev, ST7789V_CMD_DISP_OFF, NULL, 0);
 }
 
 static int st7789v_blanking_off(const struct device *dev)
 {
-	return st7789v_transmit(dev, ST7789V_CMD_DISP_ON, NULL, 0);
+	return st7789v_transmit_locked(dev, ST7789V_CMD_DISP_ON, NULL, 0);
 }
 
+/*
+ * 像素写入序列：片选在整个序列中保持有效 (SPI_HOLD_ON_CS)，
+ * 命令与数据之间只切换 DC 引脚，结束时由 st7789v_seq_end() 释放片选。
+ */
+static int st7789v_seq_write(const struct device *dev, int dc, const struct spi_buf *bufs,
+			     size_t count)
+{
+	const struct st7789v_config *config = dev->config;
+	struct st7789v_data *data = dev->data;
+	const struct spi_buf_set tx = {.buffers = bufs, .count = count};
+
+	gpio_pin_set_dt(&config->dc_gpio, dc);
+	data->stats.transfers++;
+	return spi_write(config->spi.bus, &data->hold_cfg, &tx);
+}
+
+static int st7789v_seq_cmd(const struct device *dev, uint8_t cmd,
+			   const uint8_t *param, size_t len)
+{
+	struct spi_buf buf = {.buf = &cmd, .len = 1};
+	int ret = st7789v_seq_write(dev, 0, &buf, 1);
+
+	if (ret < 0 || len == 0) {
+		return ret;
+	}
+	buf.buf = (void *)param;
+	buf.len = len;
+	return st7789v_seq_write(dev, 1, &buf, 1);
+}
+
+static void st7789v_seq_end(const struct device *dev)
+{
+	const struct st7789v_config *config = dev->config;
+	struct st7789v_data *data = dev->data;
+
+	data->stats.cs_cycles++;
+	spi_release(config->spi.bus, &data->hold_cfg);
+}
+
+/*
+ * 设置写窗口。行方向的结束行总是设为屏幕最后一行：
+ * 下一块像素紧接着上一块 (LVGL 局部刷新时自上而下的条带) 时，
+ * 用 RAMWRC 从上次结束处继续写，不需要再发送 CASET/RASET。
+ */
 static int st7789v_set_mem_area(const struct device *dev, const uint16_t x,
 				 const uint16_t y, const uint16_t w, const uint16_t h)
 {
@@ -192,91 +350,422 @@ static int st7789v_set_mem_area(const struct device *dev, const uint16_t x,
 
 	int ret;
 
+	data->win_valid = false;
+
 	spi_data[0] = sys_cpu_to_be16(ram_x);
 	spi_data[1] = sys_cpu_to_be16(ram_x + w - 1);
-	ret = st7789v_transmit(dev, ST7789V_CMD_CASET, (uint8_t *)&spi_data[0], 4);
+	ret = st7789v_seq_cmd(dev, ST7789V_CMD_CASET, (uint8_t *)&spi_data[0], 4);
 	if (ret < 0) {
 		return ret;
 	}
 
+	uint16_t ram_y1 = MAX(ram_y + h, data->y_offset + data->height) - 1;
+
 	spi_data[0] = sys_cpu_to_be16(ram_y);
-	spi_data[1] = sys_cpu_to_be16(ram_y + h - 1);
-	return st7789v_transmit(dev, ST7789V_CMD_RASET, (uint8_t *)&spi_data[0], 4);
+	spi_data[1] = sys_cpu_to_be16(ram_y1);
+	ret = st7789v_seq_cmd(dev, ST7789V_CMD_RASET, (uint8_t *)&spi_data[0], 4);
+	if (ret < 0) {
+		return ret;
+	}
+
+	data->win_valid = true;
+	data->win_x0 = ram_x;
+	data->win_x1 = ram_x + w - 1;
+	data->win_y1 = ram_y1;
+	return 0;
+}
+
+/*
+ * RGB565 -> RGB444 打包。输入是线上字节序 (高字节在前) 的 RGB565，
+ * 即 LVGL 开启 LV_COLOR_16_SWAP 交换后的缓冲区；每个通道取高 4 位：
+ *   in:  RRRRRGGG GGGBBBBB | rrrrrggg gggbbbbb
+ *   out: RRRRGGGG BBBBrrrr ggggbbbb
+ */
+static inline void st7789v_rgb444_pack2(const uint8_t *in, uint8_t *out)
+{
+	out[0] = (in[0] & 0xf0) | ((in[0] & 0x07) << 1) | (in[1] >> 7);
+	out[1] = ((in[1] << 3) & 0xf0) | (in[2] >> 4);
+	out[2] = ((in[2] & 0x07) << 5) | ((in[3] >> 3) & 0x10) | ((in[3] >> 1) & 0x0f);
+}
+
+/* 按 4 对 (8 像素 -> 12 字节) 展开，循环内没有分支，M4 上每像素约 5 个周期 */
+static void st7789v_rgb444_pack(const uint8_t *in, uint8_t *out, size_t pairs)
+{
+	for (; pairs >= 4; pairs -= 4, in += 16, out += 12) {
+		st7789v_rgb444_pack2(in, out);
+		st7789v_rgb444_pack2(in + 4, out + 3);
+		st7789v_rgb444_pack2(in + 8, out + 6);
+		st7789v_rgb444_pack2(in + 12, out + 9);
+	}
+	for (; pairs > 0; pairs--, in += 4, out += 3) {
+		st7789v_rgb444_pack2(in, out);
+	}
+}
+
+/*
+ * RGB444 模式的像素数据：逐行打包到打包缓冲，满了就发送一次 (片选保持)。
+ * 行宽为奇数时最后一个像素与下一行的第一个像素拼成一对；
+ * 整块像素数为奇数时末尾只发 2 字节，控制器丢弃不完整的半个像素。
+ */
+static int st7789v_write_rgb444(const struct device *dev,
+				const struct display_buffer_descriptor *desc,
+				const uint8_t *pixel_data)
+{
+	struct st7789v_data *data = dev->data;
+	uint8_t *const end = data->pack_buf + sizeof(data->pack_buf);
+	uint8_t *out = data->pack_buf;
+	struct spi_buf sb = {.buf = data->pack_buf};
+	uint8_t pair[4];
+	bool has_carry = false;
+	int ret = 0;
+
+	for (uint16_t row = 0; row < desc->height && ret == 0; row++) {
+		const uint8_t *in = pixel_data + (size_t)row * desc->pitch * 2U;
+		size_t n = desc->width;
+
+		while (n > 0 && ret == 0) {
+			size_t room = (end - out) / 3;
+
+			if (room == 0) {
+				sb.len = out - data->pack_buf;
+				ret = st7789v_seq_write(dev, 1, &sb, 1);
+				data->stats.pixel_bytes += sb.len;
+				out = data->pack_buf;
+			} else if (has_carry) {
+				pair[2] = in[0];
+				pair[3] = in[1];
+				st7789v_rgb444_pack2(pair, out);
+				out += 3;
+				in += 2;
+				n--;
+				has_carry = false;
+			} else if (n == 1) {
+				pair[0] = in[0];
+				pair[1] = in[1];
+				has_carry = true;
+				n = 0;
+			} else {
+				size_t pairs = MIN(n / 2, room);
+
+				st7789v_rgb444_pack(in, out, pairs);
+				in += pairs * 4;
+				out += pairs * 3;
+				n -= pairs * 2;
+			}
+		}
+	}
+
+	if (ret == 0 && has_carry) {
+		if (end - out < 2) {
+			sb.len = out - data->pack_buf;
+			ret = st7789v_seq_write(dev, 1, &sb, 1);
+			data->stats.pixel_bytes += sb.len;
+			out = data->pack_buf;
+		}
+		pair[2] = 0;
+		pair[3] = 0;
+		st7789v_rgb444_pack2(pair, out);
+		out += 2;
+	}
+	if (ret == 0 && out > data->pack_buf) {
+		sb.len = out - data->pack_buf;
+		ret = st7789v_seq_write(dev, 1, &sb, 1);
+		data->stats.pixel_bytes += sb.len;
+	}
+	return ret;
 }
 
 /**
- * @brief 强壮版写入函数：支持处理非连续内存 (Pitch > Width)
- * * @param dev   设备句柄
+ * @brief 写入一块像素：一次片选内完成 [CASET/RASET] + RAMWR(C) + 像素数据
+ * @param dev   设备句柄
  * @param x     起始横坐标
  * @param y     起始纵坐标
  * @param desc  缓冲区描述符（包含宽度、高度、跨度等）
  * @param buf   实际像素数据指针
+ *
+ * 跨度大于宽度 (Pitch > Width) 时，每行的有效像素作为一项分散缓冲，
+ * 同一次 SPI 传输中连续发出，而不是每行一次传输。
+ * RGB444 模式下像素先打包，每 ST7789V_PACK_BYTES 字节一次传输。
  */
+static int st7789v_write_locked(const struct device *dev,
+				const uint16_t x,
+				const uint16_t y,
+				const struct display_buffer_descriptor *desc,
+				const void *buf)
+{
+	struct st7789v_data *data = dev->data;
+	const uint8_t *pixel_data = (const uint8_t *)buf;
+	uint16_t ram_x = x + data->x_offset;
+	uint16_t ram_y = y + data->y_offset;
+	uint8_t cmd = ST7789V_CMD_RAMWR;
+	int ret;
+
+	if (desc->pitch < desc->width) {
+		LOG_ERR("Pitch (%d) cannot be smaller than width (%d)", desc->pitch, desc->width);
+		return -EINVAL;
+	}
+
+	data->stats.writes++;
+
+	/* 窗口列范围不变且紧接上次写入的位置：继续写，省掉 4 次传输 */
+	if (data->win_valid && ram_x == data->win_x0 && ram_x + desc->width - 1 == data->win_x1 &&
+	    ram_y == data->next_y && ram_y + desc->height - 1 <= data->win_y1) {
+		cmd = ST7789V_CMD_RAMWRC;
+		data->stats.window_skips++;
+		ret = 0;
+	} else {
+		ret = st7789v_set_mem_area(dev, x, y, desc->width, desc->height);
+	}
+
+	if (ret == 0) {
+		ret = st7789v_seq_cmd(dev, cmd, NULL, 0);
+	}
+
+	if (ret == 0 && data->rgb444) {
+		ret = st7789v_write_rgb444(dev, desc, pixel_data);
+	} else if (ret == 0 && desc->pitch == desc->width) {
+		/* 内存连续：整块一次发送 */
+		data->sg[0].buf = (void *)pixel_data;
+		data->sg[0].len = desc->buf_size;
+		ret = st7789v_seq_write(dev, 1, data->sg, 1);
+		data->stats.pixel_bytes += desc->buf_size;
+	} else if (ret == 0) {
+		/* 内存不连续：每行的有效像素组成分散缓冲表 */
+		size_t row_bytes = desc->width * ST7789V_PIXEL_SIZE;
+		uint16_t row = 0;
+
+		while (ret == 0 && row < desc->height) {
+			size_t n = MIN(desc->height - row, ST7789V_SG_MAX_ROWS);
+
+			for (size_t i = 0; i < n; i++, row++) {
+				data->sg[i].buf = (void *)pixel_data;
+				data->sg[i].len = row_bytes;
+				pixel_data += desc->pitch * ST7789V_PIXEL_SIZE;
+			}
+			ret = st7789v_seq_write(dev, 1, data->sg, n);
+			data->stats.pixel_bytes += n * row_bytes;
+		}
+	}
+
+	st7789v_seq_end(dev);
+
+	if (ret < 0) {
+		// 传输中断时控制器的写指针不确定，下次重新设置窗口
+		data->win_valid = false;
+	} else {
+		data->next_y = ram_y + desc->height;
+	}
+	return ret;
+}
+
 static int st7789v_write(const struct device *dev,
-             const uint16_t x,
-             const uint16_t y,
-             const struct display_buffer_descriptor *desc,
-             const void *buf)
-{
-    int ret;
-    const uint8_t *pixel_data = (const uint8_t *)buf;
-    
-    /* 1. 安全检查：确保跨度（Pitch）合法 */
-    if (desc->pitch < desc->width) {
-        LOG_ERR("Pitch (%d) cannot be smaller than width (%d)", desc->pitch, desc->width);
-        return -EINVAL;
-    }
+			 const uint16_t x,
+			 const uint16_t y,
+			 const struct display_buffer_descriptor *desc,
+			 const void *buf)
+{
+	struct st7789v_data *data = dev->data;
+	int ret;
 
-    /* 2. 设置屏幕窗口：告诉屏幕我们要画在哪个矩形区域 */
-    ret = st7789v_set_mem_area(dev, x, y, desc->width, desc->height);
-    if (ret < 0) {
-        return ret;
-    }
+	/* 等待进行中的异步传输结束，保证命令和像素数据的顺序 */
+	k_sem_take(&data->idle, K_FOREVER);
+	ret = st7789v_write_locked(dev, x, y, desc, buf);
+	k_sem_give(&data->idle);
+	return ret;
+}
 
-    /* 3. 发送写 RAM 命令 (0x2C) */
-    ret = st7789v_write_cmd(dev, ST7789V_CMD_RAMWR);
-    if (ret < 0) {
-        return ret;
-    }
+/*
+ * 异步写入由专用线程执行：STM32 SPI 驱动的 DMA 路径只支持阻塞调用，
+ * 在线程中调用时 CPU 在 DMA 传输期间让给 LVGL 渲染下一条带，
+ * 传输结束后在该线程中调用完成回调。
+ */
+K_MSGQ_DEFINE(st7789v_async_q, sizeof(const struct device *), 1, 4);
 
-    /* 4. 数据传输逻辑：判断是否需要分行发送 */
-    if (desc->pitch == desc->width) {
-        /* 【情况 A：内存连续】
-         * 跨度等于宽度，说明内存里没有“空隙”。
-         * 我们可以把整个缓冲区作为一整块，一次性通过 SPI 发送出去，效率最高。
-         */
-        ret = st7789v_write_data(dev, pixel_data, desc->buf_size);
-    } else {
-        /* 【情况 B：内存不连续 (Pitch > Width)】
-         * 说明每一行像素后面跟着一段无用的“填充数据”。
-         * 我们必须通过循环，每一行只发送有效宽度的数据，然后跳过填充部分。
-         */
-        for (uint16_t row = 0; row < desc->height; row++) {
-            /* 发送当前行的有效像素数据 */
-            size_t row_bytes = desc->width * ST7789V_PIXEL_SIZE;
-            ret = st7789v_write_data(dev, pixel_data, row_bytes);
-            if (ret < 0) {
-                return ret;
-            }
-
-            /* 将指针移动到下一行的起始位置：
-             * 指针跳过的是整个 Pitch 的长度
-             */
-            pixel_data += (desc->pitch * ST7789V_PIXEL_SIZE);
-        }
-    }
+int st7789v_write_async(const struct device *dev, uint16_t x, uint16_t y,
+			const struct display_buffer_descriptor *desc, const void *buf,
+			st7789v_done_cb_t cb, void *user_data)
+{
+	struct st7789v_data *data = dev->data;
+
+	if (desc->pitch < desc->width) {
+		return -EINVAL;
+	}
+
+	/* 同一时刻只有一个请求：上一次传输结束 (idle 归还) 后才能提交 */
+	k_sem_take(&data->idle, K_FOREVER);
+	data->req = (struct st7789v_async_req){
+		.x = x,
+		.y = y,
+		.desc = *desc,
+		.buf = buf,
+		.cb = cb,
+		.user_data = user_data,
+	};
+	k_msgq_put(&st7789v_async_q, &dev, K_FOREVER);
+	return 0;
+}
+
+int st7789v_wait_idle(const struct device *dev, k_timeout_t timeout)
+{
+	struct st7789v_data *data = dev->data;
+
+	if (k_sem_take(&data->idle, timeout) < 0) {
+		return -EAGAIN;
+	}
+	k_sem_give(&data->idle);
+	return 0;
+}
+
+int st7789v_set_rgb444(const struct device *dev, bool enable)
+{
+	const struct st7789v_config *config = dev->config;
+	struct st7789v_data *data = dev->data;
+	uint8_t tmp = (config->colmod & 0xf0) |
+		      (enable ? ST7789V_COLMOD_FMT_12bit : ST7789V_COLMOD_FMT_16bit);
+	int ret;
+
+	if (enable && ST7789V_PIXEL_SIZE != 2u) {
+		return -ENOTSUP;
+	}
+
+	k_sem_take(&data->idle, K_FOREVER);
+	ret = st7789v_transmit(dev, ST7789V_CMD_COLMOD, &tmp, 1);
+	if (ret == 0) {
+		data->rgb444 = enable;
+	}
+	k_sem_give(&data->idle);
+	return ret;
+}
+
+bool st7789v_is_rgb444(const struct device *dev)
+{
+	struct st7789v_data *data = dev->data;
+
+	return data->rgb444;
+}
+
+/* 滚动区就是面板在显存行方向上占用的区间 */
+static uint16_t st7789v_scroll_top(const struct device *dev)
+{
+	const struct st7789v_config *config = dev->config;
+	struct st7789v_data *data = dev->data;
+
+	return (data->madctl & ST7789V_MADCTL_MY_BOTTOM_TO_TOP)
+	       ? ST7789V_RAM_ROWS - config->height - config->y_offset : config->y_offset;
+}
+
+int st7789v_scroll_begin(const struct device *dev)
+{
+	const struct st7789v_config *config = dev->config;
+	struct st7789v_data *data = dev->data;
+	uint16_t param[3];
+	uint16_t tfa;
+	int ret;
+
+	k_sem_take(&data->idle, K_FOREVER);
+	/* 不论当前方向，滚动图固定使用旋转 90° (MX|MV)：行方向不镜像，滚动区即面板所在的行 */
+	ret = st7789v_apply_madctl(dev, config->mdac ^
+				   st7789v_orient_madctl[DISPLAY_ORIENTATION_ROTATED_90]);
+	if (ret == 0) {
+		tfa = st7789v_scroll_top(dev);
+		param[0] = sys_cpu_to_be16(tfa);
+		param[1] = sys_cpu_to_be16(config->height);
+		param[2] = sys_cpu_to_be16(ST7789V_RAM_ROWS - tfa - config->height);
+		ret = st7789v_transmit(dev, ST7789V_CMD_VSCRDEF, (uint8_t *)param, sizeof(param));
+	}
+	if (ret == 0) {
+		param[0] = sys_cpu_to_be16(tfa);
+		ret = st7789v_transmit(dev, ST7789V_CMD_VSCSAD, (uint8_t *)param, 2);
+	}
+	data->scrolling = (ret == 0);
+	k_sem_give(&data->idle);
+	return ret;
+}
+
+int st7789v_scroll_to(const struct device *dev, uint16_t first_col)
+{
+	const struct st7789v_config *config = dev->config;
+	struct st7789v_data *data = dev->data;
+	uint16_t vsp;
+	int ret;
+
+	k_sem_take(&data->idle, K_FOREVER);
+	if (!data->scrolling) {
+		k_sem_give(&data->idle);
+		return -EINVAL;
+	}
+	vsp = sys_cpu_to_be16(st7789v_scroll_top(dev) + first_col % config->height);
+	ret = st7789v_transmit(dev, ST7789V_CMD_VSCSAD, (uint8_t *)&vsp, 2);
+	k_sem_give(&data->idle);
+	return ret;
+}
+
+int st7789v_scroll_end(const struct device *dev)
+{
+	const struct st7789v_config *config = dev->config;
+	struct st7789v_data *data = dev->data;
+	uint16_t vsp;
+	int ret;
+
+	k_sem_take(&data->idle, K_FOREVER);
+	vsp = sys_cpu_to_be16(st7789v_scroll_top(dev));
+	ret = st7789v_transmit(dev, ST7789V_CMD_VSCSAD, (uint8_t *)&vsp, 2);
+	if (ret == 0) {
+		ret = st7789v_transmit(dev, ST7789V_CMD_NORON, NULL, 0);
+	}
+	if (ret == 0) {
+		ret = st7789v_apply_madctl(dev, config->mdac ^
+					   st7789v_orient_madctl[data->orientation]);
+	}
+	if (ret == 0) {
+		data->scrolling = false;
+	}
+	k_sem_give(&data->idle);
+	return ret;
+}
+
+void st7789v_get_stats(const struct device *dev, struct st7789v_stats *out)
+{
+	struct st7789v_data *data = dev->data;
 
-    return ret;
+	*out = data->stats;
 }
 
+static void st7789v_async_thread(void *p1, void *p2, void *p3)
+{
+	const struct device *dev;
+
+	while (1) {
+		k_msgq_get(&st7789v_async_q, &dev, K_FOREVER);
+
+		struct st7789v_data *data = dev->data;
+		struct st7789v_async_req *req = &data->req;
+		int ret = st7789v_write_locked(dev, req->x, req->y, &req->desc, req->buf);
+
+		if (req->cb != NULL) {
+			req->cb(dev, ret, req->user_data);
+		}
+		k_sem_give(&data->idle);
+	}
+}
+
+/* 优先级高于显示线程：传输一结束就通知 LVGL */
+#define ST7789V_ASYNC_STACK_SIZE	1024
+#define ST7789V_ASYNC_PRIORITY		4
+
+K_THREAD_DEFINE(st7789v_async_tid, ST7789V_ASYNC_STACK_SIZE,
+		st7789v_async_thread, NULL, NULL, NULL,
+		ST7789V_ASYNC_PRIORITY, 0, 0);
+
 static void st7789v_get_capabilities(const struct device *dev,
 			      struct display_capabilities *capabilities)
 {
-	const struct st7789v_config *config = dev->config;
+	struct st7789v_data *data = dev->data;
 
+	/* 当前方向下的分辨率 (MADCTL 交换行列时宽高互换) */
 	memset(capabilities, 0, sizeof(struct display_capabilities));
-	capabilities->x_resolution = config->width;
-	capabilities->y_resolution = config->height;
+	capabilities->x_resolution = data->width;
+	capabilities->y_resolution = data->height;
 
 #ifdef CONFIG_ST7789V_RGB565
 	capabilities->supported_pixel_formats = PIXEL_FORMAT_RGB_565;
@@ -288,7 +777,7 @@ static void st7789v_get_capabilities(const struct device *dev,
 	capabilities->supported_pixel_formats = PIXEL_FORMAT_RGB_888;
 	capabilities->current_pixel_format = PIXEL_FORMAT_RGB_888;
 #endif
-	capabilities->current_orientation = DISPLAY_ORIENTATION_NORMAL;
+	capabilities->current_orientation = data->orientation;
 }
 
 static int st7789v_set_pixel_format(const struct device *dev,
@@ -307,14 +796,33 @@ static int st7789v_set_pixel_format(const struct device *dev,
 	return -ENOTSUP;
 }
 
+/*
+ * 硬件旋转：改写 MADCTL 的 MX/MY/MV，控制器按新的扫描顺序写显存，
+ * LVGL 不需要软件旋转。调用方负责按新的分辨率重绘整屏。
+ */
 static int st7789v_set_orientation(const struct device *dev,
 			    const enum display_orientation orientation)
 {
-	if (orientation == DISPLAY_ORIENTATION_NORMAL) {
-		return 0;
+	const struct st7789v_config *config = dev->config;
+	struct st7789v_data *data = dev->data;
+	int ret;
+
+	if (orientation >= ARRAY_SIZE(st7789v_orient_madctl)) {
+		return -EINVAL;
 	}
-	LOG_ERR("Changing display orientation not implemented");
-	return -ENOTSUP;
+
+	k_sem_take(&data->idle, K_FOREVER);
+	if (data->scrolling) {
+		// 滚动图模式固定使用旋转 90°，退出时再恢复 data->orientation
+		ret = -EBUSY;
+	} else {
+		ret = st7789v_apply_madctl(dev, config->mdac ^ st7789v_orient_madctl[orientation]);
+		if (ret == 0) {
+			data->orientation = orientation;
+		}
+	}
+	k_sem_give(&data->idle);
+	return ret;
 }
 
 static int st7789v_lcd_init(const struct device *dev)
@@ -324,9 +832,6 @@ static int st7789v_lcd_init(const struct device *dev)
 	uint8_t tmp;
 	int ret = 0;
 
-	st7789v_set_lcd_margins(dev, data->x_offset,
-				data->y_offset);
-
 	ret = st7789v_transmit(dev, ST7789V_CMD_CMD2EN,
 			       (uint8_t *)config->cmd2en_param,
 			       sizeof(config->cmd2en_param));
@@ -394,19 +899,21 @@ static int st7789v_lcd_init(const struct device *dev)
 		return ret;
 	}
 
-	/* Memory Data Access Control */
-	tmp = config->mdac;
-	ret = st7789v_transmit(dev, ST7789V_CMD_MADCTL, &tmp, 1);
+	/* Memory Data Access Control (同时确定逻辑分辨率和显存偏移) */
+	data->orientation = DISPLAY_ORIENTATION_NORMAL;
+	ret = st7789v_apply_madctl(dev, config->mdac);
 	if (ret < 0) {
 		return ret;
 	}
 
-	/* Interface Pixel Format */
+	/* Interface Pixel Format (低 4 位为 3 时使用 12 位 RGB444，驱动负责打包) */
 	tmp = config->colmod;
 	ret = st7789v_transmit(dev, ST7789V_CMD_COLMOD, &tmp, 1);
 	if (ret < 0) {
 		return ret;
 	}
+	data->rgb444 = (ST7789V_PIXEL_SIZE == 2u) &&
+		       ((config->colmod & 0x0f) == ST7789V_COLMOD_FMT_12bit);
 
 	tmp = config->lcm;
 	ret = st7789v_transmit(dev, ST7789V_CMD_LCMCTRL, &tmp, 1);
@@ -496,8 +1003,14 @@ static int st7789v_set_backlight(const struct device *dev, uint8_t brightness)
 static int st7789v_init(const struct device *dev)
 {
 	const struct st7789v_config *config = dev->config;
+	struct st7789v_data *data = dev->data;
 	int ret = 0;
 
+	k_sem_init(&data->idle, 1, 1);
+	data->hold_cfg = config->spi.config;
+	data->hold_cfg.operation |= SPI_HOLD_ON_CS | SPI_LOCK_ON;
+	data->win_valid = false;
+
 	// 检查硬件是否就绪
 	if (!spi_is_ready_dt(&config->spi)) {
 		LOG_ERR("SPI device not ready");
@@ -521,9 +1034,6 @@ static int st7789v_init(const struct device *dev)
 		gpio_pin_configure_dt(&config->rst_gpio, GPIO_OUTPUT_INACTIVE);
 	}
 
-	/* 初始化时开启背光 (假设设为100%) */
-    st7789v_set_backlight(dev, 100);
-
 	// 设备复位
 	ret = st7789v_reset_display(dev);
 	if (ret < 0) {
@@ -549,17 +1059,11 @@ static int st7789v_init(const struct device *dev)
 		return ret;
 	}
 
-	// 重要：退出休眠后必须等待 120ms 
-	k_sleep(K_MSEC(120));
-
-	// 明确开启显示 (发送指令 0x29)
-    // 注意：st7789v_blanking_off 内部封装了 ST7789V_CMD_DISP_ON
-	ret = st7789v_blanking_off(dev);
-	if (ret < 0) {
-		LOG_ERR("Failed to turn on display (%d)", ret);
-		return ret;
-	}
-
+	/*
+	 * 保持消隐 (DISP_OFF)、不开背光：GRAM 此时是未初始化的内容。
+	 * 由 display_thread 在开机画面或首帧写入后调用 display_blanking_off() 并打开背光，
+	 * 开机画面校验失败时屏幕一直消隐到首帧渲染完成。
+	 */
 	LOG_DBG("ST7789V 驱动初始化序列全部发送成功");
 	return ret;
 }
@@ -568,10 +1072,13 @@ static int st7789v_init(const struct device *dev)
 static int st7789v_pm_action(const struct device *dev,
 			     enum pm_device_action action)
 {
+	struct st7789v_data *data = dev->data;
 	int ret;
 
+	k_sem_take(&data->idle, K_FOREVER);
 	switch (action) {
 	case PM_DEVICE_ACTION_RESUME:
+		data->win_valid = false;
 		ret = st7789v_exit_sleep(dev);
 		break;
 	case PM_DEVICE_ACTION_SUSPEND:
@@ -581,6 +1088,7 @@ static int st7789v_pm_action(const struct device *dev,
 		ret = -ENOTSUP;
 		break;
 	}
+	k_sem_give(&data->idle);
 
 	return ret;
 }
@@ -623,14 +1131,13 @@ static DEVICE_API(display, st7789v_api) = {
 		.rgb_param = DT_INST_PROP(inst, rgb_param),				\
 		.width = DT_INST_PROP(inst, width),					\
 		.height = DT_INST_PROP(inst, height),					\
-		.ready_time_ms = DT_INST_PROP(inst, ready_time_ms),			\
-	};										\
-											\
-	static struct st7789v_data st7789v_data_ ## inst = {				\
 		.x_offset = DT_INST_PROP(inst, x_offset),				\
 		.y_offset = DT_INST_PROP(inst, y_offset),				\
+		.ready_time_ms = DT_INST_PROP(inst, ready_time_ms),			\
 	};										\
 											\
+	static struct st7789v_data st7789v_data_ ## inst;				\
+											\
 	PM_DEVICE_DT_INST_DEFINE(inst, st7789v_pm_action);				\
 											\
 	DEVICE_DT_INST_DEFINE(inst, &st7789v_init, PM_DEVICE_DT_INST_GET(inst),		\
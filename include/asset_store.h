@@ -0,0 +1,170 @@
+/**
+ * @file asset_store.h
+ * @brief chinese-font 分区中的字体/图片资源包 (XIP 直接访问)
+ *
+ * tools/asset_pack.py 把 lv_font_conv 生成的字体 (含大型中文字库) 和图片打包成一个资源包，
+ * 烧录到 font_partition。QSPI 工作在内存映射模式 (CONFIG_STM32_MEMMAP)，
+ * 字形位图、字形描述表、图片像素都直接从 0x90000000 映射窗口读取，不复制到 RAM；
+ * RAM 中只保留每个字体/图片几十字节的 LVGL 描述结构。
+ *
+ * native_sim 上使用 Flash 模拟器：模拟器的存储就是用 mmap 映射的主机文件
+ * (运行参数 --flash=<文件>)，用 asset_pack.py --flash-image 把资源包写进该文件的分区偏移处即可，
+ * 代码路径与硬件完全相同。
+ *
+ * 内存映射模式在 Flash 写入/擦除期间会被驱动关闭，此时访问映射窗口会触发总线错误。
+ * 因此资源包已映射时，flash_area 写/擦除 (见 flash_stats.c 的包装函数) 与读取资源的 LVGL 渲染
+ * 都要通过 asset_xip_lock_if_mapped() 互斥，写完后由 asset_xip_remap() 重新进入内存映射模式。
+ * 没有资源包时没有人读映射窗口，两边都不加锁。
+ *
+ * 资源包格式 (小端)：
+ *   struct asset_pack_hdr
+ *   struct asset_entry[count]
+ *   各资源数据 (4 字节对齐，偏移相对资源包起始)
+ */
+
+#ifndef ASSET_STORE_H
+#define ASSET_STORE_H
+
+#include <zephyr/types.h>
+#include <sys/types.h>
+#include <lvgl.h>
+
+/* ---------------- 配置参数 ---------------- */
+#define ASSET_PACK_MAGIC      0x50545341u   // "ASTP"
+#define ASSET_PACK_VERSION    1
+#define ASSET_NAME_LEN        24
+#define ASSET_MAX_FONTS       4              // 同时加载的字体数
+#define ASSET_MAX_CMAPS       8              // 每个字体的字符映射段数
+#define ASSET_MAX_IMAGES      8              // 同时加载的图片数
+
+enum asset_type {
+    ASSET_TYPE_FONT = 1,
+    ASSET_TYPE_IMAGE = 2,
+};
+
+struct asset_pack_hdr {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t count;          // 资源条目数
+    uint32_t total_size;     // 资源包总字节数 (含本头部)
+    uint32_t crc;            // 头部之后全部内容的 CRC32
+} __packed;
+
+struct asset_entry {
+    char name[ASSET_NAME_LEN];
+    uint8_t type;            // enum asset_type
+    uint8_t reserved[3];
+    uint32_t offset;
+    uint32_t size;
+} __packed;
+
+/*
+ * 字体资源：头部 + 字形描述表 + 位图 + 字符映射表，偏移相对字体资源起始。
+ * 字形描述表的内存布局与 lv_font_fmt_txt_glyph_dsc_t 相同 (由 large 标志区分两种布局)，
+ * 可以直接作为 LVGL 的 glyph_dsc 使用。
+ */
+#define ASSET_FONT_FLAG_LARGE  BIT(0)        // 对应 CONFIG_LV_FONT_FMT_TXT_LARGE
+
+struct asset_font_hdr {
+    uint16_t line_height;
+    int16_t base_line;
+    int8_t underline_position;
+    uint8_t underline_thickness;
+    uint8_t bpp;
+    uint8_t bitmap_format;   // 0 原始, 1 压缩 (与 lv_font_fmt_txt 相同)
+    uint16_t cmap_num;
+    uint16_t glyph_count;
+    uint8_t flags;           // ASSET_FONT_FLAG_*
+    uint8_t reserved[3];
+    uint32_t glyph_dsc_off;
+    uint32_t bitmap_off;
+    uint32_t cmaps_off;      // struct asset_font_cmap[cmap_num]
+} __packed;
+
+struct asset_font_cmap {
+    uint32_t range_start;
+    uint16_t range_length;
+    uint16_t glyph_id_start;
+    uint32_t unicode_list_off;       // 0 表示无
+    uint32_t glyph_id_ofs_list_off;  // 0 表示无
+    uint16_t list_length;
+    uint8_t type;                    // lv_font_fmt_txt_cmap_type_t
+    uint8_t reserved;
+} __packed;
+
+/* 图片资源：头部 + 像素数据 (4 字节对齐) */
+struct asset_image_hdr {
+    uint8_t cf;              // lv_color_format_t
+    uint8_t reserved;
+    uint16_t w;
+    uint16_t h;
+    uint16_t stride;
+    uint32_t data_size;
+} __packed;
+
+/**
+ * @brief 检查资源包头部 (开机时自动调用)
+ * @return 0 成功, -ENOENT 分区中没有资源包, -EINVAL 头部无效
+ */
+int asset_store_init(void);
+
+/**
+ * @brief 资源包是否可用
+ */
+bool asset_store_ready(void);
+
+/**
+ * @brief 按序号获取资源条目 (用于列出)
+ * @return 条目指针 (指向映射窗口)，越界返回 NULL
+ */
+const struct asset_entry *asset_store_entry(int idx);
+
+/**
+ * @brief 全量 CRC 校验 (读取整个资源包，耗时较长)
+ * @return 0 一致, -EBADMSG 不一致, -ENOENT 没有资源包
+ */
+int asset_store_verify(void);
+
+/**
+ * @brief 按名称获取字体
+ *
+ * 第一次调用时在 RAM 中建立 LVGL 字体描述 (字形数据仍在映射窗口中)，之后返回同一个对象。
+ * @return 字体指针，找不到或格式不支持时返回 NULL
+ */
+const lv_font_t *asset_font_get(const char *name);
+
+/**
+ * @brief 按名称获取图片描述，像素数据直接指向映射窗口
+ * @return 图片描述指针，找不到时返回 NULL
+ */
+const lv_image_dsc_t *asset_image_get(const char *name);
+
+/**
+ * @brief 获取/释放映射窗口的访问权
+ *
+ * LVGL 渲染 (会读取映射窗口) 和 Flash 写入/擦除 (会关闭内存映射) 互斥。
+ */
+void asset_xip_lock(void);
+void asset_xip_unlock(void);
+
+/**
+ * @brief 仅在资源包已映射时获取映射窗口的访问权
+ *
+ * 资源包在开机初始化 (早于所有线程) 时确定，之后不再变化。
+ * 持有时间应尽量短：Flash 写入方只锁单次写/擦除，渲染方只锁一次 LVGL 渲染。
+ * @return true 已加锁 (用完调用 asset_xip_unlock())，false 没有资源包、未加锁
+ */
+bool asset_xip_lock_if_mapped(void);
+
+/**
+ * @brief W25Q128 上某个偏移在映射窗口中的地址 (native_sim 上为模拟器内存)
+ * @return 地址，超出模拟器范围时返回 NULL
+ */
+const uint8_t *asset_xip_ptr(off_t off);
+
+/**
+ * @brief Flash 写入/擦除后重新进入内存映射模式 (需持有 asset_xip_lock)
+ */
+void asset_xip_remap(void);
+
+#endif /* ASSET_STORE_H */
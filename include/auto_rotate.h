@@ -0,0 +1,52 @@
+/**
+ * @file auto_rotate.h
+ * @brief 屏幕方向：手动设置或按 ICM20608 重力方向自动旋转
+ *
+ * 旋转由 ST7789V 改写 MADCTL 完成 (硬件旋转)，LVGL 只需按新的分辨率整屏重绘一次，
+ * 渲染和发送的每个像素都没有额外开销。
+ *
+ * 自动旋转取加速度在屏幕平面内的分量，带迟滞：
+ *   - 新方向的分量必须超过 AUTO_ROTATE_ENTER_G，且连续保持 AUTO_ROTATE_HOLD_MS；
+ *   - 屏幕接近水平 (|az| 超过 AUTO_ROTATE_FLAT_G) 时保持当前方向。
+ * 在 45° 附近晃动或者平放时不会来回切换。
+ *
+ * 方向切换请求来自任意线程，实际在显示线程的 auto_rotate_poll() 中执行。
+ */
+
+#ifndef AUTO_ROTATE_H
+#define AUTO_ROTATE_H
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/display.h>
+#include <stdbool.h>
+
+/* ---------------- 配置参数 ---------------- */
+#define AUTO_ROTATE_ENTER_G   0.7f     // 新方向的重力分量阈值 (g)，约对应偏离 45° 以上
+#define AUTO_ROTATE_FLAT_G    0.8f     // 平放判定 (g)
+#define AUTO_ROTATE_HOLD_MS   400      // 新方向需要保持的时间
+/* 传感器与屏幕的安装关系：正常方向竖放时重力沿 +y；装反时改符号 */
+#define AUTO_ROTATE_SIGN_X    1.0f
+#define AUTO_ROTATE_SIGN_Y    1.0f
+
+/**
+ * @brief 手动设置方向 (同时关闭自动旋转)
+ */
+void auto_rotate_set(enum display_orientation orientation);
+
+/**
+ * @brief 打开/关闭自动旋转 (默认关闭)
+ */
+void auto_rotate_enable(bool on);
+bool auto_rotate_is_enabled(void);
+
+/**
+ * @brief 当前屏幕方向
+ */
+enum display_orientation auto_rotate_current(void);
+
+/**
+ * @brief 显示线程主循环中调用：执行待处理的方向切换
+ */
+void auto_rotate_poll(const struct device *dev);
+
+#endif /* AUTO_ROTATE_H */
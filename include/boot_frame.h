@@ -0,0 +1,88 @@
+/**
+ * @file boot_frame.h
+ * @brief Flash 中预渲染的开机画面
+ *
+ * 首次运行 (或界面布局版本变化) 时，把仪表盘的静态画面 (不含传感器数值)
+ * 按 RLE 压缩后保存到 boot_frame_partition；之后每次开机在屏幕控制器初始化完成后、
+ * LVGL 初始化之前，直接从 Flash 解压推送到屏幕。
+ * 用户看到界面的时间因此基本不受 LVGL 初始化和控件构建耗时的影响。
+ *
+ * 数据格式：分区开头 256 字节为头部，之后是 RLE 数据。
+ * RLE 以像素 (RGB565，字节序与送给屏幕的一致) 为单位，每个包一个字节的包头：
+ *   bit7 = 1: 重复包，后跟 1 个像素，重复 (bit6..0) + 1 次
+ *   bit7 = 0: 原样包，后跟 (bit6..0) + 1 个像素
+ *
+ * 采集因刷新分块方式或压缩后大小而失败时 (每次都会重现)，头部改写为 NOCAP 标记，
+ * crc 字段保存失败原因。之后开机不再擦除分区重试，直到布局版本变化或手动擦除。
+ */
+
+#ifndef BOOT_FRAME_H
+#define BOOT_FRAME_H
+
+#include <zephyr/device.h>
+#include <lvgl.h>
+
+/* ---------------- 配置参数 ---------------- */
+#define BOOT_FRAME_MAGIC           0x4D524642u   // "BFRM"
+#define BOOT_FRAME_MAGIC_NOCAP     0x434E4642u   // "BFNC"，当前屏幕/布局无法采集
+#define BOOT_FRAME_DATA_OFFSET     256           // RLE 数据在分区中的起始偏移
+/* 仪表盘布局有改动时加 1，下次开机自动重新采集 */
+#define BOOT_FRAME_LAYOUT_VERSION  1
+
+/**
+ * @brief 分区头部
+ */
+struct boot_frame_hdr {
+    uint32_t magic;
+    uint16_t width;
+    uint16_t height;
+    uint32_t layout;       // BOOT_FRAME_LAYOUT_VERSION
+    uint32_t data_len;     // RLE 数据字节数
+    uint32_t crc;          // RLE 数据的 CRC32
+};
+
+/**
+ * @brief 检查分区中是否有与当前屏幕、布局版本匹配的开机画面 (只检查头部)
+ * @param width/height 屏幕分辨率
+ */
+bool boot_frame_valid(uint16_t width, uint16_t height);
+
+/**
+ * @brief 检查开机时是否需要 (重新) 采集
+ *
+ * 已有匹配的画面，或者当前屏幕、布局版本已标记为无法采集时返回 false。
+ * @param width/height 屏幕分辨率
+ */
+bool boot_frame_capture_needed(uint16_t width, uint16_t height);
+
+/**
+ * @brief 读取分区头部
+ * @return 0 成功, -ENOENT 没有有效画面, -ENOTSUP 已标记为无法采集 (hdr 有效),
+ *         其他负数 Flash 错误
+ */
+int boot_frame_get_info(struct boot_frame_hdr *hdr);
+
+/**
+ * @brief 把开机画面解压并写到屏幕 (不依赖 LVGL)
+ *
+ * 屏幕应处于消隐状态：CRC 在推送过程中计算，校验失败时返回错误，调用方不要取消消隐。
+ * @return 0 成功, -ENOENT 没有有效画面, -EBADMSG 数据损坏, 其他负数 Flash/屏幕错误
+ */
+int boot_frame_show(const struct device *display);
+
+/**
+ * @brief 采集当前屏幕画面
+ *
+ * 擦除分区，临时替换显示的 flush 回调，强制整屏重绘一次，边刷新边压缩写入 Flash。
+ * 必须在 LVGL 线程中调用。
+ * @return 0 成功, -EFBIG 压缩后超过分区大小, -ENOTSUP 刷新区域不是整行,
+ *         -EIO 没有刷完整屏 (这三种会写入 NOCAP 标记), 其他负数 失败
+ */
+int boot_frame_capture(lv_display_t *disp);
+
+/**
+ * @brief 擦除开机画面 (下次开机重新采集)
+ */
+int boot_frame_erase(void);
+
+#endif /* BOOT_FRAME_H */
@@ -0,0 +1,88 @@
+/**
+ * @file boot_prof.h
+ * @brief 开机关键路径分析 + 就绪事件
+ *
+ * 每个初始化步骤记录 开始 / 结束 时间以及其中休眠等待的总时长，
+ * 用 boot 命令查看时间线，找出拖慢首帧显示的步骤。
+ *
+ * 步骤完成后置位对应的就绪事件，依赖它的线程用 boot_ready_wait()
+ * 等待事件，而不是猜一个固定延时。事件只置位不清除，可以有多个等待者。
+ */
+
+#ifndef BOOT_PROF_H
+#define BOOT_PROF_H
+
+#include <zephyr/kernel.h>
+
+/* 初始化步骤 */
+enum boot_step {
+    BOOT_STEP_FS,          // 挂载 LittleFS
+    BOOT_STEP_AHT10,       // 温湿度传感器
+    BOOT_STEP_AP3216C,     // 光照传感器
+    BOOT_STEP_ICM20608,    // 六轴传感器
+    BOOT_STEP_DISPLAY,     // 屏幕控制器
+    BOOT_STEP_BOOT_FRAME,  // 从 Flash 推送预渲染的开机画面
+    BOOT_STEP_DASHBOARD,   // LVGL 初始化、构建界面并渲染首帧
+    BOOT_STEP_COUNT,
+};
+
+/* 就绪事件 (与步骤一一对应，步骤成功结束时置位) */
+#define BOOT_READY_FS           BIT(BOOT_STEP_FS)
+#define BOOT_READY_ENV          BIT(BOOT_STEP_AHT10)
+#define BOOT_READY_LUX          BIT(BOOT_STEP_AP3216C)
+#define BOOT_READY_IMU          BIT(BOOT_STEP_ICM20608)
+#define BOOT_READY_DISPLAY      BIT(BOOT_STEP_DISPLAY)
+#define BOOT_READY_BOOT_FRAME   BIT(BOOT_STEP_BOOT_FRAME)
+#define BOOT_READY_FIRST_FRAME  BIT(BOOT_STEP_DASHBOARD)
+
+/**
+ * @brief 单个步骤的时间记录 (单位 us，从开机算起)
+ */
+struct boot_step_record {
+    uint32_t start_us;
+    uint32_t end_us;
+    uint32_t sleep_us;     // 步骤内 boot_prof_sleep() 的累计时长
+    int result;            // 结束时的返回值
+    bool started;
+    bool done;
+};
+
+/**
+ * @brief 标记步骤开始，步骤归属当前线程
+ */
+void boot_prof_begin(enum boot_step step);
+
+/**
+ * @brief 标记步骤结束，成功时置位对应的就绪事件
+ * @param result 0 成功, 负数 失败
+ */
+void boot_prof_end(enum boot_step step, int result);
+
+/**
+ * @brief 休眠并计入当前线程正在进行的步骤
+ *
+ * 用于替换初始化代码中的 k_msleep()，驱动无需知道自己属于哪个步骤；
+ * 当前线程没有进行中的步骤时等同于 k_msleep()。
+ */
+void boot_prof_sleep(int32_t ms);
+
+/**
+ * @brief 等待全部指定的就绪事件
+ * @param bits    BOOT_READY_* 组合
+ * @param timeout 超时时间
+ * @return 0 全部就绪, -EAGAIN 超时
+ */
+int boot_ready_wait(uint32_t bits, k_timeout_t timeout);
+
+/**
+ * @brief 获取步骤记录
+ * @return 0 成功, -EINVAL 步骤编号无效
+ */
+int boot_prof_get(enum boot_step step, struct boot_step_record *out);
+
+/**
+ * @brief 步骤名称
+ */
+const char *boot_prof_step_name(enum boot_step step);
+
+#endif /* BOOT_PROF_H */
@@ -0,0 +1,56 @@
+/**
+ * @file dashboard.h
+ * @brief 仪表盘界面 (dashboard.c) 的构建与数值更新
+ *
+ * 显示线程用它们显示实时数据，ui_bench 用同一套代码在离屏显示上测量界面开销。
+ * 都只能在显示线程中调用；界面建在当前默认显示的活动屏幕上。
+ */
+
+#ifndef DASHBOARD_H
+#define DASHBOARD_H
+
+#include <zephyr/types.h>
+
+#include "aht10.h"
+#include "icm20608.h"
+
+/**
+ * @brief 在活动屏幕上创建仪表盘 (对象加入默认输入组)
+ */
+void setup_pandora_dashboard(void);
+
+/**
+ * @brief 删除活动屏幕上的仪表盘
+ */
+void ui_clear_dashboard(void);
+
+/**
+ * @brief 重建后按数据中心的当前值填充数值
+ */
+void ui_restore_values(void);
+
+void ui_apply_lux(uint16_t lux);
+void ui_apply_env(const aht10_data_t *env);
+void ui_apply_imu(const icm20608_data_t *imu);
+
+/**
+ * @brief 显示数据中心恢复出的旧值 (灰色)，已有实时数据或已显示过旧值的通道跳过
+ */
+void ui_show_warm_start(void);
+
+/**
+ * @brief 暂停/恢复旧值显示 (采集开机画面期间只保存静态界面)
+ */
+void ui_set_warm_hold(bool hold);
+
+/**
+ * @brief 还有通道既没有实时数据、也没有显示旧值 (数据中心的快照可能稍后才恢复)
+ */
+bool ui_warm_pending(void);
+
+/**
+ * @brief 是否处于全屏小球模式 (任意线程可调用)
+ */
+bool ui_imu_ball_active(void);
+
+#endif /* DASHBOARD_H */
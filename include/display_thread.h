@@ -1,14 +1,53 @@
 /**
  * @file display_thread.h
  * @brief Display Thread Header
+ *
+ * 显示线程不再固定间隔轮询：每轮 lv_timer_handler() 之后睡到下一个 LVGL 定时器到期，
+ * 期间有新的传感器数据、按键或 Shell 请求时由 display_wake() 提前唤醒。
  */
 
 #ifndef DISPLAY_THREAD_H
 #define DISPLAY_THREAD_H
 
+#include <zephyr/types.h>
+#include <zephyr/sys/util.h>
+
+/* 唤醒显示线程的事件 */
+#define DISPLAY_EVT_SENSOR  BIT(0)   // 传感器消息队列有新数据
+#define DISPLAY_EVT_INPUT   BIT(1)   // 按键
+#define DISPLAY_EVT_CMD     BIT(2)   // Shell 请求 (基准测试、滚动图、旋转)
+
+/**
+ * @brief 主循环统计 (开机或上次清零以来)
+ */
+struct display_loop_stats {
+    uint32_t elapsed_ms;
+    uint32_t wakeups;
+    uint32_t event_wakeups;   // 被 display_wake() 提前唤醒的次数，其余为定时器到期
+    uint32_t sleep_ms;        // 累计计划睡眠时间
+};
+
 /**
  * @brief 启动显示线程
  */
 void start_display_thread(void);
 
+/**
+ * @brief 唤醒显示线程 (任意线程，可在中断中调用)
+ *
+ * DISPLAY_EVT_SENSOR / DISPLAY_EVT_INPUT 同时记下到达时刻，用于统计上屏延迟。
+ */
+void display_wake(uint32_t events);
+
+/**
+ * @brief IMU 采样唤醒显示线程的最小间隔 (ms)
+ *
+ * IMU 以约 50 Hz 发布，每个采样都唤醒会让显示线程的唤醒次数翻几倍。
+ * 数值模式下按 10 Hz 唤醒 (队列只保留最新值)，小球模式返回 0，每个采样都唤醒。
+ */
+uint32_t display_imu_period_ms(void);
+
+void display_get_loop_stats(struct display_loop_stats *out);
+void display_reset_loop_stats(void);
+
 #endif /* DISPLAY_THREAD_H */
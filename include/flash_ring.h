@@ -0,0 +1,87 @@
+/**
+ * @file flash_ring.h
+ * @brief 裸 Flash 环形记录日志 (不经过文件系统)
+ *
+ * 直接在 storage_partition 上按扇区循环写入记录：
+ * - 每个扇区开头是带序号的扇区头，开机时二分查找序号即可定位头/尾，O(log n) 次读；
+ * - 写指针前方始终保留一个已擦除的扇区，追加时不会等待擦除；
+ * - 每条记录带 CRC32，掉电导致的残缺记录在读取时被丢弃。
+ */
+
+#ifndef FLASH_RING_H
+#define FLASH_RING_H
+
+#include <zephyr/types.h>
+#include <zephyr/sys/util.h>
+#include <stddef.h>
+
+#define FLASH_RING_SECTOR_SIZE   4096
+#define FLASH_RING_ALIGN_MAX     32      // 支持的最大写入对齐粒度
+
+/* 扇区头 (16B) 和记录头 (8B) 各自按最大写入对齐填充后，单条记录的最大负载 */
+#define FLASH_RING_MAX_RECORD \
+    (FLASH_RING_SECTOR_SIZE - ROUND_UP(16, FLASH_RING_ALIGN_MAX) - ROUND_UP(8, FLASH_RING_ALIGN_MAX))
+
+/**
+ * @brief 读取游标，从最旧的记录开始顺序遍历
+ */
+struct flash_ring_cursor {
+    uint32_t sector;   // 当前扇区序号 (分区内)
+    uint32_t offset;   // 扇区内偏移
+    uint32_t seq;      // 当前扇区的序列号，用于检测游标期间扇区被覆盖
+};
+
+/**
+ * @brief 运行状态
+ */
+struct flash_ring_info {
+    uint32_t sector_count;   // 分区扇区总数
+    uint32_t head_sector;    // 正在写入的扇区
+    uint32_t tail_sector;    // 最旧数据所在扇区
+    uint32_t head_seq;       // 正在写入扇区的序列号
+    uint32_t write_offset;   // 正在写入扇区内的偏移
+    uint32_t records;        // 本次开机写入的记录数
+    uint32_t erases;         // 本次开机的擦除次数
+};
+
+/**
+ * @brief 挂载环形日志：恢复头尾位置，必要时初始化空分区
+ * @return 0 成功, 负数 失败
+ */
+int flash_ring_init(void);
+
+/**
+ * @brief 追加一条记录
+ * @param data 记录内容
+ * @param len  记录长度 (1 ~ FLASH_RING_MAX_RECORD)
+ * @return 0 成功, 负数 失败
+ */
+int flash_ring_append(const void *data, size_t len);
+
+/**
+ * @brief 把游标定位到最旧的记录
+ */
+void flash_ring_cursor_init(struct flash_ring_cursor *cur);
+
+/**
+ * @brief 读取下一条记录
+ * @param cur  读取游标
+ * @param buf  输出缓冲区
+ * @param size 输出缓冲区大小
+ * @return 记录长度 (> 0)，没有更多记录时返回 -ENOENT，
+ *         游标所在扇区已被覆盖时返回 -ESTALE
+ */
+int flash_ring_read(struct flash_ring_cursor *cur, void *buf, size_t size);
+
+/**
+ * @brief 擦除整个环形日志
+ * @return 0 成功, 负数 失败
+ */
+int flash_ring_clear(void);
+
+/**
+ * @brief 获取运行状态
+ */
+void flash_ring_get_info(struct flash_ring_info *info);
+
+#endif /* FLASH_RING_H */
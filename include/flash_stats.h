@@ -0,0 +1,84 @@
+/**
+ * @file flash_stats.h
+ * @brief Flash 访问统计 (写放大 / 擦除次数热力图)
+ *
+ * 通过链接器 --wrap 包装 flash_area_read/write/erase/flatten，
+ * 文件系统 (LittleFS)、环形日志等所有经由 flash_map 的访问都会被计数，
+ * 调用方无需任何改动。
+ *
+ * - 每个分区统计读/写/擦除的次数和字节数；
+ * - filesystem_partition 和 storage_partition 额外统计每个扇区的擦除次数；
+ * - 统计值定期保存到 /lfs，开机后累加恢复，跨重启持续累计。
+ */
+
+#ifndef FLASH_STATS_H
+#define FLASH_STATS_H
+
+#include <zephyr/types.h>
+
+/* ---------------- 配置参数 ---------------- */
+#define FLASH_STATS_SECTOR         4096                   // W25Q128 擦除扇区大小
+#define FLASH_STATS_ENDURANCE      100000                 // 每扇区擦写寿命 (次)
+#define FLASH_STATS_FILE           "/lfs/flash_stats.bin"
+#define FLASH_STATS_SAVE_INTERVAL  (30 * 60 * 1000)       // 保存周期 (ms)
+
+/* 分区编号 */
+enum flash_stats_part {
+    FLASH_STATS_FS,        // filesystem_partition (LittleFS)
+    FLASH_STATS_RING,      // storage_partition (裸 Flash 环形日志)
+    FLASH_STATS_OTHER,     // 其他分区 (字库等)，不统计扇区明细
+    FLASH_STATS_PART_COUNT,
+};
+
+/**
+ * @brief 单个分区的计数
+ */
+struct flash_part_counters {
+    uint32_t read_ops;
+    uint64_t read_bytes;
+    uint32_t prog_ops;
+    uint64_t prog_bytes;
+    uint32_t erase_ops;
+    uint32_t erase_sectors;
+};
+
+/**
+ * @brief 记录一条逻辑记录 (用于计算写放大)
+ * @param bytes 逻辑记录的字节数
+ */
+void flash_stats_note_record(uint32_t bytes);
+
+/**
+ * @brief 获取分区计数
+ * @return 0 成功, -EINVAL 分区编号无效
+ */
+int flash_stats_get(enum flash_stats_part part, struct flash_part_counters *out);
+
+/**
+ * @brief 获取逻辑记录统计
+ * @param records 输出: 逻辑记录条数
+ * @param bytes   输出: 逻辑记录字节数
+ * @param uptime_s 输出: 累计运行时间 (秒，跨重启)
+ */
+void flash_stats_get_logical(uint32_t *records, uint64_t *bytes, uint32_t *uptime_s);
+
+/**
+ * @brief 获取分区的扇区擦除次数表
+ * @param part    FLASH_STATS_FS 或 FLASH_STATS_RING
+ * @param sectors 输出: 扇区数
+ * @return 擦除次数数组 (只读)，不支持扇区明细的分区返回 NULL
+ */
+const uint32_t *flash_stats_sector_erases(enum flash_stats_part part, uint32_t *sectors);
+
+/**
+ * @brief 立即保存统计到文件
+ * @return 0 成功, 负数 失败
+ */
+int flash_stats_save(void);
+
+/**
+ * @brief 清零全部统计 (同时删除保存文件)
+ */
+void flash_stats_reset(void);
+
+#endif /* FLASH_STATS_H */
@@ -0,0 +1,17 @@
+/**
+ * @file fs_thread.h
+ * @brief 文件系统挂载与自检线程
+ */
+
+#ifndef FS_THREAD_H
+#define FS_THREAD_H
+
+#include <zephyr/types.h>
+
+/**
+ * @brief 获取开机挂载 /lfs 的耗时
+ * @return 挂载耗时 (us)，尚未挂载时返回 0
+ */
+uint32_t fs_mount_time_us(void);
+
+#endif /* FS_THREAD_H */
@@ -0,0 +1,68 @@
+/**
+ * @file glyph_cache.h
+ * @brief 字形位图 LRU 缓存 (SRAM1)
+ *
+ * LVGL 每次绘制文字都要调用字体的 get_glyph_bitmap()，把 1/2/4 bpp 的原始位图
+ * 展开成 A8。字库放在外部 Flash (asset_store) 时每个字形都要经过 QSPI 读取，
+ * ui_update 每秒多次刷新数值标签时会拖慢显示线程。
+ *
+ * 本模块替换字体的 get_glyph_bitmap 回调：展开后的 A8 位图按 (字体, 字形) 缓存在 SRAM1 中，
+ * 命中时只做一次内存拷贝，绘制开销与字库存放位置基本无关。
+ * 一个 lv_font_t 对应一个字号，字形编号由码点唯一确定，
+ * 因此 (字体, 字形编号) 即 (字体, 码点, 字号)。
+ *
+ * 缓存空间不足时淘汰最久未使用的字形；只在 LVGL 线程中调用绘制回调。
+ */
+
+#ifndef GLYPH_CACHE_H
+#define GLYPH_CACHE_H
+
+#include <zephyr/types.h>
+#include <lvgl.h>
+
+/* ---------------- 配置参数 ---------------- */
+#ifndef GLYPH_CACHE_BYTES
+/* SRAM1 (32KB) 中已有两块绘图缓冲共 22.5KB */
+#define GLYPH_CACHE_BYTES     4096           // 缓存区大小 (字节，每项另有几字节堆管理开销)
+#endif
+#define GLYPH_CACHE_SLOTS     64             // 最多缓存的字形数
+#define GLYPH_CACHE_MAX_FONTS 8              // 最多接管的字体数
+
+/**
+ * @brief 缓存统计
+ */
+struct glyph_cache_stats {
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+    uint32_t uncached;     // 超出预算或无位图 (空格等) 而未缓存的次数
+    uint32_t entries;      // 当前缓存的字形数
+    uint32_t used_bytes;   // 当前占用 (位图字节数)
+    uint32_t budget;       // 当前预算
+};
+
+/**
+ * @brief 让一个 RAM 中的字体使用缓存 (替换其 get_glyph_bitmap)
+ * @return 0 成功, -ENOMEM 接管的字体已满
+ */
+int glyph_cache_attach(lv_font_t *font);
+
+/**
+ * @brief 为常量字体 (如内置 Montserrat) 建立一个使用缓存的副本
+ * @return 副本指针；失败时返回原字体
+ */
+const lv_font_t *glyph_cache_wrap(const lv_font_t *font);
+
+/**
+ * @brief 设置字节预算 (不超过 GLYPH_CACHE_BYTES)，超出部分立即淘汰
+ */
+void glyph_cache_set_budget(uint32_t bytes);
+
+/**
+ * @brief 清空缓存和计数
+ */
+void glyph_cache_clear(void);
+
+void glyph_cache_get_stats(struct glyph_cache_stats *out);
+
+#endif /* GLYPH_CACHE_H */
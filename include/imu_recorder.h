@@ -0,0 +1,109 @@
+/**
+ * @file imu_recorder.h
+ * @brief IMU 高速突发录制 (乒乓缓冲 → 裸 Flash 环形日志)
+ *
+ * - IMU 线程每读到一帧原始数据就调用 imu_recorder_feed()，只做拷贝，不碰 Flash；
+ * - 两个 RAM 缓冲区轮流填充，填满的一块交给低优先级写线程写入 flash_ring，
+ *   另一块继续接收数据；写线程来不及时新样本被丢弃并计数，采集本身永不阻塞；
+ * - 录制可以由 Shell 手动启动，也可以设置加速度阈值由运动自动触发。
+ *
+ * 每个缓冲区恰好是一条 flash_ring 记录：块头 + 最多 IMU_REC_BLOCK_SAMPLES 个样本。
+ */
+
+#ifndef IMU_RECORDER_H
+#define IMU_RECORDER_H
+
+#include <zephyr/types.h>
+#include <stdbool.h>
+
+#include "flash_ring.h"
+
+/* ---------------- 配置参数 ---------------- */
+#define IMU_REC_MAGIC            0x52494D55u   // "UMIR"
+#define IMU_REC_DEFAULT_ODR_HZ   1000          // 录制时的默认输出数据率 (芯片上限)
+#define IMU_REC_DEFAULT_SECONDS  5
+#define IMU_REC_MAX_SECONDS      60
+
+/**
+ * @brief 一个样本：加速度 + 角速度原始值 (±2g / ±250dps 量程)
+ */
+struct imu_sample {
+    int16_t accel[3];
+    int16_t gyro[3];
+} __packed;
+
+/**
+ * @brief 块头：写在每条 flash_ring 记录的开头
+ */
+struct imu_block_hdr {
+    uint32_t magic;
+    uint16_t burst;        // 录制编号，每次启动加 1
+    uint16_t count;        // 本块样本数
+    uint32_t first_seq;    // 本块第一个样本在本次录制中的序号 (序号不连续说明中间丢了样本)
+    uint32_t uptime_ms;    // 本块第一个样本的采集时刻
+    uint16_t odr_hz;       // 本块采集时驱动实际生效的 ODR (1kHz 整数分频，可能与请求值不同)
+    uint16_t reserved;
+} __packed;
+
+#define IMU_REC_BLOCK_SAMPLES \
+    ((FLASH_RING_MAX_RECORD - sizeof(struct imu_block_hdr)) / sizeof(struct imu_sample))
+
+/**
+ * @brief 录制状态统计
+ */
+struct imu_recorder_stats {
+    bool active;
+    bool armed;
+    uint16_t burst;
+    uint16_t odr_hz;          // 本次录制开始时实际生效的 ODR
+    uint32_t samples;         // 本次录制已采集的样本数 (含丢弃)
+    uint32_t lost;            // 因两个缓冲区都未写完而丢弃的样本数
+    uint32_t missed;          // IMU 线程没来得及读取、被传感器覆盖的样本数
+    uint32_t blocks;          // 已写入 Flash 的块数
+    uint32_t write_errors;
+    uint32_t write_avg_us;    // 单块写入平均耗时
+    uint32_t write_max_us;    // 单块写入最大耗时
+};
+
+/**
+ * @brief 启动录制
+ * @param seconds 录制时长 (秒)
+ * @param odr_hz  输出数据率 (Hz)
+ * @return 0 成功, -EBUSY 正在录制
+ */
+int imu_recorder_start(uint32_t seconds, uint16_t odr_hz);
+
+/**
+ * @brief 停止录制，已采集但未写满的缓冲区也会落盘
+ */
+void imu_recorder_stop(void);
+
+/**
+ * @brief 设置运动触发：加速度模长偏离 1g 超过阈值时自动开始录制
+ * @param threshold_mg 阈值 (mg)，0 表示关闭运动触发
+ * @param seconds      触发后的录制时长
+ * @param odr_hz       触发后的输出数据率
+ * @return 0 成功, -EBUSY 正在录制
+ */
+int imu_recorder_arm(uint16_t threshold_mg, uint32_t seconds, uint16_t odr_hz);
+
+/**
+ * @brief 喂入一帧原始数据 (由 IMU 线程调用，不会阻塞)
+ * @param raw    ax, ay, az, temp, gx, gy, gz
+ * @param missed 距上一帧之间漏读的数据就绪中断数 (计入丢失，序号跳过)
+ * @param odr_hz 采集这一帧时传感器实际的输出数据率 (icm20608_set_odr() 的返回值)
+ */
+void imu_recorder_feed(const int16_t raw[7], uint32_t missed, uint16_t odr_hz);
+
+/**
+ * @brief IMU 线程当前应使用的输出数据率
+ * @return 录制中返回录制 ODR，否则返回 0 (使用默认值)
+ */
+uint16_t imu_recorder_wanted_odr(void);
+
+/**
+ * @brief 获取录制状态
+ */
+void imu_recorder_get_stats(struct imu_recorder_stats *stats);
+
+#endif /* IMU_RECORDER_H */
@@ -0,0 +1,82 @@
+/**
+ * @file key_gesture.h
+ * @brief 摇杆按键手势：单击、双击、长按、长按连发、组合键
+ *
+ * 输入子系统的回调 (gpio-keys 消抖之后) 只把带时间戳的边沿写入环形队列；
+ * 一个延时工作项按边沿的时间戳驱动每个按键的状态机，只在有边沿或某个超时到期时运行，
+ * 没有按键活动时不占用任何定时器或线程。
+ *
+ * 状态机的输出：
+ *   - 原始的按下/松开立即转交 LVGL keypad (key_input 队列)，界面导航不等手势判定；
+ *     长按连发时再补发按下/松开，方向键可以连续移动焦点；
+ *   - 手势事件执行界面绑定的动作 (见 key_gesture.c)，并可由 Shell 的 keys watch 查看。
+ */
+
+#ifndef KEY_GESTURE_H
+#define KEY_GESTURE_H
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <stdbool.h>
+
+/* ---------------- 配置参数 ---------------- */
+#define KEY_GESTURE_DOUBLE_MS   250   // 两次单击的最大间隔，超过则各自算单击
+#define KEY_GESTURE_LONG_MS     600   // 按住超过此时间判为长按
+#define KEY_GESTURE_REPEAT_MS   150   // 长按之后的连发间隔
+#define KEY_GESTURE_CHORD_MS    80    // 两个键按下间隔在此之内判为组合键
+#define KEY_GESTURE_EDGE_LEN    16    // 边沿队列长度，必须是 2 的幂
+
+/* 按键位 */
+#define KEY_BIT_UP     BIT(0)
+#define KEY_BIT_DOWN   BIT(1)
+#define KEY_BIT_LEFT   BIT(2)
+#define KEY_BIT_RIGHT  BIT(3)
+
+/* 连发时补发给 LVGL 的按键 (方向键)，确认/返回键连发没有意义 */
+#define KEY_GESTURE_REPEAT_KEYS  (KEY_BIT_LEFT | KEY_BIT_RIGHT)
+
+enum key_gesture {
+    KEY_GESTURE_CLICK,
+    KEY_GESTURE_DOUBLE_CLICK,
+    KEY_GESTURE_LONG_PRESS,
+    KEY_GESTURE_REPEAT,
+    KEY_GESTURE_CHORD,
+    KEY_GESTURE_COUNT,
+};
+
+struct key_gesture_evt {
+    uint8_t type;        // enum key_gesture
+    uint8_t keys;        // KEY_BIT_*，组合键时为多位
+    uint16_t repeat;     // 连发序号 (从 1 开始)，其他手势为 0
+    uint32_t t_ms;       // 判定时刻 (k_uptime_get_32)
+};
+
+struct key_gesture_stats {
+    uint32_t edges;                          // 收到的边沿
+    uint32_t edges_dropped;                  // 边沿队列满丢弃
+    uint32_t runs;                           // 状态机运行次数
+    uint32_t max_run_us;                     // 单次运行的最长时间
+    uint32_t gestures[KEY_GESTURE_COUNT];
+};
+
+/**
+ * @brief 打开/关闭手势事件的转发 (Shell 的 keys watch 使用)
+ */
+void key_gesture_watch(bool on);
+
+/**
+ * @brief 取一个转发的手势事件
+ * @retval 0 成功, -EAGAIN 超时
+ */
+int key_gesture_get(struct key_gesture_evt *evt, k_timeout_t timeout);
+
+void key_gesture_get_stats(struct key_gesture_stats *out);
+
+const char *key_gesture_name(enum key_gesture type);
+
+/**
+ * @brief 按键位转为名字，如 "LEFT+RIGHT"
+ */
+void key_gesture_keys_str(uint8_t keys, char *buf, size_t len);
+
+#endif /* KEY_GESTURE_H */
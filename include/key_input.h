@@ -0,0 +1,52 @@
+/**
+ * @file key_input.h
+ * @brief 摇杆按键：gpio-keys (边沿中断 + 消抖) -> 手势状态机 -> 无锁队列 -> LVGL keypad
+ *
+ * 四个按键由设备树中的 gpio-keys 节点描述，Zephyr 的 gpio-keys 驱动在边沿中断后
+ * 按 debounce-interval-ms 消抖，再通过输入子系统上报 INPUT_EV_KEY 事件。
+ * 手势状态机 (key_gesture.c) 把按下/松开 (以及长按连发) 写入本模块的环形队列并唤醒显示线程；
+ * 显示线程中的 LVGL keypad 读回调取出事件，不再读取 GPIO，也不需要定时轮询。
+ *
+ * 生产者只有手势状态机 (系统工作队列)，消费者只有显示线程，
+ * 两端各自只写自己的下标，不需要加锁。
+ */
+
+#ifndef KEY_INPUT_H
+#define KEY_INPUT_H
+
+#include <zephyr/types.h>
+#include <stdbool.h>
+
+/* ---------------- 配置参数 ---------------- */
+#define KEY_INPUT_QUEUE_LEN  16     // 必须是 2 的幂；按下和松开各占一项
+
+struct key_event {
+    uint16_t code;      // INPUT_KEY_*
+    bool pressed;
+};
+
+/**
+ * @brief 写入一个按键事件 (只在手势状态机中调用)
+ * @retval 0 成功
+ * @retval -ENOSPC 队列已满，事件被丢弃
+ */
+int key_input_push(const struct key_event *ev);
+
+/**
+ * @brief 取出一个按键事件 (只在显示线程中调用)
+ * @retval 0 成功
+ * @retval -EAGAIN 队列为空
+ */
+int key_input_get(struct key_event *ev);
+
+/**
+ * @brief 队列中是否有待处理的事件
+ */
+bool key_input_pending(void);
+
+/**
+ * @brief 队列满时丢弃的事件数
+ */
+uint32_t key_input_dropped(void);
+
+#endif /* KEY_INPUT_H */
@@ -0,0 +1,100 @@
+/**
+ * @file lcd_flush.h
+ * @brief LVGL 到 ST7789V 的刷新回调 (异步 SPI DMA + 双缓冲)
+ *
+ * Zephyr 自带的 LVGL 回调调用 display_write()，整块像素发送完才返回，
+ * 显示线程在 SPI 传输期间无事可做。这里替换为驱动的异步写入：
+ * flush 回调提交传输后立即返回，LVGL 接着在另一块绘图缓冲 (CONFIG_LV_Z_DOUBLE_VDB) 中
+ * 渲染下一条带；传输结束时驱动线程调用 lv_display_flush_ready()。
+ * 需要等待上一块传输时，LVGL 通过 flush_wait_cb 睡眠等待，而不是空转轮询 flushing 标志。
+ *
+ * lcd_flush_poll() 在显示线程的主循环中调用，执行 Shell 发起的刷新基准测试。
+ *
+ * 延迟统计：显示线程把传感器采样/按键到达的时刻登记进来，
+ * 之后第一帧的最后一块像素发送完时记一次 "到达 -> 上屏" 的延迟。
+ */
+
+#ifndef LCD_FLUSH_H
+#define LCD_FLUSH_H
+
+#include <zephyr/device.h>
+#include <zephyr/types.h>
+#include <lvgl.h>
+
+/* ---------------- 配置参数 ---------------- */
+#define LCD_BENCH_DEFAULT_FRAMES  30
+#define LCD_BENCH_MAX_FRAMES      300
+
+/**
+ * @brief 基准测试结果
+ */
+struct lcd_bench_result {
+    uint32_t frames;
+    uint32_t elapsed_us;
+    uint32_t flushes;          // flush 回调次数 (每帧按绘图缓冲大小分块)
+    uint32_t spi_transfers;    // 驱动发起的 SPI 传输次数
+    uint32_t cs_cycles;        // 片选拉低次数
+    uint32_t pixel_bytes;      // 线上发送的像素字节数
+    uint32_t cpu_permille;     // 显示线程 CPU 占用 (千分比)
+    bool async;
+    bool rgb444;               // 接口格式为 12 位 RGB444
+};
+
+/**
+ * @brief 延迟统计的来源
+ */
+enum lcd_latency_src {
+    LCD_LATENCY_SENSOR,        // 传感器采样进入消息队列
+    LCD_LATENCY_INPUT,         // 按键按下
+    LCD_LATENCY_SRC_COUNT,
+};
+
+struct lcd_latency {
+    uint32_t count;
+    uint32_t sum_us;
+    uint32_t max_us;
+};
+
+/**
+ * @brief 接管显示的 flush 回调 (lvgl_init() 之后、首次刷新之前调用)
+ */
+int lcd_flush_attach(lv_display_t *disp, const struct device *dev);
+
+/**
+ * @brief 切换异步/同步刷新 (同步即原来的 display_write 方式，用于对比)
+ */
+void lcd_flush_set_async(bool async);
+bool lcd_flush_is_async(void);
+
+/**
+ * @brief 等待最后一块像素发送完毕
+ */
+void lcd_flush_wait(void);
+
+/**
+ * @brief 请求显示线程执行整屏刷新基准测试并等待结果 (Shell 线程调用)
+ * @retval -EBUSY 已有测试在进行
+ * @retval -ETIMEDOUT 显示线程没有响应
+ */
+int lcd_flush_bench(uint32_t frames, bool async, struct lcd_bench_result *out);
+
+/**
+ * @brief 显示线程主循环中调用：有待执行的基准测试时执行
+ */
+void lcd_flush_poll(void);
+
+/**
+ * @brief 登记一次需要上屏的变化 (显示线程调用)
+ *
+ * 同一来源在上屏之前多次登记时保留最早的时刻。
+ * @param stamp 变化到达时的 k_cycle_get_32()
+ */
+void lcd_flush_latency_mark(enum lcd_latency_src src, uint32_t stamp);
+
+/**
+ * @brief 读取/清零延迟统计
+ */
+void lcd_flush_get_latency(struct lcd_latency out[LCD_LATENCY_SRC_COUNT]);
+void lcd_flush_reset_latency(void);
+
+#endif /* LCD_FLUSH_H */
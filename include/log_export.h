@@ -0,0 +1,56 @@
+/**
+ * @file log_export.h
+ * @brief 日志二进制导出 (COBS 分帧 + CRC32，可断点续传)
+ *
+ * 导出的是分段文件的原始内容 (ts_codec 压缩帧)，主机端按 ts_codec 格式解码。
+ * 每个传输帧在 COBS 编码前的结构：
+ *   [export_frame_hdr 12B] [数据 len 字节] [CRC32 4B，覆盖帧头和数据]
+ * COBS 编码后以 0x00 结尾；流开头先发一个 0x00，主机据此丢弃之前的命令回显。
+ *
+ * 帧类型：
+ *   START  数据为 {分段数 u32, 待导出字节数 u32}
+ *   DATA   seg/offset 指明数据在哪个分段的哪个位置，主机据此续传
+ *   END    数据为 {已发送字节数 u32, 耗时 ms u32, 状态 i32}
+ *
+ * 主机端接收工具见 tools/log_export.py。
+ */
+
+#ifndef LOG_EXPORT_H
+#define LOG_EXPORT_H
+
+#include <zephyr/types.h>
+#include <zephyr/shell/shell.h>
+
+/* ---------------- 配置参数 ---------------- */
+#define LOG_EXPORT_CHUNK        1024    // 每个 DATA 帧的最大数据量
+#define LOG_EXPORT_VERSION      1
+
+enum log_export_type {
+    LOG_EXPORT_START = 1,
+    LOG_EXPORT_DATA = 2,
+    LOG_EXPORT_END = 3,
+};
+
+/**
+ * @brief 传输帧头 (小端)
+ */
+struct log_export_hdr {
+    uint8_t type;
+    uint8_t version;
+    uint16_t len;        // 数据长度
+    uint32_t seg;        // 分段起始时间戳 (分段文件名)
+    uint32_t offset;     // 数据在分段内的偏移
+} __packed;
+
+/**
+ * @brief 通过 Shell 的传输层把日志以二进制帧流的形式发送出去
+ *
+ * 发送期间 Shell 线程被本命令占用，延迟日志不会插入到二进制流中。
+ * @param sh        Shell 实例 (使用它的底层传输接口)
+ * @param from_seg  从起始时间戳 >= from_seg 的分段开始 (0 表示全部)
+ * @param offset    在第一个分段内的起始偏移 (续传)
+ * @return 0 成功, 负数 失败
+ */
+int log_export_run(const struct shell *sh, uint32_t from_seg, uint32_t offset);
+
+#endif /* LOG_EXPORT_H */
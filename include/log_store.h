@@ -0,0 +1,128 @@
+/**
+ * @file log_store.h
+ * @brief 分段日志存储 (Segmented Log Store)
+ *
+ * 数据不再追加到单个 /lfs/data.csv，而是写入 /lfs/log 目录下的定长分段文件。
+ * 分段文件名即为该段第一条记录的时间戳 (10 位十进制秒)，按文件名排序即按时间排序。
+ * 分段内容是 ts_codec 压缩帧序列 (见 ts_codec.h)。
+ * 分段达到大小或时间上限时轮转，总占用超过配额时删除最旧的分段。
+ *
+ * 每个分段旁边有一个稀疏索引文件 (<时间戳>.idx)，每写满 LOG_INDEX_STRIDE 字节
+ * 记录一条 {时间戳, 文件偏移}，范围查询据此直接 seek 到目标位置。
+ */
+
+#ifndef LOG_STORE_H
+#define LOG_STORE_H
+
+#include <zephyr/types.h>
+#include <stddef.h>
+
+/* ---------------- 配置参数 ---------------- */
+#define LOG_STORE_DIR            "/lfs/log"
+#define LOG_SEG_MAX_BYTES        (64 * 1024)          // 单个分段上限 64 KB
+#define LOG_SEG_MAX_AGE_S        (24 * 60 * 60)       // 单个分段最长覆盖 24 小时
+#define LOG_STORE_QUOTA_BYTES    (6 * 1024 * 1024)    // 7 MB 分区中留给日志的配额
+#define LOG_STORE_MAX_SEGMENTS   (LOG_STORE_QUOTA_BYTES / LOG_SEG_MAX_BYTES + 8)
+
+#define LOG_INDEX_STRIDE         4096                 // 每个 Flash 块一条索引
+#define LOG_FRAME_MAX_AGE_S      (60 * 60)            // 压缩帧最多在 RAM 中累积 1 小时
+
+/* 分段文件完整路径的最大长度: "/lfs/log/" + 10 位时间戳 + 扩展名 */
+#define LOG_SEG_PATH_MAX         32
+
+/**
+ * @brief 一条传感器日志记录
+ */
+struct log_record {
+    uint32_t ts;          // 时间戳 (秒)
+    float temperature;    // 温度 (°C)
+    float humidity;       // 湿度 (%RH)
+    uint16_t lux;         // 光照原始值
+};
+
+/**
+ * @brief 范围查询回调
+ * @return 0 继续, 非 0 停止查询
+ */
+typedef int (*log_query_cb_t)(const struct log_record *rec, void *user_data);
+
+/**
+ * @brief 初始化日志存储
+ *
+ * 创建日志目录并扫描已有分段，重建内存中的分段表。
+ * 必须在文件系统挂载完成后调用。
+ * @return 0 成功, 负数 失败
+ */
+int log_store_init(void);
+
+/**
+ * @brief 获取日志时间戳 (秒)
+ *
+ * RTC 有效时返回 UNIX 时间；否则返回一个跨重启单调递增的伪时间
+ * (上次最新分段的起始时间 + 分段最长时长 + 本次开机秒数)。
+ */
+uint32_t log_store_now(void);
+
+/**
+ * @brief 追加一条记录
+ *
+ * 当前分段超过大小或时间上限时先轮转，再写入；写入后执行配额回收。
+ * @param rec 记录内容 (rec->ts 通常来自 log_store_now)
+ * @return 0 成功, 负数 失败
+ */
+int log_store_append(const struct log_record *rec);
+
+/**
+ * @brief 把 RAM 中尚未写满的压缩帧立即落盘
+ * @return 0 成功, 负数 失败
+ */
+int log_store_flush(void);
+
+/**
+ * @brief 按时间范围查询记录
+ *
+ * 由分段文件名定位起始分段，再由稀疏索引 seek 到起始块，
+ * 只读取覆盖 [from, to] 的数据，耗时与结果数量成正比而与日志总量无关。
+ * 查询期间不持有写锁，存储线程可以继续追加。
+ * @param from 起始时间戳 (含)
+ * @param to   结束时间戳 (含)
+ * @param cb   每条匹配记录的回调
+ * @param user_data 透传给回调的参数
+ * @return 匹配的记录数 (>= 0)，失败返回负数
+ */
+int log_store_query(uint32_t from, uint32_t to, log_query_cb_t cb, void *user_data);
+
+/**
+ * @brief 查找覆盖指定时间戳的分段
+ *
+ * 只依据内存中的分段表 (即文件名)，不会打开任何文件。
+ * @param ts    目标时间戳
+ * @param path  输出: 分段文件路径，长度至少 LOG_SEG_PATH_MAX
+ * @return 分段序号 (>= 0)，没有数据时返回 -ENOENT
+ */
+int log_store_find_segment(uint32_t ts, char *path);
+
+/**
+ * @brief 根据分段起始时间戳生成分段文件路径
+ * @param start 分段起始时间戳
+ * @param path  输出: 长度至少 LOG_SEG_PATH_MAX
+ */
+void log_store_segment_path(uint32_t start, char *path);
+
+/**
+ * @brief 按时间顺序枚举分段
+ *
+ * 返回第一个起始时间戳 >= from 的分段；遍历时把 from 设为上一次的 start + 1。
+ * @param from  起始时间戳下限
+ * @param start 输出: 分段起始时间戳 (即文件名)
+ * @param size  输出: 分段当前已落盘的字节数
+ * @return 0 成功，没有更多分段时返回 -ENOENT
+ */
+int log_store_next_segment(uint32_t from, uint32_t *start, uint32_t *size);
+
+/**
+ * @brief 获取当前分段数量和总字节数
+ */
+void log_store_usage(uint32_t *segments, uint32_t *bytes);
+
+#endif /* LOG_STORE_H */
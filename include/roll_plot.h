@@ -0,0 +1,40 @@
+/**
+ * @file roll_plot.h
+ * @brief 整屏滚动光照曲线 (ST7789V 硬件垂直滚动)
+ *
+ * 仪表盘上的 lv_chart 每来一个采样都要把所有点左移，整个图表区域重绘并重新发送。
+ * 滚动图模式下 LVGL 暂停，屏幕由本模块直接驱动：
+ * 驱动把画面旋转 90° 使时间轴沿显存行方向，每个采样只绘制并发送最新的一列 (1 x 240 像素)，
+ * 再移动硬件滚动起点，旧的列由控制器自己滚出屏幕。
+ *
+ * 模式切换由 Shell 发起，实际在显示线程的 roll_plot_poll() 中执行。
+ */
+
+#ifndef ROLL_PLOT_H
+#define ROLL_PLOT_H
+
+#include <zephyr/device.h>
+#include <stdbool.h>
+
+/* ---------------- 配置参数 ---------------- */
+#define ROLL_PLOT_RANGE      500     // 纵轴 0..500 lux，与仪表盘的光照图一致
+#define ROLL_PLOT_GRID_VALUE 100     // 每 100 lux 一条水平网格线
+#define ROLL_PLOT_GRID_COLS  30      // 每 30 个采样一条竖直网格线
+
+/**
+ * @brief 请求进入/退出滚动图模式 (任意线程)
+ */
+void roll_plot_request(bool on);
+
+/**
+ * @brief 滚动图模式是否正在占用屏幕
+ */
+bool roll_plot_is_active(void);
+
+/**
+ * @brief 显示线程主循环中调用
+ * @return true 表示滚动图模式占用屏幕，本轮不要运行 LVGL
+ */
+bool roll_plot_poll(const struct device *dev);
+
+#endif /* ROLL_PLOT_H */
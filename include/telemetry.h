@@ -0,0 +1,79 @@
+/**
+ * @file telemetry.h
+ * @brief 实时传感器遥测流 (UART 异步 API + DMA 双缓冲)
+ *
+ * 采样线程把原始数据打包成定长二进制帧，追加到当前填充缓冲区；
+ * 另一个缓冲区同时由 DMA 发送，发送完成中断里交换缓冲区继续发送。
+ * 打包只是整数拷贝，没有任何格式化开销。
+ *
+ * 帧格式 (小端)：
+ *   [0xA5 0x5A] [mask u8] [len u8] [seq u32] [ts_us u32] [payload len 字节] [crc16 u16]
+ * payload 按 mask 位顺序拼接：
+ *   TELEM_CH_IMU  ax ay az gx gy gz  (int16 原始值, ±2g / ±250dps)
+ *   TELEM_CH_ENV  温度 湿度          (int16, ×100)
+ *   TELEM_CH_LUX  光照               (uint16 原始值)
+ * crc16 为 CRC16-CCITT (种子 0xFFFF)，覆盖同步字之后到 payload 结尾。
+ * seq 对每个生成的帧递增，包括因缓冲区满被丢弃的帧，主机据序号缺口统计丢帧。
+ *
+ * 主机端接收工具见 tools/telemetry_rx.py。
+ */
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <zephyr/types.h>
+#include <zephyr/sys/util.h>
+
+/* ---------------- 配置参数 ---------------- */
+#define TELEM_BUF_SIZE        512     // 每个 DMA 缓冲区大小
+#define TELEM_DEFAULT_ODR_HZ  1000    // 遥测期间 IMU 输出数据率
+
+/* 通道掩码 */
+#define TELEM_CH_IMU   BIT(0)
+#define TELEM_CH_ENV   BIT(1)
+#define TELEM_CH_LUX   BIT(2)
+#define TELEM_CH_ALL   (TELEM_CH_IMU | TELEM_CH_ENV | TELEM_CH_LUX)
+
+struct telemetry_stats {
+    bool running;
+    uint8_t mask;
+    uint16_t decimation;
+    uint32_t frames;       // 已生成的帧 (含丢弃)
+    uint32_t dropped;      // 两个缓冲区都满而丢弃的帧
+    uint32_t bytes;        // 已交给 DMA 的字节数
+    uint32_t tx_errors;
+    uint32_t baudrate;
+};
+
+/**
+ * @brief 开始遥测
+ * @param mask       通道掩码 (TELEM_CH_*)
+ * @param decimation 每 decimation 个 IMU 样本发送一帧 (>= 1)
+ * @return 0 成功, -ENODEV UART 不支持异步 API, -EINVAL 参数错误,
+ *         -EBUSY 遥测串口同时是控制台或 Shell 串口
+ */
+int telemetry_start(uint8_t mask, uint16_t decimation);
+
+/**
+ * @brief 停止遥测，正在进行的 DMA 传输会被中止
+ */
+void telemetry_stop(void);
+
+/**
+ * @brief 推送一个 IMU 样本 (由 IMU 线程调用，不会阻塞)
+ * @param raw ax, ay, az, temp, gx, gy, gz
+ */
+void telemetry_push_imu(const int16_t raw[7]);
+
+/**
+ * @brief IMU 线程当前应使用的输出数据率
+ * @return 遥测进行中返回遥测 ODR，否则返回 0
+ */
+uint16_t telemetry_wanted_odr(void);
+
+/**
+ * @brief 获取运行统计
+ */
+void telemetry_get_stats(struct telemetry_stats *stats);
+
+#endif /* TELEMETRY_H */
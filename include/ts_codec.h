@@ -0,0 +1,77 @@
+/**
+ * @file ts_codec.h
+ * @brief 传感器时间序列压缩 (Gorilla 风格)
+ *
+ * - 时间戳：二阶差分 (delta-of-delta)，周期固定时每条记录只占 1 bit；
+ * - 温度/湿度按 0.01 量化、光照取整，再做一阶差分 + zigzag + 变长前缀编码；
+ * - 按帧 (最大 TS_FRAME_SIZE 字节) 输出，每帧自带首时间戳和基准值，可独立解码；
+ * - 帧 CRC 同时覆盖帧头 (crc 字段按 0 计算) 和比特流，时间戳、条数、长度损坏都能检出。
+ */
+
+#ifndef TS_CODEC_H
+#define TS_CODEC_H
+
+#include <zephyr/types.h>
+#include <stddef.h>
+
+#include "log_store.h"
+
+/* 帧大小：帧头 + 比特流 */
+#define TS_FRAME_SIZE       256
+#define TS_FRAME_MAGIC      0x3254u   // "T2" (帧头纳入 CRC 之前的格式为 "TG")
+
+/**
+ * @brief 帧头 (小端存储)
+ */
+struct ts_frame_hdr {
+    uint16_t magic;
+    uint16_t count;      // 帧内记录数
+    uint16_t len;        // 整帧字节数 (含帧头)
+    uint16_t crc;        // 帧头 (本字段为 0) + 比特流的 CRC16-CCITT
+    uint32_t first_ts;   // 第一条记录时间戳
+    uint32_t last_ts;    // 最后一条记录时间戳 (查询时据此整帧跳过)
+} __packed;
+
+#define TS_FRAME_PAYLOAD    (TS_FRAME_SIZE - sizeof(struct ts_frame_hdr))
+
+/**
+ * @brief 流式编码器状态
+ */
+struct ts_encoder {
+    uint8_t frame[TS_FRAME_SIZE];
+    uint32_t bit_pos;         // 比特流写入位置 (不含帧头)
+    uint16_t count;
+    uint32_t first_ts;
+    uint32_t prev_ts;
+    int32_t prev_delta;       // 上一次的时间差
+    int32_t prev_val[3];      // 上一条记录的量化值: 温度, 湿度, 光照
+};
+
+/**
+ * @brief 开始一个新帧
+ */
+void ts_encoder_reset(struct ts_encoder *enc);
+
+/**
+ * @brief 向当前帧追加一条记录
+ * @return 0 成功, -ENOSPC 当前帧已满 (调用方应先输出帧再重试)
+ */
+int ts_encoder_add(struct ts_encoder *enc, const struct log_record *rec);
+
+/**
+ * @brief 结束当前帧：填写帧头
+ * @return 帧字节数，帧为空时返回 0；帧数据位于 enc->frame
+ */
+size_t ts_encoder_finish(struct ts_encoder *enc);
+
+/**
+ * @brief 解码一个完整的帧
+ * @param frame 帧数据 (含帧头)
+ * @param len   帧数据长度
+ * @param cb    每条记录的回调，返回非 0 时停止
+ * @param user_data 透传参数
+ * @return 解码的记录数；帧损坏返回 -EBADMSG；回调要求停止时返回 -ECANCELED
+ */
+int ts_decode_frame(const uint8_t *frame, size_t len, log_query_cb_t cb, void *user_data);
+
+#endif /* TS_CODEC_H */
@@ -0,0 +1,76 @@
+/**
+ * @file ui_bench.h
+ * @brief 仪表盘离屏渲染基准测试
+ *
+ * 在显示线程中把真实的仪表盘代码 (dashboard.h) 建到一个离屏 lv_display 上，
+ * 该显示的 flush 回调不发送像素，只记录每次 flush 的区域和字节数。
+ * 然后按脚本注入传感器数据和按键，每一步渲染一帧，统计：
+ *   - 仪表盘构建时间和 LVGL 堆占用；
+ *   - 整屏重绘时间和字节数；
+ *   - 每帧渲染时间、flush 字节数、每次更新的失效面积，以及按模拟时间折算的字节/秒。
+ * 测量不经过 SPI，结果与屏幕接口和刷新模式无关，可以直接对比界面改动前后的开销。
+ *
+ * 测试期间屏幕停在最后一帧，结束后在实际屏幕上重建仪表盘 (光照曲线从空开始)。
+ */
+
+#ifndef UI_BENCH_H
+#define UI_BENCH_H
+
+#include <zephyr/types.h>
+#include <zephyr/shell/shell.h>
+
+/* ---------------- 配置参数 ---------------- */
+#define UI_BENCH_DEFAULT_STEPS  300    // 每步对应一个刷新周期，约 10 秒
+#define UI_BENCH_MAX_STEPS      3000
+#define UI_BENCH_STEP_MS        33     // 一步的模拟时长 (LVGL 默认刷新周期)
+#define UI_BENCH_LUX_STEPS      30     // 光照每秒一次 (ap3216c_thread)
+#define UI_BENCH_ENV_STEPS      60     // 温湿度每 2 秒一次 (aht10_thread)
+#define UI_BENCH_KEY_STEPS      45     // 约每 1.5 秒切换一次焦点
+#define UI_BENCH_FULL_FRAMES    5      // 整屏重绘取平均的次数
+
+struct ui_bench_result {
+    uint32_t build_us;          // setup_pandora_dashboard() 耗时
+    uint32_t heap_base;         // 删除实际仪表盘后的 LVGL 堆占用 (字节)
+    uint32_t heap_built;        // 离屏仪表盘建好后的占用
+    uint32_t heap_peak;         // 测试结束时的 LVGL 堆历史峰值 (开机以来)
+    uint32_t full_us;           // 整屏重绘平均耗时
+    uint32_t full_bytes;        // 整屏重绘的 flush 字节数
+    uint32_t full_flushes;      // 整屏重绘的 flush 次数
+    uint32_t steps;
+    uint32_t frames;            // 有像素输出的步数
+    uint32_t render_us_sum;
+    uint32_t render_us_max;
+    uint32_t flush_bytes;
+    uint32_t flushes;
+    uint32_t inv_px;            // 失效区域面积之和 (LVGL 合并前)
+    uint32_t inv_areas;
+    uint32_t flush_px;          // 实际渲染并输出的面积
+};
+
+/**
+ * @brief 请求显示线程执行测试并等待结果 (Shell 线程调用)
+ * @retval -EBUSY 已有测试在进行，或滚动图模式占用屏幕
+ * @retval -ETIMEDOUT 显示线程没有响应
+ */
+int ui_bench_run(uint32_t steps, struct ui_bench_result *out);
+
+/**
+ * @brief 在调用线程中直接执行测试 (调用方就是 LVGL 线程，如 tests/ui_bench)
+ *
+ * 借用当前默认显示的绘图缓冲，先删除其活动屏幕上的仪表盘；结束后活动屏幕为空，
+ * 需要时由调用方重建。不能与 ui_bench_run() 同时使用。
+ * @return 0 成功, -ENODEV 默认显示没有绘图缓冲, -ENOMEM 无法创建离屏显示
+ */
+int ui_bench_measure(uint32_t steps, struct ui_bench_result *out);
+
+/**
+ * @brief 显示线程主循环中调用：有待执行的测试时执行
+ */
+void ui_bench_poll(void);
+
+/**
+ * @brief 按 ui bench 命令的格式输出测试结果 (ui_shell.c)
+ */
+void ui_bench_print(const struct shell *sh, const struct ui_bench_result *r);
+
+#endif /* UI_BENCH_H */
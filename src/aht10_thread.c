@@ -8,6 +8,8 @@
 #include <zephyr/logging/log.h>
 #include "aht10.h"
 #include "data_center.h"
+#include "boot_prof.h"
+#include "display_thread.h"
 
 // 注册日志模块
 LOG_MODULE_REGISTER(AHT10_TASK, LOG_LEVEL_INF);
@@ -28,17 +30,21 @@ void aht10_thread_entry(void *p1, void *p2, void *p3)
 
     LOG_INF("AHT10 Thread started. I2C Bus: %s", aht10_i2c_spec.bus->name);
 
+    boot_prof_begin(BOOT_STEP_AHT10);
+
     // 1. 检查 I2C 总线是否就绪
     if (!device_is_ready(aht10_i2c_spec.bus)) {
         LOG_ERR("I2C Bus is not ready. Aborting AHT10 thread.");
+        boot_prof_end(BOOT_STEP_AHT10, -ENODEV);
         return;
     }
 
     // 2. 初始化传感器
-    // AHT10 上电后需要一点时间稳定，建议先等待
-    k_msleep(100); 
+    // AHT10 上电后需要一点时间稳定：按开机时刻计算，线程启动时通常已经满足
+    k_sleep(K_TIMEOUT_ABS_MS(AHT10_POWER_ON_MS));
 
     ret = aht10_init_sensor(&aht10_i2c_spec);
+    boot_prof_end(BOOT_STEP_AHT10, ret);
     if (ret != 0) {
         LOG_ERR("AHT10 initialization failed: %d", ret);
         // 初始化失败是否退出线程取决于你的需求，这里选择继续尝试或直接退出
@@ -59,6 +65,7 @@ void aht10_thread_entry(void *p1, void *p2, void *p3)
             // 将数据放入消息队列供其他模块使用
             // K_NO_WAIT: 如果队列满了，丢弃旧数据或直接跳过，不阻塞线程
             k_msgq_put(&aht10_msgq, &sensor_data, K_NO_WAIT);
+            display_wake(DISPLAY_EVT_SENSOR);
             // 同时更新数据中心的全局状态
             data_center_update_env(&sensor_data);
         } else {
@@ -10,6 +10,8 @@
 #include <errno.h> // 引入标准错误码
 #include "ap3216c_thread.h"
 #include "data_center.h"
+#include "boot_prof.h"
+#include "display_thread.h"
 
 // 启用日志记录
 LOG_MODULE_REGISTER(AP3216C_TASK, LOG_LEVEL_INF);
@@ -69,9 +71,12 @@ void ap3216c_thread_entry(void *p1, void *p2, void *p3)
 
     LOG_INF("AP3216C Thread started. I2C Bus: %s", ap3216c_i2c_spec.bus->name);
 
+    boot_prof_begin(BOOT_STEP_AP3216C);
+
     // 1. 检查 I2C 设备是否就绪
     if (!device_is_ready(ap3216c_i2c_spec.bus)) {
         LOG_ERR("I2C Bus is not ready. Aborting thread.");
+        boot_prof_end(BOOT_STEP_AP3216C, -ENODEV);
         return;
     }
 
@@ -79,11 +84,13 @@ void ap3216c_thread_entry(void *p1, void *p2, void *p3)
     ret = ap3216c_init();
     if (ret != 0) {
         LOG_ERR("Sensor initialization failed. Aborting thread. Error: %d", ret);
+        boot_prof_end(BOOT_STEP_AP3216C, ret);
         return;
     }
 
-    // 等待传感器启动 (至少 300ms)
-    k_msleep(500);
+    // 等待第一轮转换完成 (按手册的转换时间，而不是固定等 500ms)
+    boot_prof_sleep(AP3216C_ALS_PS_CONV_MS);
+    boot_prof_end(BOOT_STEP_AP3216C, 0);
 
     // 3. 周期性读取数据
     while (1) {
@@ -93,6 +100,7 @@ void ap3216c_thread_entry(void *p1, void *p2, void *p3)
             LOG_DBG("ALS Data: %u raw", als_value);
             // K_NO_WAIT 表示如果队列满了，不等待直接跳过
             k_msgq_put(&als_msgq, &als_value, K_NO_WAIT);
+            display_wake(DISPLAY_EVT_SENSOR);
             // 同时更新数据中心的全局状态
             data_center_update_lux(als_value);
         } else {
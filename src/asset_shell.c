@@ -0,0 +1,54 @@
+/*
+ * application/src/asset_shell.c
+ * 资源包 Shell 命令：asset list / verify
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+
+#include "asset_store.h"
+
+static int cmd_asset_list(const struct shell *sh, size_t argc, char **argv)
+{
+    const struct asset_entry *e;
+
+    if (!asset_store_ready()) {
+        shell_print(sh, "font_partition 中没有有效的资源包 (用 tools/asset_pack.py 生成)");
+        return 0;
+    }
+
+    shell_print(sh, "%-24s %-6s %10s %10s", "名称", "类型", "偏移", "大小");
+    asset_xip_lock();
+    for (int i = 0; (e = asset_store_entry(i)) != NULL; i++) {
+        shell_print(sh, "%-24.24s %-6s 0x%08x %10u", e->name,
+                    (e->type == ASSET_TYPE_FONT) ? "字体" :
+                    (e->type == ASSET_TYPE_IMAGE) ? "图片" : "?", e->offset, e->size);
+    }
+    asset_xip_unlock();
+    return 0;
+}
+
+static int cmd_asset_verify(const struct shell *sh, size_t argc, char **argv)
+{
+    int64_t t0 = k_uptime_get();
+    int ret = asset_store_verify();
+
+    if (ret == -ENOENT) {
+        shell_print(sh, "没有资源包");
+        return 0;
+    }
+    if (ret < 0) {
+        shell_error(sh, "CRC 不一致，资源包已损坏");
+        return ret;
+    }
+    shell_print(sh, "CRC 正确 (%lld ms)", k_uptime_get() - t0);
+    return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_asset,
+    SHELL_CMD(list, NULL, "列出资源包中的字体和图片", cmd_asset_list),
+    SHELL_CMD(verify, NULL, "校验整个资源包的 CRC", cmd_asset_verify),
+    SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(asset, &sub_asset, "Flash 字体/图片资源包 (XIP)", NULL);
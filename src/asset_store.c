@@ -0,0 +1,291 @@
+/*
+ * application/src/asset_store.c
+ * 资源包：在 QSPI 内存映射窗口 (native_sim 上为 Flash 模拟器的 mmap 文件) 中直接访问字体和图片
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/sys/crc.h>
+#include <zephyr/logging/log.h>
+#include <string.h>
+
+#include "asset_store.h"
+#include "glyph_cache.h"
+
+#ifdef CONFIG_FLASH_SIMULATOR
+#include <zephyr/drivers/flash/flash_simulator.h>
+#endif
+
+LOG_MODULE_REGISTER(ASSET_STORE, LOG_LEVEL_INF);
+
+#define ASSET_PARTITION_SIZE    FIXED_PARTITION_SIZE(font_partition)
+#define ASSET_PARTITION_OFFSET  FIXED_PARTITION_OFFSET(font_partition)
+#define ASSET_FLASH_DEV         FIXED_PARTITION_DEVICE(font_partition)
+
+#ifndef CONFIG_FLASH_SIMULATOR
+/* QSPI 控制器的第二段 reg 是内存映射窗口 (STM32L4 为 0x90000000) */
+#define ASSET_QSPI_NODE         DT_PARENT(DT_NODELABEL(w25q128jv))
+#define ASSET_XIP_BASE          DT_REG_ADDR_BY_IDX(ASSET_QSPI_NODE, 1)
+#endif
+
+struct asset_font {
+    const struct asset_entry *entry;
+    lv_font_t font;
+    lv_font_fmt_txt_dsc_t dsc;
+    lv_font_fmt_txt_cmap_t cmaps[ASSET_MAX_CMAPS];
+};
+
+struct asset_image {
+    const struct asset_entry *entry;
+    lv_image_dsc_t dsc;
+};
+
+static const uint8_t *pack;          // 资源包在地址空间中的起始位置
+static const struct asset_pack_hdr *pack_hdr;
+static const struct asset_entry *entries;
+
+static struct asset_font fonts[ASSET_MAX_FONTS];
+static int font_count;
+static struct asset_image images[ASSET_MAX_IMAGES];
+static int image_count;
+
+static K_MUTEX_DEFINE(xip_lock);
+
+const uint8_t *asset_xip_ptr(off_t off)
+{
+#ifdef CONFIG_FLASH_SIMULATOR
+    size_t size;
+    uint8_t *mem = flash_simulator_get_memory(ASSET_FLASH_DEV, &size);
+
+    return (mem != NULL && off >= 0 && off < size) ? mem + off : NULL;
+#else
+    return (const uint8_t *)(ASSET_XIP_BASE + off);
+#endif
+}
+
+void asset_xip_lock(void)
+{
+    k_mutex_lock(&xip_lock, K_FOREVER);
+}
+
+void asset_xip_unlock(void)
+{
+    k_mutex_unlock(&xip_lock);
+}
+
+bool asset_xip_lock_if_mapped(void)
+{
+    if (pack == NULL) {
+        return false;
+    }
+    asset_xip_lock();
+    return true;
+}
+
+void asset_xip_remap(void)
+{
+#ifdef CONFIG_STM32_MEMMAP
+    uint8_t dummy;
+
+    /* QSPI 驱动在读操作时检测到未处于映射模式会重新进入 */
+    flash_read(ASSET_FLASH_DEV, ASSET_PARTITION_OFFSET, &dummy, 1);
+#endif
+}
+
+int asset_store_init(void)
+{
+    const struct asset_pack_hdr *hdr;
+    const uint8_t *base = asset_xip_ptr(ASSET_PARTITION_OFFSET);
+
+    if (base == NULL || asset_xip_ptr(ASSET_PARTITION_OFFSET + ASSET_PARTITION_SIZE - 1) == NULL) {
+        return -ENODEV;
+    }
+
+    asset_xip_lock();
+    asset_xip_remap();
+    hdr = (const struct asset_pack_hdr *)base;
+    if (hdr->magic != ASSET_PACK_MAGIC) {
+        asset_xip_unlock();
+        return -ENOENT;
+    }
+    if (hdr->version != ASSET_PACK_VERSION || hdr->total_size > ASSET_PARTITION_SIZE ||
+        sizeof(*hdr) + hdr->count * sizeof(struct asset_entry) > hdr->total_size) {
+        asset_xip_unlock();
+        LOG_ERR("资源包头部无效 (版本 %u, 大小 %u)", hdr->version, hdr->total_size);
+        return -EINVAL;
+    }
+
+    pack = base;
+    pack_hdr = hdr;
+    entries = (const struct asset_entry *)(base + sizeof(*hdr));
+    LOG_INF("资源包: %u 项, %u KB", hdr->count, hdr->total_size / 1024);
+    asset_xip_unlock();
+    return 0;
+}
+
+bool asset_store_ready(void)
+{
+    return pack != NULL;
+}
+
+const struct asset_entry *asset_store_entry(int idx)
+{
+    if (pack == NULL || idx < 0 || idx >= pack_hdr->count) {
+        return NULL;
+    }
+    return &entries[idx];
+}
+
+int asset_store_verify(void)
+{
+    uint32_t crc;
+
+    if (pack == NULL) {
+        return -ENOENT;
+    }
+
+    asset_xip_lock();
+    crc = crc32_ieee(pack + sizeof(*pack_hdr), pack_hdr->total_size - sizeof(*pack_hdr));
+    asset_xip_unlock();
+
+    return (crc == pack_hdr->crc) ? 0 : -EBADMSG;
+}
+
+static const struct asset_entry *find_entry(const char *name, uint8_t type)
+{
+    for (int i = 0; pack != NULL && i < pack_hdr->count; i++) {
+        if (entries[i].type == type && strncmp(entries[i].name, name, ASSET_NAME_LEN) == 0 &&
+            entries[i].offset + entries[i].size <= pack_hdr->total_size) {
+            return &entries[i];
+        }
+    }
+    return NULL;
+}
+
+/* 在 RAM 中建立 LVGL 字体描述，所有数组指针指向映射窗口 */
+static int font_build(struct asset_font *f, const struct asset_entry *e)
+{
+    const uint8_t *base = pack + e->offset;
+    const struct asset_font_hdr *hdr = (const struct asset_font_hdr *)base;
+    const struct asset_font_cmap *cm = (const struct asset_font_cmap *)(base + hdr->cmaps_off);
+    bool large = (hdr->flags & ASSET_FONT_FLAG_LARGE) != 0;
+
+    /* 字形描述表直接给 LVGL 使用，布局必须与本机 LVGL 配置一致 */
+    if (large != (LV_FONT_FMT_TXT_LARGE != 0)) {
+        LOG_ERR("%s: 字形表布局 (large=%d) 与 LV_FONT_FMT_TXT_LARGE 不一致", e->name, large);
+        return -ENOTSUP;
+    }
+    if (hdr->cmap_num > ASSET_MAX_CMAPS) {
+        LOG_ERR("%s: 字符映射段 %u 个，超过 %d", e->name, hdr->cmap_num, ASSET_MAX_CMAPS);
+        return -ENOTSUP;
+    }
+
+    memset(f, 0, sizeof(*f));
+    f->entry = e;
+
+    for (int i = 0; i < hdr->cmap_num; i++) {
+        f->cmaps[i].range_start = cm[i].range_start;
+        f->cmaps[i].range_length = cm[i].range_length;
+        f->cmaps[i].glyph_id_start = cm[i].glyph_id_start;
+        f->cmaps[i].unicode_list = cm[i].unicode_list_off
+                                   ? (const uint16_t *)(base + cm[i].unicode_list_off) : NULL;
+        f->cmaps[i].glyph_id_ofs_list = cm[i].glyph_id_ofs_list_off
+                                        ? base + cm[i].glyph_id_ofs_list_off : NULL;
+        f->cmaps[i].list_length = cm[i].list_length;
+        f->cmaps[i].type = cm[i].type;
+    }
+
+    f->dsc.glyph_bitmap = base + hdr->bitmap_off;
+    f->dsc.glyph_dsc = (const lv_font_fmt_txt_glyph_dsc_t *)(base + hdr->glyph_dsc_off);
+    f->dsc.cmaps = f->cmaps;
+    f->dsc.cmap_num = hdr->cmap_num;
+    f->dsc.bpp = hdr->bpp;
+    f->dsc.bitmap_format = hdr->bitmap_format;
+
+    f->font.get_glyph_dsc = lv_font_get_glyph_dsc_fmt_txt;
+    f->font.get_glyph_bitmap = lv_font_get_bitmap_fmt_txt;
+    f->font.line_height = hdr->line_height;
+    f->font.base_line = hdr->base_line;
+    f->font.underline_position = hdr->underline_position;
+    f->font.underline_thickness = hdr->underline_thickness;
+    f->font.dsc = &f->dsc;
+
+    /* 字形位图在外部 Flash 中，展开后的位图缓存到 SRAM1 */
+    glyph_cache_attach(&f->font);
+    return 0;
+}
+
+const lv_font_t *asset_font_get(const char *name)
+{
+    const struct asset_entry *e;
+
+    for (int i = 0; i < font_count; i++) {
+        if (strncmp(fonts[i].entry->name, name, ASSET_NAME_LEN) == 0) {
+            return &fonts[i].font;
+        }
+    }
+
+    e = find_entry(name, ASSET_TYPE_FONT);
+    if (e == NULL || font_count == ASSET_MAX_FONTS) {
+        return NULL;
+    }
+
+    asset_xip_lock();
+    int ret = font_build(&fonts[font_count], e);
+    asset_xip_unlock();
+
+    return (ret == 0) ? &fonts[font_count++].font : NULL;
+}
+
+const lv_image_dsc_t *asset_image_get(const char *name)
+{
+    const struct asset_entry *e;
+    const struct asset_image_hdr *hdr;
+    struct asset_image *img;
+
+    for (int i = 0; i < image_count; i++) {
+        if (strncmp(images[i].entry->name, name, ASSET_NAME_LEN) == 0) {
+            return &images[i].dsc;
+        }
+    }
+
+    e = find_entry(name, ASSET_TYPE_IMAGE);
+    if (e == NULL || image_count == ASSET_MAX_IMAGES) {
+        return NULL;
+    }
+
+    asset_xip_lock();
+    hdr = (const struct asset_image_hdr *)(pack + e->offset);
+    if (sizeof(*hdr) + hdr->data_size > e->size) {
+        asset_xip_unlock();
+        return NULL;
+    }
+    img = &images[image_count];
+    memset(img, 0, sizeof(*img));
+    img->entry = e;
+    img->dsc.header.magic = LV_IMAGE_HEADER_MAGIC;
+    img->dsc.header.cf = hdr->cf;
+    img->dsc.header.w = hdr->w;
+    img->dsc.header.h = hdr->h;
+    img->dsc.header.stride = hdr->stride;
+    img->dsc.data_size = hdr->data_size;
+    img->dsc.data = (const uint8_t *)hdr + sizeof(*hdr);
+    asset_xip_unlock();
+
+    return &images[image_count++].dsc;
+}
+
+static int auto_init_asset_store(void)
+{
+    int ret = asset_store_init();
+
+    if (ret == -ENOENT) {
+        LOG_INF("font_partition 中没有资源包");
+    }
+    return 0;
+}
+
+/* Flash 驱动在 POST_KERNEL 阶段已就绪，显示线程启动前完成 */
+SYS_INIT(auto_init_asset_store, APPLICATION, 60);
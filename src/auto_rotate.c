@@ -0,0 +1,142 @@
+/*
+ * application/src/auto_rotate.c
+ * 屏幕方向：ST7789V 硬件旋转 + 按重力方向自动旋转
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/display.h>
+#include <zephyr/logging/log.h>
+#include <math.h>
+#include <lvgl.h>
+
+#include "auto_rotate.h"
+#include "lcd_flush.h"
+#include "display_thread.h"
+#include "data_center.h"
+
+LOG_MODULE_REGISTER(AUTO_ROTATE, LOG_LEVEL_INF);
+
+#define ORIENT_NONE  (-1)
+
+static atomic_t auto_on;
+static atomic_t requested = ATOMIC_INIT(ORIENT_NONE);
+static enum display_orientation current = DISPLAY_ORIENTATION_NORMAL;
+
+/* 迟滞状态，只在显示线程中使用 */
+static int candidate = ORIENT_NONE;
+static int64_t candidate_since;
+
+static const uint16_t orient_deg[] = {0, 90, 180, 270};
+
+void auto_rotate_set(enum display_orientation orientation)
+{
+    atomic_set(&auto_on, 0);
+    atomic_set(&requested, orientation);
+    display_wake(DISPLAY_EVT_CMD);
+}
+
+void auto_rotate_enable(bool on)
+{
+    candidate = ORIENT_NONE;
+    atomic_set(&auto_on, on);
+}
+
+bool auto_rotate_is_enabled(void)
+{
+    return atomic_get(&auto_on) != 0;
+}
+
+enum display_orientation auto_rotate_current(void)
+{
+    return current;
+}
+
+/* 屏幕平面内重力分量最大的方向；分量不够或平放时返回 ORIENT_NONE */
+static int gravity_orientation(const icm20608_data_t *imu)
+{
+    float gx = imu->accel_x * AUTO_ROTATE_SIGN_X;
+    float gy = imu->accel_y * AUTO_ROTATE_SIGN_Y;
+
+    if (fabsf(imu->accel_z) > AUTO_ROTATE_FLAT_G) {
+        return ORIENT_NONE;
+    }
+    if (fabsf(gy) >= fabsf(gx)) {
+        if (fabsf(gy) < AUTO_ROTATE_ENTER_G) {
+            return ORIENT_NONE;
+        }
+        return (gy > 0) ? DISPLAY_ORIENTATION_NORMAL : DISPLAY_ORIENTATION_ROTATED_180;
+    }
+    if (fabsf(gx) < AUTO_ROTATE_ENTER_G) {
+        return ORIENT_NONE;
+    }
+    return (gx > 0) ? DISPLAY_ORIENTATION_ROTATED_90 : DISPLAY_ORIENTATION_ROTATED_270;
+}
+
+static void auto_rotate_track(void)
+{
+    system_data_t snap;
+    int o;
+
+    data_center_get_snapshot(&snap);
+    if (!(snap.fresh & DC_EVT_IMU)) {
+        return;
+    }
+
+    o = gravity_orientation(&snap.imu_accel_gyro);
+    if (o == ORIENT_NONE || o == (int)current) {
+        candidate = ORIENT_NONE;
+        return;
+    }
+    if (o != candidate) {
+        candidate = o;
+        candidate_since = k_uptime_get();
+        return;
+    }
+    if (k_uptime_get() - candidate_since >= AUTO_ROTATE_HOLD_MS) {
+        atomic_set(&requested, o);
+        candidate = ORIENT_NONE;
+    }
+}
+
+static int apply(const struct device *dev, enum display_orientation o)
+{
+    lv_display_t *disp = lv_display_get_default();
+    struct display_capabilities cap;
+    int ret;
+
+    /* 改方向前等最后一块像素发送完，否则它会按新的扫描顺序写进显存 */
+    lcd_flush_wait();
+    ret = display_set_orientation(dev, o);
+    if (ret < 0) {
+        return ret;
+    }
+
+    /* 驱动按旋转后的方向报告分辨率；LVGL 按新分辨率整屏重绘 */
+    display_get_capabilities(dev, &cap);
+    lv_display_set_resolution(disp, cap.x_resolution, cap.y_resolution);
+    lv_obj_invalidate(lv_screen_active());
+    current = o;
+    return 0;
+}
+
+void auto_rotate_poll(const struct device *dev)
+{
+    int o;
+    int ret;
+
+    if (atomic_get(&auto_on)) {
+        auto_rotate_track();
+    }
+
+    o = atomic_set(&requested, ORIENT_NONE);
+    if (o == ORIENT_NONE || o == (int)current) {
+        return;
+    }
+
+    ret = apply(dev, o);
+    if (ret < 0) {
+        LOG_WRN("旋转到 %u° 失败: %d", orient_deg[o], ret);
+    } else {
+        LOG_INF("屏幕方向 %u°", orient_deg[o]);
+    }
+}
@@ -0,0 +1,396 @@
+/*
+ * application/src/boot_frame.c
+ * Flash 中预渲染的开机画面：RLE 采集 / 解压推送
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/display.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/sys/crc.h>
+#include <zephyr/logging/log.h>
+#include <lvgl.h>
+#include <lvgl_private.h>   // 读取 lv_display_t::flush_cb，用于包装原回调
+#include <string.h>
+
+#include "boot_frame.h"
+#include "asset_store.h"
+
+LOG_MODULE_REGISTER(BOOT_FRAME, LOG_LEVEL_INF);
+
+#define BOOT_FRAME_PARTITION_ID  FIXED_PARTITION_ID(boot_frame_partition)
+#define BOOT_FRAME_PART_SIZE     FIXED_PARTITION_SIZE(boot_frame_partition)
+
+#define RLE_MAX_COUNT    128     // 一个包最多 128 个像素
+#define RLE_MIN_RUN      3       // 重复 3 个以上才值得用重复包
+#define IO_CHUNK         256     // Flash 读写缓冲 (一页)
+#define SHOW_ROWS        8       // 解压时每次推送给屏幕的行数
+#define SHOW_MAX_WIDTH   240     // 行缓冲按该宽度分配
+
+BUILD_ASSERT(sizeof(struct boot_frame_hdr) <= BOOT_FRAME_DATA_OFFSET);
+
+/* ---------------- 采集 (压缩 + 写 Flash) ---------------- */
+
+struct rle_writer {
+    const struct flash_area *fa;
+    uint32_t off;                  // 下一次写 Flash 的数据偏移 (相对 DATA_OFFSET)
+    uint32_t crc;
+    uint8_t page[IO_CHUNK];
+    size_t fill;
+    uint16_t lit[RLE_MAX_COUNT];   // 待输出的原样像素
+    size_t nlit;
+    uint16_t run_px;               // 当前重复的像素
+    size_t nrun;
+    int err;
+};
+
+static struct rle_writer wr;
+
+static lv_display_flush_cb_t orig_flush_cb;
+static int32_t next_row;           // 期望的下一块刷新区域起始行
+static int32_t frame_width;
+
+static void wr_bytes(const void *data, size_t len)
+{
+    const uint8_t *p = data;
+
+    while (len > 0 && wr.err == 0) {
+        size_t n = MIN(len, sizeof(wr.page) - wr.fill);
+
+        memcpy(&wr.page[wr.fill], p, n);
+        wr.fill += n;
+        p += n;
+        len -= n;
+
+        if (wr.fill == sizeof(wr.page)) {
+            if (BOOT_FRAME_DATA_OFFSET + wr.off + wr.fill > BOOT_FRAME_PART_SIZE) {
+                wr.err = -EFBIG;
+                return;
+            }
+            wr.err = flash_area_write(wr.fa, BOOT_FRAME_DATA_OFFSET + wr.off, wr.page, wr.fill);
+            wr.crc = crc32_ieee_update(wr.crc, wr.page, wr.fill);
+            wr.off += wr.fill;
+            wr.fill = 0;
+        }
+    }
+}
+
+static void rle_flush_literals(void)
+{
+    if (wr.nlit > 0) {
+        uint8_t hdr = (uint8_t)(wr.nlit - 1);
+
+        wr_bytes(&hdr, 1);
+        wr_bytes(wr.lit, wr.nlit * sizeof(uint16_t));
+        wr.nlit = 0;
+    }
+}
+
+/* 结束当前的重复段：够长就输出重复包，否则并入原样包 */
+static void rle_close_run(void)
+{
+    if (wr.nrun >= RLE_MIN_RUN) {
+        uint8_t hdr = 0x80 | (uint8_t)(wr.nrun - 1);
+
+        rle_flush_literals();
+        wr_bytes(&hdr, 1);
+        wr_bytes(&wr.run_px, sizeof(uint16_t));
+    } else {
+        for (size_t i = 0; i < wr.nrun; i++) {
+            wr.lit[wr.nlit++] = wr.run_px;
+            if (wr.nlit == RLE_MAX_COUNT) {
+                rle_flush_literals();
+            }
+        }
+    }
+    wr.nrun = 0;
+}
+
+static void rle_push(const uint16_t *px, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        if (wr.nrun > 0 && px[i] == wr.run_px && wr.nrun < RLE_MAX_COUNT) {
+            wr.nrun++;
+            continue;
+        }
+        if (wr.nrun > 0) {
+            rle_close_run();
+        }
+        wr.run_px = px[i];
+        wr.nrun = 1;
+    }
+}
+
+/*
+ * 包装的 flush 回调：先调用原回调 (Zephyr 的回调可能就地交换 RGB565 字节序)，
+ * 再压缩缓冲区内容，保证保存的字节与实际送给屏幕的一致。
+ * 整屏重绘时 LVGL 按缓冲区大小自上而下分块刷新，每块都是整行。
+ */
+static void capture_flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
+{
+    int32_t w = lv_area_get_width(area);
+    int32_t h = lv_area_get_height(area);
+
+    orig_flush_cb(disp, area, px_map);
+
+    if (wr.err != 0) {
+        return;
+    }
+    if (area->x1 != 0 || w != frame_width || area->y1 != next_row) {
+        wr.err = -ENOTSUP;
+        return;
+    }
+    rle_push((const uint16_t *)px_map, (size_t)w * h);
+    next_row = area->y2 + 1;
+}
+
+int boot_frame_capture(lv_display_t *disp)
+{
+    struct boot_frame_hdr hdr;
+    int32_t height = lv_display_get_vertical_resolution(disp);
+    uint32_t t0 = k_uptime_get_32();
+    int ret;
+
+    memset(&wr, 0, sizeof(wr));
+    ret = flash_area_open(BOOT_FRAME_PARTITION_ID, &wr.fa);
+    if (ret < 0) {
+        return ret;
+    }
+    ret = flash_area_erase(wr.fa, 0, BOOT_FRAME_PART_SIZE);
+    if (ret < 0) {
+        flash_area_close(wr.fa);
+        return ret;
+    }
+
+    frame_width = lv_display_get_horizontal_resolution(disp);
+    next_row = 0;
+    orig_flush_cb = disp->flush_cb;
+    lv_display_set_flush_cb(disp, capture_flush_cb);
+
+    /*
+     * 渲染会读取映射窗口中的字体/图片 (见 asset_store.h)。刷新回调里的 flash_area_write()
+     * 在同一线程中嵌套加锁 (互斥锁可重入)，写完已重新映射，之后的渲染可以继续读取。
+     * 分区擦除在锁外完成，不阻塞其他 Flash 写入方。
+     */
+    bool xip = asset_xip_lock_if_mapped();
+
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(disp);
+    if (xip) {
+        asset_xip_unlock();
+    }
+
+    lv_display_set_flush_cb(disp, orig_flush_cb);
+
+    /* 收尾：输出剩余的像素和不满一页的数据 */
+    rle_close_run();
+    rle_flush_literals();
+    if (wr.err == 0 && wr.fill > 0) {
+        if (BOOT_FRAME_DATA_OFFSET + wr.off + wr.fill > BOOT_FRAME_PART_SIZE) {
+            wr.err = -EFBIG;
+        } else {
+            wr.err = flash_area_write(wr.fa, BOOT_FRAME_DATA_OFFSET + wr.off, wr.page, wr.fill);
+            wr.crc = crc32_ieee_update(wr.crc, wr.page, wr.fill);
+            wr.off += wr.fill;
+        }
+    }
+    if (wr.err == 0 && next_row != height) {
+        wr.err = -EIO;   // 没有刷完整屏
+    }
+
+    /* 头部最后写入：中途失败或掉电时分区里没有有效头部 */
+    hdr = (struct boot_frame_hdr){
+        .width = (uint16_t)frame_width,
+        .height = (uint16_t)height,
+        .layout = BOOT_FRAME_LAYOUT_VERSION,
+    };
+    if (wr.err == 0) {
+        hdr.magic = BOOT_FRAME_MAGIC;
+        hdr.data_len = wr.off;
+        hdr.crc = wr.crc;
+        wr.err = flash_area_write(wr.fa, 0, &hdr, sizeof(hdr));
+    } else if (wr.err == -ENOTSUP || wr.err == -EFBIG || wr.err == -EIO) {
+        /* 刷新分块方式或压缩后大小决定的失败，每次开机都会重现：记下来，不再擦除重试 */
+        hdr.magic = BOOT_FRAME_MAGIC_NOCAP;
+        hdr.crc = (uint32_t)wr.err;
+        flash_area_write(wr.fa, 0, &hdr, sizeof(hdr));
+    }
+    flash_area_close(wr.fa);
+
+    if (wr.err == 0) {
+        LOG_INF("开机画面已保存: %u 字节 (原始 %u 字节), 耗时 %u ms", wr.off,
+                (uint32_t)(frame_width * height * sizeof(uint16_t)), k_uptime_get_32() - t0);
+    }
+    return wr.err;
+}
+
+/* ---------------- 解压推送 ---------------- */
+
+struct rle_reader {
+    const struct flash_area *fa;
+    uint32_t off;          // 下一次读 Flash 的数据偏移
+    uint32_t end;
+    uint32_t crc;
+    uint8_t buf[IO_CHUNK];
+    size_t pos;
+    size_t len;
+    int err;
+};
+
+static uint8_t rd_byte(struct rle_reader *rd)
+{
+    if (rd->pos == rd->len) {
+        if (rd->err != 0 || rd->off >= rd->end) {
+            rd->err = rd->err ? rd->err : -EBADMSG;
+            return 0;
+        }
+        rd->len = MIN(sizeof(rd->buf), rd->end - rd->off);
+        rd->err = flash_area_read(rd->fa, BOOT_FRAME_DATA_OFFSET + rd->off, rd->buf, rd->len);
+        rd->crc = crc32_ieee_update(rd->crc, rd->buf, rd->len);
+        rd->off += rd->len;
+        rd->pos = 0;
+    }
+    return rd->buf[rd->pos++];
+}
+
+static uint16_t rd_pixel(struct rle_reader *rd)
+{
+    uint16_t px;
+    uint8_t *p = (uint8_t *)&px;
+
+    p[0] = rd_byte(rd);
+    p[1] = rd_byte(rd);
+    return px;
+}
+
+static int read_hdr(const struct flash_area *fa, struct boot_frame_hdr *hdr)
+{
+    int ret = flash_area_read(fa, 0, hdr, sizeof(*hdr));
+
+    if (ret < 0) {
+        return ret;
+    }
+    if (hdr->magic == BOOT_FRAME_MAGIC_NOCAP && hdr->layout == BOOT_FRAME_LAYOUT_VERSION) {
+        return -ENOTSUP;
+    }
+    if (hdr->magic != BOOT_FRAME_MAGIC || hdr->layout != BOOT_FRAME_LAYOUT_VERSION ||
+        hdr->data_len == 0 || BOOT_FRAME_DATA_OFFSET + hdr->data_len > BOOT_FRAME_PART_SIZE) {
+        return -ENOENT;
+    }
+    return 0;
+}
+
+int boot_frame_get_info(struct boot_frame_hdr *hdr)
+{
+    const struct flash_area *fa;
+    int ret;
+
+    ret = flash_area_open(BOOT_FRAME_PARTITION_ID, &fa);
+    if (ret < 0) {
+        return ret;
+    }
+    ret = read_hdr(fa, hdr);
+    flash_area_close(fa);
+    return ret;
+}
+
+bool boot_frame_valid(uint16_t width, uint16_t height)
+{
+    struct boot_frame_hdr hdr;
+
+    return boot_frame_get_info(&hdr) == 0 && hdr.width == width && hdr.height == height;
+}
+
+bool boot_frame_capture_needed(uint16_t width, uint16_t height)
+{
+    struct boot_frame_hdr hdr;
+    int ret = boot_frame_get_info(&hdr);
+
+    return !((ret == 0 || ret == -ENOTSUP) && hdr.width == width && hdr.height == height);
+}
+
+int boot_frame_show(const struct device *display)
+{
+    static uint16_t rows[SHOW_ROWS * SHOW_MAX_WIDTH];
+    static struct rle_reader rd;
+    struct display_capabilities caps;
+    struct display_buffer_descriptor desc = {0};
+    struct boot_frame_hdr hdr;
+    uint32_t width, total, done = 0, fill = 0;
+    int ret;
+
+    display_get_capabilities(display, &caps);
+    width = caps.x_resolution;
+    if (width * SHOW_ROWS > ARRAY_SIZE(rows)) {
+        return -ENOTSUP;
+    }
+
+    memset(&rd, 0, sizeof(rd));
+    ret = flash_area_open(BOOT_FRAME_PARTITION_ID, &rd.fa);
+    if (ret < 0) {
+        return ret;
+    }
+    ret = read_hdr(rd.fa, &hdr);
+    if (ret == -ENOTSUP) {
+        ret = -ENOENT;   // 标记为无法采集，没有画面可显示
+    }
+    if (ret == 0 && (hdr.width != caps.x_resolution || hdr.height != caps.y_resolution)) {
+        ret = -ENOENT;
+    }
+    if (ret < 0) {
+        flash_area_close(rd.fa);
+        return ret;
+    }
+
+    rd.end = hdr.data_len;
+    total = width * hdr.height;
+
+    while (done < total && rd.err == 0) {
+        uint8_t pkt = rd_byte(&rd);
+        uint32_t count = (pkt & 0x7F) + 1;
+        uint16_t px = (pkt & 0x80) ? rd_pixel(&rd) : 0;
+
+        if (done + count > total) {
+            rd.err = -EBADMSG;
+            break;
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            rows[fill++] = (pkt & 0x80) ? px : rd_pixel(&rd);
+
+            /* 凑满 SHOW_ROWS 行 (或最后剩余的行) 推送一次 */
+            if (fill == width * SHOW_ROWS || done + i + 1 == total) {
+                uint32_t y = (done + i + 1 - fill) / width;
+
+                desc.width = width;
+                desc.height = fill / width;
+                desc.pitch = width;
+                desc.buf_size = fill * sizeof(uint16_t);
+                if (rd.err == 0) {
+                    rd.err = display_write(display, 0, y, &desc, rows);
+                }
+                fill = 0;
+            }
+        }
+        done += count;
+    }
+    flash_area_close(rd.fa);
+
+    if (rd.err == 0 && (rd.off != rd.end || rd.crc != hdr.crc)) {
+        rd.err = -EBADMSG;
+    }
+    return rd.err;
+}
+
+int boot_frame_erase(void)
+{
+    const struct flash_area *fa;
+    int ret;
+
+    ret = flash_area_open(BOOT_FRAME_PARTITION_ID, &fa);
+    if (ret < 0) {
+        return ret;
+    }
+    /* 只擦除头部所在的扇区即可使画面失效 */
+    ret = flash_area_erase(fa, 0, 4096);
+    flash_area_close(fa);
+    return ret;
+}
@@ -0,0 +1,60 @@
+/*
+ * application/src/boot_frame_shell.c
+ * 开机画面 Shell 命令：bootframe info / erase
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+
+#include "boot_frame.h"
+#include "boot_prof.h"
+
+static int cmd_bootframe_info(const struct shell *sh, size_t argc, char **argv)
+{
+    struct boot_frame_hdr hdr;
+    struct boot_step_record rec;
+    uint32_t raw;
+    int ret = boot_frame_get_info(&hdr);
+
+    if (ret == -ENOTSUP) {
+        shell_print(sh, "%ux%u 布局版本 %u 无法采集开机画面 (%d)，不再重试；erase 后下次开机重新尝试",
+                    hdr.width, hdr.height, hdr.layout, (int)hdr.crc);
+        return 0;
+    }
+    if (ret < 0) {
+        shell_print(sh, "没有有效的开机画面 (%d)，下次开机时采集", ret);
+        return 0;
+    }
+
+    raw = (uint32_t)hdr.width * hdr.height * sizeof(uint16_t);
+    shell_print(sh, "%ux%u, 布局版本 %u, RLE %u 字节 / 原始 %u 字节 (%u%%), CRC 0x%08x",
+                hdr.width, hdr.height, hdr.layout, hdr.data_len, raw, hdr.data_len * 100 / raw,
+                hdr.crc);
+
+    boot_prof_get(BOOT_STEP_BOOT_FRAME, &rec);
+    if (rec.done) {
+        shell_print(sh, "本次开机: %u ms 时显示, 推送耗时 %u ms, 结果 %d", rec.end_us / 1000,
+                    (rec.end_us - rec.start_us) / 1000, rec.result);
+    }
+    return 0;
+}
+
+static int cmd_bootframe_erase(const struct shell *sh, size_t argc, char **argv)
+{
+    int ret = boot_frame_erase();
+
+    if (ret < 0) {
+        shell_error(sh, "擦除失败: %d", ret);
+        return ret;
+    }
+    shell_print(sh, "已擦除，下次开机重新采集");
+    return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_bootframe,
+    SHELL_CMD(info, NULL, "开机画面信息与本次显示耗时", cmd_bootframe_info),
+    SHELL_CMD(erase, NULL, "擦除开机画面 (下次开机重新采集)", cmd_bootframe_erase),
+    SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(bootframe, &sub_bootframe, "Flash 预渲染开机画面", NULL);
@@ -0,0 +1,65 @@
+/*
+ * application/src/boot_prof_shell.c
+ * 开机时间线 Shell 命令：boot
+ *
+ * 每个步骤一行：开始 / 结束 / 耗时 / 其中休眠的时长，以及按时间轴画出的区间，
+ * 便于看出哪些步骤是并行的、首帧被哪个步骤拖住。
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+
+#include "boot_prof.h"
+
+#define TIMELINE_COLUMNS  40
+
+static int cmd_boot(const struct shell *sh, size_t argc, char **argv)
+{
+    struct boot_step_record rec[BOOT_STEP_COUNT];
+    uint32_t span_us = 1;
+    char bar[TIMELINE_COLUMNS + 1];
+
+    for (int i = 0; i < BOOT_STEP_COUNT; i++) {
+        boot_prof_get(i, &rec[i]);
+        if (rec[i].done) {
+            span_us = MAX(span_us, rec[i].end_us);
+        }
+    }
+
+    shell_print(sh, "%-10s %8s %8s %8s %8s  %s", "步骤", "开始ms", "结束ms", "耗时ms", "休眠ms",
+                "时间线");
+    for (int i = 0; i < BOOT_STEP_COUNT; i++) {
+        if (!rec[i].started) {
+            shell_print(sh, "%-10s %8s", boot_prof_step_name(i), "未开始");
+            continue;
+        }
+        if (!rec[i].done) {
+            shell_print(sh, "%-10s %8u %8s", boot_prof_step_name(i), rec[i].start_us / 1000,
+                        "进行中");
+            continue;
+        }
+
+        uint32_t from = (uint64_t)rec[i].start_us * TIMELINE_COLUMNS / span_us;
+        uint32_t to = (uint64_t)rec[i].end_us * TIMELINE_COLUMNS / span_us;
+
+        for (uint32_t c = 0; c < TIMELINE_COLUMNS; c++) {
+            bar[c] = (c >= from && c <= to) ? '#' : '.';
+        }
+        bar[TIMELINE_COLUMNS] = '\0';
+
+        shell_print(sh, "%-10s %8u %8u %8u %8u  %s%s", boot_prof_step_name(i),
+                    rec[i].start_us / 1000, rec[i].end_us / 1000,
+                    (rec[i].end_us - rec[i].start_us) / 1000, rec[i].sleep_us / 1000, bar,
+                    (rec[i].result == 0) ? "" : "  (失败)");
+    }
+
+    if (rec[BOOT_STEP_BOOT_FRAME].done && rec[BOOT_STEP_BOOT_FRAME].result == 0) {
+        shell_print(sh, "开机画面: 开机后 %u ms", rec[BOOT_STEP_BOOT_FRAME].end_us / 1000);
+    }
+    if (rec[BOOT_STEP_DASHBOARD].done) {
+        shell_print(sh, "首帧显示: 开机后 %u ms", rec[BOOT_STEP_DASHBOARD].end_us / 1000);
+    }
+    return 0;
+}
+
+SHELL_CMD_REGISTER(boot, NULL, "开机各初始化步骤的时间线", cmd_boot);
@@ -0,0 +1,499 @@
+/*
+ * application/src/dashboard.c
+ * Pandora 仪表盘界面：控件构建、全屏/小球交互、数值更新、热启动旧值
+ *
+ * 只依赖 LVGL 和数据中心，不直接访问屏幕和传感器队列：
+ * 显示线程 (display_thread.c) 把实时数据交给 ui_apply_*()，
+ * ui_bench 用同一份代码在离屏显示上测量界面开销。
+ */
+
+#include <zephyr/kernel.h>
+#include <lvgl.h>
+
+#include "data_center.h"
+#include "dashboard.h"
+#include "asset_store.h"
+#include "glyph_cache.h"
+
+/* ---------------- 配置参数 ---------------- */
+/*
+ * 圆环中的数值使用资源包 (font_partition，XIP 直接读取) 中的字体，不占内部 Flash；
+ * 没有资源包或包中没有该字体时沿用屏幕的默认字体。
+ * 烧录或更换资源包后用 bootframe erase 让开机画面按新字体重新采集。
+ */
+#define DASHBOARD_VALUE_FONT  "dash_value"
+
+/* 全局对象句柄 */
+static lv_obj_t * meter_temp;    // 温度表圆环
+static lv_obj_t * meter_humi;    // 湿度表圆环
+static lv_obj_t * label_temp_val; // 温度数值文字句柄
+static lv_obj_t * label_humi_val; // 湿度数值文字句柄
+
+static lv_obj_t * label_accel;   // IMU文字
+static lv_obj_t * label_lux;     // 光照文字
+static lv_obj_t * chart_light;   // 光照图表
+static lv_chart_series_t * ser_lux; 
+
+/* --- 新增：小球模式变量 --- */
+static lv_obj_t *imu_ball = NULL;    // 小球对象句柄
+static atomic_t is_ball_active;      // 标记是否处于加速度计小球模拟模式 (IMU 线程也会读取)
+static lv_obj_t *imu_cont_global;    // 记录 IMU 容器句柄，方便定时器识别
+/* 用于平滑移动的影子坐标 */
+static float ball_current_x = 110.0f;
+static float ball_current_y = 110.0f;
+
+// 缓存数据
+static uint16_t cached_lux = 0;
+static float cached_temp = 0.0f;
+static float cached_humi = 0.0f;
+
+/* 热启动：上次运行的旧值用灰色显示，收到实时数据后恢复正常颜色 */
+#define UI_WARM_CHANNELS (DC_EVT_ENV | DC_EVT_LUX)
+static uint8_t ui_stale;   // 正在以旧值显示的通道 (DC_EVT_*)
+static uint8_t ui_fresh;   // 已收到实时数据的通道
+static bool ui_warm_hold;  // 开机画面采集完成前不显示旧值
+
+static bool is_full_screen = false;  // 记录当前是否处于全屏状态
+static lv_point_t old_pos;           // 记录对象的原始位置
+static lv_area_t old_size;           // 记录对象的原始尺寸
+
+/**
+ * @brief 创建仪表盘辅助函数
+ * @param label_store: 一个指向 lv_obj_t* 的指针，用来把内部创建的 label 句柄传出去
+ */
+static lv_obj_t* create_sensor_meter(lv_obj_t* parent, const char* title, const char* unit, 
+                                     int x, int y, lv_color_t color, lv_obj_t ** label_store) {
+    // 1. 创建圆环
+    lv_obj_t* arc = lv_arc_create(parent);
+    lv_obj_set_size(arc, 70, 70); 
+    lv_obj_align(arc, LV_ALIGN_TOP_LEFT, x, y);
+    lv_arc_set_rotation(arc, 135);
+    lv_arc_set_bg_angles(arc, 0, 270);
+    lv_arc_set_value(arc, 0);
+    lv_obj_remove_style(arc, NULL, LV_PART_KNOB); // 移除旋钮
+    lv_obj_set_style_arc_color(arc, color, LV_PART_INDICATOR);
+    
+    // 2. 创建中间的数值 Label
+    lv_obj_t* val_label = lv_label_create(arc);
+    lv_obj_center(val_label);
+    lv_label_set_text(val_label, "0"); // 初始值
+    lv_obj_set_style_text_color(val_label, lv_color_white(), 0);
+
+    const lv_font_t *value_font = asset_font_get(DASHBOARD_VALUE_FONT);
+
+    if (value_font != NULL) {
+        lv_obj_set_style_text_font(val_label, value_font, 0);
+    }
+    
+    // 【关键】将这个 label 的句柄赋值给传入的指针，这样外部就能控制它了
+    if (label_store != NULL) {
+        *label_store = val_label;
+    }
+
+    // 3. 创建底部的标题 Label
+    lv_obj_t* title_label = lv_label_create(parent);
+    lv_label_set_text_fmt(title_label, "%s %s", title, unit);
+    lv_obj_align_to(title_label, arc, LV_ALIGN_OUT_BOTTOM_MID, 0, 5);
+    lv_obj_set_style_text_color(title_label, lv_palette_main(LV_PALETTE_GREY), 0);
+    
+    return arc;
+}
+
+/**
+ * @brief 隐藏/显示屏幕上除当前对象外的所有内容
+ */
+static void set_main_ui_visible(lv_obj_t * current_obj, bool visible) {
+    lv_obj_t * screen = lv_scr_act();
+    uint32_t child_cnt = lv_obj_get_child_cnt(screen);
+    
+    for(uint32_t i = 0; i < child_cnt; i++) {
+        lv_obj_t * child = lv_obj_get_child(screen, i);
+        // 关键：不要隐藏正在放大的那个对象，也不要隐藏背景/顶层
+        if (child != current_obj) {
+            if(visible) 
+                lv_obj_clear_flag(child, LV_OBJ_FLAG_HIDDEN);
+            else 
+                lv_obj_add_flag(child, LV_OBJ_FLAG_HIDDEN);
+        }
+    }
+}
+
+/**
+ * @brief 通用传感器对象交互处理器
+ * 支持：颜色焦点提示、全屏放大、全屏缩小、自动隐藏干扰元素
+ */
+static void sensor_common_event_handler(lv_event_t * e)
+{
+    lv_obj_t * obj = lv_event_get_target(e);
+    lv_event_code_t code = lv_event_get_code(e);
+
+    /* 1. 焦点视觉反馈 (保持原样) */
+    if (!is_full_screen) {
+        if (code == LV_EVENT_FOCUSED) {
+            lv_obj_set_style_outline_width(obj, 0, LV_STATE_FOCUS_KEY);
+            // 这里判断是否是 IMU 容器（它不是 arc，所以逻辑略有不同）
+            if(lv_obj_check_type(obj, &lv_arc_class)) {
+                lv_obj_set_style_arc_color(obj, lv_palette_main(LV_PALETTE_BLUE), LV_PART_INDICATOR);
+            } else {
+                lv_obj_set_style_border_color(obj, lv_palette_main(LV_PALETTE_BLUE), 0);
+            }
+        } else if (code == LV_EVENT_DEFOCUSED) {
+            if(lv_obj_check_type(obj, &lv_arc_class)) {
+                lv_obj_set_style_arc_color(obj, lv_palette_lighten(LV_PALETTE_GREY, 1), LV_PART_INDICATOR);
+            } else {
+                lv_obj_set_style_border_color(obj, lv_color_hex(0x00AEEF), 0);
+            }
+        }
+    }
+
+    /* 2. 按键交互逻辑 */
+    if (code == LV_EVENT_KEY) {
+        uint32_t key = lv_event_get_key(e);
+
+        // --- 【ENTER】: 进入全屏/小球模式 ---
+        if (key == LV_KEY_ENTER && !is_full_screen) {
+            is_full_screen = true;
+
+            // 停止可能存在的残留动画
+            lv_anim_del(obj, NULL);
+
+            // 核心：在改变任何属性前，精准记录原始位置和尺寸
+            old_pos.x = lv_obj_get_x(obj);
+            old_pos.y = lv_obj_get_y(obj);
+            old_size.x1 = lv_obj_get_width(obj);
+            old_size.y1 = lv_obj_get_height(obj);
+
+            set_main_ui_visible(obj, false);
+            lv_obj_move_foreground(obj); // 将容器移到最前
+            
+            // 1. 先设置容器为全屏黑色背景
+            lv_obj_set_size(obj, 240, 240);
+            lv_obj_set_pos(obj, 0, 0);
+            lv_obj_set_style_bg_color(obj, lv_color_hex(0x000000), 0);
+            lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+
+            // 2. 如果是 IMU 容器，处理小球
+            if (obj == imu_cont_global) {
+                atomic_set(&is_ball_active, 1);
+                lv_obj_add_flag(label_accel, LV_OBJ_FLAG_HIDDEN);
+                
+                if (imu_ball == NULL) {
+                    imu_ball = lv_obj_create(obj);
+                    lv_obj_set_size(imu_ball, 20, 20);
+                    lv_obj_set_style_radius(imu_ball, LV_RADIUS_CIRCLE, 0);
+                    lv_obj_set_style_bg_color(imu_ball, lv_palette_main(LV_PALETTE_RED), 0);
+                    lv_obj_set_style_shadow_width(imu_ball, 15, 0);
+                    lv_obj_set_style_shadow_color(imu_ball, lv_palette_main(LV_PALETTE_RED), 0);
+                }
+                
+                // 【核心修复】：显式清除隐藏标志并将其移至子对象的最前端
+                lv_obj_clear_flag(imu_ball, LV_OBJ_FLAG_HIDDEN);
+                lv_obj_move_foreground(imu_ball); // 确保小球在黑色背景之上
+                lv_obj_set_pos(imu_ball, 110, 110); 
+            }
+            
+            // 执行淡入动画
+            lv_obj_set_style_opa(obj, LV_OPA_TRANSP, 0);
+            lv_anim_t a;
+            lv_anim_init(&a);
+            lv_anim_set_var(&a, obj);
+            lv_anim_set_time(&a, 200);
+            lv_anim_set_exec_cb(&a, (lv_anim_exec_xcb_t)lv_obj_set_style_opa);
+            lv_anim_set_values(&a, LV_OPA_TRANSP, LV_OPA_COVER);
+            lv_anim_start(&a);
+        } 
+
+        // --- 【ESC】: 退出全屏/还原数值模式 ---
+        else if (key == LV_KEY_ESC && is_full_screen) {
+            is_full_screen = false;
+
+            // 彻底停止所有动画和属性修改
+            lv_anim_del(obj, NULL);
+
+            /* --- 关键修复：强制重置对齐方式为左上角 --- */
+            /* 这样 old_pos.x 和 old_pos.y 的绝对像素值才会生效 */
+            lv_obj_set_align(obj, LV_ALIGN_TOP_LEFT);
+            
+            if (obj == imu_cont_global) {
+                atomic_set(&is_ball_active, 0);
+                lv_obj_add_flag(imu_ball, LV_OBJ_FLAG_HIDDEN);    // 隐藏小球
+                lv_obj_clear_flag(label_accel, LV_OBJ_FLAG_HIDDEN); // 恢复文字显示
+            }
+
+            // 1. 暴力清除进入时设置的本地属性（这一步最重要，防止样式污染坐标计算）
+            lv_obj_remove_local_style_prop(obj, LV_STYLE_BG_OPA, 0);
+            lv_obj_remove_local_style_prop(obj, LV_STYLE_BG_COLOR, 0);
+            lv_obj_remove_local_style_prop(obj, LV_STYLE_OPA, 0);
+
+            // 2. 严格还原：先还原尺寸，再还原坐标
+            lv_obj_set_size(obj, (int32_t)old_size.x1, (int32_t)old_size.y1);
+            lv_obj_set_pos(obj, old_pos.x, old_pos.y);
+            
+            // 3. 显式设回主界面半透明/透明样式
+            lv_obj_set_style_bg_opa(obj, LV_OPA_TRANSP, 0);
+            set_main_ui_visible(obj, true);
+
+            // 4. 强制通知 LVGL 整个屏幕已经“脏了”，需要重新刷新全部像素
+            lv_obj_invalidate(lv_scr_act());
+        }
+    }
+}
+
+/**
+ * @brief 初始化 UI 布局
+ */
+void setup_pandora_dashboard(void) {
+    // 背景
+    lv_obj_set_style_bg_color(lv_scr_act(), lv_color_hex(0x001529), 0);
+    // 文字经过字形缓存：数值标签每次刷新只拷贝缓存好的位图
+    lv_obj_set_style_text_font(lv_scr_act(), glyph_cache_wrap(lv_font_get_default()), 0);
+
+    // --- 左侧：温度表 ---
+    // 传入 &label_temp_val，让我们可以控制中间的数字
+    meter_temp = create_sensor_meter(lv_scr_act(), "Temp", "C", 15, 25, 
+                                     lv_palette_main(LV_PALETTE_ORANGE), &label_temp_val);
+    lv_arc_set_range(meter_temp, -10, 50);
+
+    // --- 左侧：湿度表 ---
+    // 传入 &label_humi_val
+    meter_humi = create_sensor_meter(lv_scr_act(), "Humi", "%", 15, 125, 
+                                     lv_palette_main(LV_PALETTE_CYAN), &label_humi_val);
+    lv_arc_set_range(meter_humi, 0, 100);
+
+
+    // --- 右上角：IMU 数据 ---
+    lv_obj_t* imu_cont = lv_obj_create(lv_scr_act());
+    imu_cont_global = imu_cont; // 保存到全局变量
+    lv_obj_set_size(imu_cont, 120, 100);
+    lv_obj_align(imu_cont, LV_ALIGN_TOP_RIGHT, -10, 25);
+    lv_obj_set_style_bg_opa(imu_cont, LV_OPA_20, 0); 
+    lv_obj_set_style_border_color(imu_cont, lv_color_hex(0x00AEEF), 0);
+    lv_obj_set_style_radius(imu_cont, 8, 0);
+
+    label_accel = lv_label_create(imu_cont);
+    lv_label_set_text(label_accel, "IMU Data:\nWaiting...");
+    lv_obj_set_style_text_color(label_accel, lv_color_white(), 0);
+#ifdef CONFIG_LV_FONT_MONTSERRAT_12
+    lv_obj_set_style_text_font(label_accel, glyph_cache_wrap(&lv_font_montserrat_12), 0);
+#endif
+
+    // --- 右下角：光照图表 (布局修复核心) ---
+    chart_light = lv_chart_create(lv_scr_act());
+    // 1. 宽度改小：从 210 改为 110，留出左边给湿度表
+    // 2. 高度微调：设为 60
+    lv_obj_set_size(chart_light, 110, 60);
+    // 3. 对齐方式：改为右下角 (BOTTOM_RIGHT)
+    lv_obj_align(chart_light, LV_ALIGN_BOTTOM_RIGHT, -10, -10);
+    
+    lv_chart_set_type(chart_light, LV_CHART_TYPE_LINE);
+    lv_obj_set_style_bg_opa(chart_light, LV_OPA_TRANSP, 0);
+    lv_obj_set_style_border_width(chart_light, 0, 0);
+    
+    // 设置Y轴范围 (0-500 Lux)
+    lv_chart_set_range(chart_light, LV_CHART_AXIS_PRIMARY_Y, 0, 500);
+    // 设置线条颜色
+    ser_lux = lv_chart_add_series(chart_light, lv_color_hex(0xFFFF00), LV_CHART_AXIS_PRIMARY_Y);
+
+    // --- 顶部：光照数值 ---
+    label_lux = lv_label_create(lv_scr_act());
+    lv_obj_align(label_lux, LV_ALIGN_TOP_MID, 0, 5);
+    lv_obj_set_style_text_color(label_lux, lv_color_hex(0xFFFF00), 0);
+    lv_label_set_text(label_lux, "Lux: 0");
+
+    /* --- 将四个对象加入 Group 并绑定事件 --- */
+    lv_obj_t * objs[] = {meter_temp, meter_humi, imu_cont, chart_light};
+    
+    for(int i = 0; i < 4; i++) {
+        lv_obj_add_flag(objs[i], LV_OBJ_FLAG_CLICKABLE);
+        lv_group_add_obj(lv_group_get_default(), objs[i]);
+        lv_obj_add_event_cb(objs[i], sensor_common_event_handler, LV_EVENT_ALL, NULL);
+        // 初始状态全部设为灰色（代表未选中）
+        lv_obj_set_style_arc_color(objs[i], lv_palette_lighten(LV_PALETTE_GREY, 1), LV_PART_INDICATOR);
+        
+        // 彻底取消每个对象的默认方框
+        lv_obj_set_style_outline_width(objs[i], 0, LV_STATE_FOCUS_KEY);
+        lv_obj_set_style_border_width(objs[i], 0, LV_STATE_FOCUS_KEY);
+    }
+
+    /* 默认聚焦在第一个圆环 */
+    lv_group_focus_obj(meter_temp);
+
+    /* 首帧就显示上次运行的数值 (若有)，而不是 0 */
+    ui_show_warm_start();
+}
+
+/**
+ * @brief 显示数据中心恢复出的旧值 (stale)，只处理还没有实时数据、也还没显示过旧值的通道
+ */
+void ui_show_warm_start(void)
+{
+    system_data_t snap;
+    uint8_t todo;
+
+    if (ui_warm_hold) {
+        return;
+    }
+    data_center_get_snapshot(&snap);
+    todo = snap.stale & UI_WARM_CHANNELS & ~(ui_stale | ui_fresh);
+
+    if (todo & DC_EVT_ENV) {
+        cached_temp = snap.env.temperature;
+        cached_humi = snap.env.humidity;
+        lv_arc_set_value(meter_temp, (int)cached_temp);
+        lv_arc_set_value(meter_humi, (int)cached_humi);
+        lv_label_set_text_fmt(label_temp_val, "%d", (int)cached_temp);
+        lv_label_set_text_fmt(label_humi_val, "%d", (int)cached_humi);
+        lv_obj_set_style_text_color(label_temp_val, lv_palette_main(LV_PALETTE_GREY), 0);
+        lv_obj_set_style_text_color(label_humi_val, lv_palette_main(LV_PALETTE_GREY), 0);
+    }
+    if (todo & DC_EVT_LUX) {
+        cached_lux = snap.lux;
+        lv_label_set_text_fmt(label_lux, "Lux: %d", cached_lux);
+        lv_obj_set_style_text_color(label_lux, lv_palette_main(LV_PALETTE_GREY), 0);
+    }
+    ui_stale |= todo;
+}
+
+/**
+ * @brief 删除活动屏幕上的仪表盘 (离屏基准测试前释放 LVGL 堆)，全屏/小球模式一并复位
+ */
+void ui_clear_dashboard(void)
+{
+    lv_obj_clean(lv_screen_active());
+    imu_ball = NULL;
+    atomic_set(&is_ball_active, 0);
+    is_full_screen = false;
+    ball_current_x = 110.0f;
+    ball_current_y = 110.0f;
+}
+
+/**
+ * @brief 重建仪表盘后按数据中心的当前值填充数值 (光照曲线从空开始)
+ */
+void ui_restore_values(void)
+{
+    system_data_t snap;
+
+    data_center_get_snapshot(&snap);
+    ui_stale = 0;
+    ui_fresh = 0;
+    if (snap.fresh & DC_EVT_ENV) {
+        ui_apply_env(&snap.env);
+    }
+    if (snap.fresh & DC_EVT_LUX) {
+        ui_apply_lux(snap.lux);
+    }
+    if (snap.fresh & DC_EVT_IMU) {
+        ui_apply_imu(&snap.imu_accel_gyro);
+    }
+    ui_show_warm_start();
+}
+
+/**
+ * @brief 显示一个光照采样 (数值、曲线)
+ */
+void ui_apply_lux(uint16_t lux)
+{
+    cached_lux = lux;
+    if (ui_stale & DC_EVT_LUX) {
+        lv_obj_set_style_text_color(label_lux, lv_color_hex(0xFFFF00), 0);
+    }
+    ui_stale &= ~DC_EVT_LUX;
+    ui_fresh |= DC_EVT_LUX;
+    
+    lv_chart_set_next_value(chart_light, ser_lux, cached_lux);
+    lv_label_set_text_fmt(label_lux, "Lux: %d", cached_lux);
+}
+
+/**
+ * @brief 显示一组温湿度
+ */
+void ui_apply_env(const aht10_data_t *env)
+{
+    cached_temp = env->temperature;
+    cached_humi = env->humidity;
+    if (ui_stale & DC_EVT_ENV) {
+        lv_obj_set_style_text_color(label_temp_val, lv_color_white(), 0);
+        lv_obj_set_style_text_color(label_humi_val, lv_color_white(), 0);
+    }
+    ui_stale &= ~DC_EVT_ENV;
+    ui_fresh |= DC_EVT_ENV;
+
+    // A. 更新进度条 (圆环)
+    lv_arc_set_value(meter_temp, (int)cached_temp);
+    lv_arc_set_value(meter_humi, (int)cached_humi);
+
+    // B. 【新增】更新中间的文字数值
+    // 之前这里漏掉了，所以一直显示初始的 "0"
+    lv_label_set_text_fmt(label_temp_val, "%d", (int)cached_temp);
+    lv_label_set_text_fmt(label_humi_val, "%d", (int)cached_humi);
+}
+
+/**
+ * @brief 显示一个 IMU 采样 (数值模式或小球模式)
+ */
+void ui_apply_imu(const icm20608_data_t *imu)
+{
+    if (atomic_get(&is_ball_active) && imu_ball) {
+        /* * 小球物理映射算法修复：
+         * 1. 屏幕中心是 (120, 120)。
+         * 2. 小球大小是 20x20，所以小球中心对准屏幕中心时，其左上角坐标应为 (110, 110)。
+         * 3. 加速度计 X 轴对应屏幕 Y 轴，Y 轴对应屏幕 X 轴（取决于你的安装方向）。
+         */
+        
+        // 1. 设定灵敏度和滤波系数
+        const float sensitivity = 100.0f; 
+        // 滤波系数(0.0~1.0)，越小越平滑。每个 20ms 采样都会处理 (原来每 100ms 取一个样本、系数 0.15)，
+        // 按采样率折算为 0.03，平滑时间常数不变
+        const float filter_gain = 0.03f;
+
+        // 2. 计算目标位置 (针对你的板子映射：accel_x->x, accel_y->y)
+        // 如果方向反了，请在 imu 前加负号
+        float target_x = 110.0f + (imu->accel_x * sensitivity);
+        float target_y = 110.0f - (imu->accel_y * sensitivity);
+
+        // 3. 一阶滤波：让当前位置向目标位置“平滑靠拢”
+        ball_current_x = (ball_current_x * (1.0f - filter_gain)) + (target_x * filter_gain);
+        ball_current_y = (ball_current_y * (1.0f - filter_gain)) + (target_y * filter_gain);
+
+        // 4. 边界检查
+        if(ball_current_x < 0) ball_current_x = 0;
+        if(ball_current_x > 220) ball_current_x = 220;
+        if(ball_current_y < 0) ball_current_y = 0;
+        if(ball_current_y > 220) ball_current_y = 220;
+
+        // 5. 应用坐标 (转换为整数)
+        lv_obj_set_pos(imu_ball, (int16_t)ball_current_x, (int16_t)ball_current_y);
+    } 
+    else {
+        /* 标准数值模式 (重置平滑坐标为中心，防止下次进入时闪现) */
+        ball_current_x = 110.0f;
+        ball_current_y = 110.0f;
+
+        lv_label_set_text_fmt(label_accel, 
+            "IMU Data:\nAX: %.2f\nAY: %.2f\nAZ: %.2f\nTemp: %.1f", 
+            (double)imu->accel_x, (double)imu->accel_y, (double)imu->accel_z,
+            (double)imu->temp);
+
+        if (imu->accel_z < 0.5f) {
+            lv_obj_set_style_border_color(imu_cont_global, lv_palette_main(LV_PALETTE_RED), 0);
+        } else {
+            lv_obj_set_style_border_color(imu_cont_global, lv_color_hex(0x00AEEF), 0);
+        }
+    }
+}
+
+void ui_set_warm_hold(bool hold)
+{
+    ui_warm_hold = hold;
+}
+
+bool ui_warm_pending(void)
+{
+    return (ui_fresh | ui_stale) != UI_WARM_CHANNELS;
+}
+
+bool ui_imu_ball_active(void)
+{
+    return atomic_get(&is_ball_active) != 0;
+}
@@ -8,24 +8,50 @@
 #include <zephyr/drivers/display.h>
 #include <zephyr/drivers/gpio.h>
 #include <zephyr/drivers/pwm.h>
+#include <zephyr/input/input.h>
 #include <lvgl.h>
+#include <lvgl_zephyr.h>
 #include <stdio.h>
+#include <string.h>
 #include <zephyr/logging/log.h>
 
 /* 引入传感器头文件 */
 #include "aht10.h"
 #include "ap3216c.h"
 #include "icm20608.h"
+#include "boot_prof.h"
+#include "boot_frame.h"
+#include "asset_store.h"
+#include "lcd_flush.h"
+#include "roll_plot.h"
+#include "auto_rotate.h"
+#include "display_thread.h"
+#include "key_input.h"
+#include "dashboard.h"
+#include "ui_bench.h"
 
 LOG_MODULE_REGISTER(Display_TASK, LOG_LEVEL_INF);
 
+/* ---------------- 配置参数 ---------------- */
+#define DISPLAY_MAX_SLEEP_MS  1000   // 没有 LVGL 定时器到期时的最长睡眠 (滚动图模式等)
+#define DISPLAY_IMU_PERIOD_MS 100    // IMU 数值的刷新间隔 (10 Hz)，小球模式不限
+
+/* 唤醒事件 (DISPLAY_EVT_*)，以及传感器/按键到达的时刻 (0 表示没有待上屏的变化) */
+#define DISPLAY_EVT_ALL  (DISPLAY_EVT_SENSOR | DISPLAY_EVT_INPUT | DISPLAY_EVT_CMD)
+static K_EVENT_DEFINE(display_events);
+static atomic_t wake_stamp_sensor;
+static atomic_t wake_stamp_input;
+
+static struct k_spinlock loop_lock;
+static struct display_loop_stats loop_stats;
+static int64_t loop_stats_since;
+
 static const struct device *dev = DEVICE_DT_GET(DT_CHOSEN(zephyr_display));
 
-/* --- 按键硬件定义 --- */
-static const struct gpio_dt_spec btn_up    = GPIO_DT_SPEC_GET(DT_ALIAS(sw_up), gpios);
-static const struct gpio_dt_spec btn_down  = GPIO_DT_SPEC_GET(DT_ALIAS(sw_down), gpios);
-static const struct gpio_dt_spec btn_left  = GPIO_DT_SPEC_GET(DT_ALIAS(sw_left), gpios);
-static const struct gpio_dt_spec btn_right = GPIO_DT_SPEC_GET(DT_ALIAS(sw_right), gpios);
+/* 按键输入设备 (事件模式，由 key_input 队列驱动) 及最后一次交给 LVGL 的按键状态 */
+static lv_indev_t * keypad_indev;
+static uint32_t keypad_key;
+static lv_indev_state_t keypad_state = LV_INDEV_STATE_REL;
 
 /* 全局输入组句柄 */
 static lv_group_t * input_group;
@@ -89,334 +115,76 @@ int backlight_init(void)
 }
 
 /* -------------------------------------------------------------------------- */
-/* UI 逻辑层                                     */
+/* 按键输入与数据分发 (界面本身见 dashboard.c)                                   */
 /* -------------------------------------------------------------------------- */
 
-/* 全局对象句柄 */
-static lv_obj_t * meter_temp;    // 温度表圆环
-static lv_obj_t * meter_humi;    // 湿度表圆环
-static lv_obj_t * label_temp_val; // 温度数值文字句柄
-static lv_obj_t * label_humi_val; // 湿度数值文字句柄
-
-static lv_obj_t * label_accel;   // IMU文字
-static lv_obj_t * label_lux;     // 光照文字
-static lv_obj_t * chart_light;   // 光照图表
-static lv_chart_series_t * ser_lux; 
-
-/* --- 新增：小球模式变量 --- */
-static lv_obj_t *imu_ball = NULL;    // 小球对象句柄
-static bool is_ball_active = false;  // 标记是否处于加速度计小球模拟模式
-static lv_obj_t *imu_cont_global;    // 记录 IMU 容器句柄，方便定时器识别
-/* 用于平滑移动的影子坐标 */
-static float ball_current_x = 110.0f;
-static float ball_current_y = 110.0f;
-
-// 缓存数据
-static uint16_t cached_lux = 0;
-static float cached_temp = 0.0f;
-static float cached_humi = 0.0f;
-
-static bool is_full_screen = false;  // 记录当前是否处于全屏状态
-static lv_point_t old_pos;           // 记录对象的原始位置
-static lv_area_t old_size;           // 记录对象的原始尺寸
-
-/**
- * @brief 创建仪表盘辅助函数
- * @param label_store: 一个指向 lv_obj_t* 的指针，用来把内部创建的 label 句柄传出去
- */
-static lv_obj_t* create_sensor_meter(lv_obj_t* parent, const char* title, const char* unit, 
-                                     int x, int y, lv_color_t color, lv_obj_t ** label_store) {
-    // 1. 创建圆环
-    lv_obj_t* arc = lv_arc_create(parent);
-    lv_obj_set_size(arc, 70, 70); 
-    lv_obj_align(arc, LV_ALIGN_TOP_LEFT, x, y);
-    lv_arc_set_rotation(arc, 135);
-    lv_arc_set_bg_angles(arc, 0, 270);
-    lv_arc_set_value(arc, 0);
-    lv_obj_remove_style(arc, NULL, LV_PART_KNOB); // 移除旋钮
-    lv_obj_set_style_arc_color(arc, color, LV_PART_INDICATOR);
-    
-    // 2. 创建中间的数值 Label
-    lv_obj_t* val_label = lv_label_create(arc);
-    lv_obj_center(val_label);
-    lv_label_set_text(val_label, "0"); // 初始值
-    lv_obj_set_style_text_color(val_label, lv_color_white(), 0);
-    
-    // 【关键】将这个 label 的句柄赋值给传入的指针，这样外部就能控制它了
-    if (label_store != NULL) {
-        *label_store = val_label;
-    }
-
-    // 3. 创建底部的标题 Label
-    lv_obj_t* title_label = lv_label_create(parent);
-    lv_label_set_text_fmt(title_label, "%s %s", title, unit);
-    lv_obj_align_to(title_label, arc, LV_ALIGN_OUT_BOTTOM_MID, 0, 5);
-    lv_obj_set_style_text_color(title_label, lv_palette_main(LV_PALETTE_GREY), 0);
-    
-    return arc;
-}
-
-/**
- * @brief 隐藏/显示屏幕上除当前对象外的所有内容
- */
-static void set_main_ui_visible(lv_obj_t * current_obj, bool visible) {
-    lv_obj_t * screen = lv_scr_act();
-    uint32_t child_cnt = lv_obj_get_child_cnt(screen);
-    
-    for(uint32_t i = 0; i < child_cnt; i++) {
-        lv_obj_t * child = lv_obj_get_child(screen, i);
-        // 关键：不要隐藏正在放大的那个对象，也不要隐藏背景/顶层
-        if (child != current_obj) {
-            if(visible) 
-                lv_obj_clear_flag(child, LV_OBJ_FLAG_HIDDEN);
-            else 
-                lv_obj_add_flag(child, LV_OBJ_FLAG_HIDDEN);
-        }
+/* 摇杆按键 (INPUT_KEY_*) 到 LVGL 按键：下=确认, 上=返回, 左=上一个, 右=下一个 */
+static uint32_t keypad_map(uint16_t code)
+{
+    switch (code) {
+    case INPUT_KEY_DOWN:  return LV_KEY_ENTER;
+    case INPUT_KEY_UP:    return LV_KEY_ESC;
+    case INPUT_KEY_LEFT:  return LV_KEY_PREV;
+    case INPUT_KEY_RIGHT: return LV_KEY_NEXT;
+    default:              return 0;
     }
 }
 
 /**
- * @brief 通用传感器对象交互处理器
- * 支持：颜色焦点提示、全屏放大、全屏缩小、自动隐藏干扰元素
+ * @brief LVGL 键盘读取回调函数：从 key_input 队列取事件，不读 GPIO
  */
-static void sensor_common_event_handler(lv_event_t * e)
+static void keypad_read_cb(lv_indev_t * indev, lv_indev_data_t * data)
 {
-    lv_obj_t * obj = lv_event_get_target(e);
-    lv_event_code_t code = lv_event_get_code(e);
-
-    /* 1. 焦点视觉反馈 (保持原样) */
-    if (!is_full_screen) {
-        if (code == LV_EVENT_FOCUSED) {
-            lv_obj_set_style_outline_width(obj, 0, LV_STATE_FOCUS_KEY);
-            // 这里判断是否是 IMU 容器（它不是 arc，所以逻辑略有不同）
-            if(lv_obj_check_type(obj, &lv_arc_class)) {
-                lv_obj_set_style_arc_color(obj, lv_palette_main(LV_PALETTE_BLUE), LV_PART_INDICATOR);
-            } else {
-                lv_obj_set_style_border_color(obj, lv_palette_main(LV_PALETTE_BLUE), 0);
-            }
-        } else if (code == LV_EVENT_DEFOCUSED) {
-            if(lv_obj_check_type(obj, &lv_arc_class)) {
-                lv_obj_set_style_arc_color(obj, lv_palette_lighten(LV_PALETTE_GREY, 1), LV_PART_INDICATOR);
-            } else {
-                lv_obj_set_style_border_color(obj, lv_color_hex(0x00AEEF), 0);
-            }
-        }
-    }
+    struct key_event ev;
 
-    /* 2. 按键交互逻辑 */
-    if (code == LV_EVENT_KEY) {
-        uint32_t key = lv_indev_get_key(lv_indev_get_act());
-
-        // --- 【ENTER】: 进入全屏/小球模式 ---
-        if (key == LV_KEY_ENTER && !is_full_screen) {
-            is_full_screen = true;
-
-            // 停止可能存在的残留动画
-            lv_anim_del(obj, NULL);
-
-            // 核心：在改变任何属性前，精准记录原始位置和尺寸
-            old_pos.x = lv_obj_get_x(obj);
-            old_pos.y = lv_obj_get_y(obj);
-            old_size.x1 = lv_obj_get_width(obj);
-            old_size.y1 = lv_obj_get_height(obj);
-
-            set_main_ui_visible(obj, false);
-            lv_obj_move_foreground(obj); // 将容器移到最前
-            
-            // 1. 先设置容器为全屏黑色背景
-            lv_obj_set_size(obj, 240, 240);
-            lv_obj_set_pos(obj, 0, 0);
-            lv_obj_set_style_bg_color(obj, lv_color_hex(0x000000), 0);
-            lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
-
-            // 2. 如果是 IMU 容器，处理小球
-            if (obj == imu_cont_global) {
-                is_ball_active = true;
-                lv_obj_add_flag(label_accel, LV_OBJ_FLAG_HIDDEN);
-                
-                if (imu_ball == NULL) {
-                    imu_ball = lv_obj_create(obj);
-                    lv_obj_set_size(imu_ball, 20, 20);
-                    lv_obj_set_style_radius(imu_ball, LV_RADIUS_CIRCLE, 0);
-                    lv_obj_set_style_bg_color(imu_ball, lv_palette_main(LV_PALETTE_RED), 0);
-                    lv_obj_set_style_shadow_width(imu_ball, 15, 0);
-                    lv_obj_set_style_shadow_color(imu_ball, lv_palette_main(LV_PALETTE_RED), 0);
-                }
-                
-                // 【核心修复】：显式清除隐藏标志并将其移至子对象的最前端
-                lv_obj_clear_flag(imu_ball, LV_OBJ_FLAG_HIDDEN);
-                lv_obj_move_foreground(imu_ball); // 确保小球在黑色背景之上
-                lv_obj_set_pos(imu_ball, 110, 110); 
-            }
-            
-            // 执行淡入动画
-            lv_obj_set_style_opa(obj, LV_OPA_TRANSP, 0);
-            lv_anim_t a;
-            lv_anim_init(&a);
-            lv_anim_set_var(&a, obj);
-            lv_anim_set_time(&a, 200);
-            lv_anim_set_exec_cb(&a, (lv_anim_exec_xcb_t)lv_obj_set_style_opa);
-            lv_anim_set_values(&a, LV_OPA_TRANSP, LV_OPA_COVER);
-            lv_anim_start(&a);
-        } 
-
-        // --- 【ESC】: 退出全屏/还原数值模式 ---
-        else if (key == LV_KEY_ESC && is_full_screen) {
-            is_full_screen = false;
-
-            // 彻底停止所有动画和属性修改
-            lv_anim_del(obj, NULL);
-
-            /* --- 关键修复：强制重置对齐方式为左上角 --- */
-            /* 这样 old_pos.x 和 old_pos.y 的绝对像素值才会生效 */
-            lv_obj_set_align(obj, LV_ALIGN_TOP_LEFT);
-            
-            if (obj == imu_cont_global) {
-                is_ball_active = false;
-                lv_obj_add_flag(imu_ball, LV_OBJ_FLAG_HIDDEN);    // 隐藏小球
-                lv_obj_clear_flag(label_accel, LV_OBJ_FLAG_HIDDEN); // 恢复文字显示
-            }
+    while (key_input_get(&ev) == 0) {
+        uint32_t key = keypad_map(ev.code);
 
-            // 1. 暴力清除进入时设置的本地属性（这一步最重要，防止样式污染坐标计算）
-            lv_obj_remove_local_style_prop(obj, LV_STYLE_BG_OPA, 0);
-            lv_obj_remove_local_style_prop(obj, LV_STYLE_BG_COLOR, 0);
-            lv_obj_remove_local_style_prop(obj, LV_STYLE_OPA, 0);
-
-            // 2. 严格还原：先还原尺寸，再还原坐标
-            lv_obj_set_size(obj, (int32_t)old_size.x1, (int32_t)old_size.y1);
-            lv_obj_set_pos(obj, old_pos.x, old_pos.y);
-            
-            // 3. 显式设回主界面半透明/透明样式
-            lv_obj_set_style_bg_opa(obj, LV_OPA_TRANSP, 0);
-            set_main_ui_visible(obj, true);
-
-            // 4. 强制通知 LVGL 整个屏幕已经“脏了”，需要重新刷新全部像素
-            lv_obj_invalidate(lv_scr_act());
+        if (key == 0) {
+            continue;
         }
-    }
-}
-
-/**
- * @brief 初始化 UI 布局
- */
-void setup_pandora_dashboard(void) {
-    // 背景
-    lv_obj_set_style_bg_color(lv_scr_act(), lv_color_hex(0x001529), 0);
-
-    // --- 左侧：温度表 ---
-    // 传入 &label_temp_val，让我们可以控制中间的数字
-    meter_temp = create_sensor_meter(lv_scr_act(), "Temp", "C", 15, 25, 
-                                     lv_palette_main(LV_PALETTE_ORANGE), &label_temp_val);
-    lv_arc_set_range(meter_temp, -10, 50);
-
-    // --- 左侧：湿度表 ---
-    // 传入 &label_humi_val
-    meter_humi = create_sensor_meter(lv_scr_act(), "Humi", "%", 15, 125, 
-                                     lv_palette_main(LV_PALETTE_CYAN), &label_humi_val);
-    lv_arc_set_range(meter_humi, 0, 100);
-
-
-    // --- 右上角：IMU 数据 ---
-    lv_obj_t* imu_cont = lv_obj_create(lv_scr_act());
-    imu_cont_global = imu_cont; // 保存到全局变量
-    lv_obj_set_size(imu_cont, 120, 100);
-    lv_obj_align(imu_cont, LV_ALIGN_TOP_RIGHT, -10, 25);
-    lv_obj_set_style_bg_opa(imu_cont, LV_OPA_20, 0); 
-    lv_obj_set_style_border_color(imu_cont, lv_color_hex(0x00AEEF), 0);
-    lv_obj_set_style_radius(imu_cont, 8, 0);
-
-    label_accel = lv_label_create(imu_cont);
-    lv_label_set_text(label_accel, "IMU Data:\nWaiting...");
-    lv_obj_set_style_text_color(label_accel, lv_color_white(), 0);
-#ifdef CONFIG_LV_FONT_MONTSERRAT_12
-    lv_obj_set_style_text_font(label_accel, &lv_font_montserrat_12, 0);
-#endif
-
-    // --- 右下角：光照图表 (布局修复核心) ---
-    chart_light = lv_chart_create(lv_scr_act());
-    // 1. 宽度改小：从 210 改为 110，留出左边给湿度表
-    // 2. 高度微调：设为 60
-    lv_obj_set_size(chart_light, 110, 60);
-    // 3. 对齐方式：改为右下角 (BOTTOM_RIGHT)
-    lv_obj_align(chart_light, LV_ALIGN_BOTTOM_RIGHT, -10, -10);
-    
-    lv_chart_set_type(chart_light, LV_CHART_TYPE_LINE);
-    lv_obj_set_style_bg_opa(chart_light, LV_OPA_TRANSP, 0);
-    lv_obj_set_style_border_width(chart_light, 0, 0);
-    
-    // 设置Y轴范围 (0-500 Lux)
-    lv_chart_set_range(chart_light, LV_CHART_AXIS_PRIMARY_Y, 0, 500);
-    // 设置线条颜色
-    ser_lux = lv_chart_add_series(chart_light, lv_color_hex(0xFFFF00), LV_CHART_AXIS_PRIMARY_Y);
-
-    // --- 顶部：光照数值 ---
-    label_lux = lv_label_create(lv_scr_act());
-    lv_obj_align(label_lux, LV_ALIGN_TOP_MID, 0, 5);
-    lv_obj_set_style_text_color(label_lux, lv_color_hex(0xFFFF00), 0);
-    lv_label_set_text(label_lux, "Lux: 0");
-
-    /* --- 将四个对象加入 Group 并绑定事件 --- */
-    lv_obj_t * objs[] = {meter_temp, meter_humi, imu_cont, chart_light};
-    
-    for(int i = 0; i < 4; i++) {
-        lv_obj_add_flag(objs[i], LV_OBJ_FLAG_CLICKABLE);
-        lv_group_add_obj(input_group, objs[i]);
-        lv_obj_add_event_cb(objs[i], sensor_common_event_handler, LV_EVENT_ALL, NULL);
-        // 初始状态全部设为灰色（代表未选中）
-        lv_obj_set_style_arc_color(objs[i], lv_palette_lighten(LV_PALETTE_GREY, 1), LV_PART_INDICATOR);
-        
-        // 彻底取消每个对象的默认方框
-        lv_obj_set_style_outline_width(objs[i], 0, LV_STATE_FOCUS_KEY);
-        lv_obj_set_style_border_width(objs[i], 0, LV_STATE_FOCUS_KEY);
+        LOG_DBG("key %u %s", ev.code, ev.pressed ? "pressed" : "released");
+        keypad_key = key;
+        keypad_state = ev.pressed ? LV_INDEV_STATE_PR : LV_INDEV_STATE_REL;
+        break;
     }
 
-    /* 默认聚焦在第一个圆环 */
-    lv_group_focus_obj(meter_temp);
+    data->key = keypad_key;
+    data->state = keypad_state;
+    /* 一次只交给 LVGL 一个事件，按下和松开都不会被合并掉 */
+    data->continue_reading = key_input_pending();
 }
 
 /**
- * @brief LVGL 键盘读取回调函数
+ * @brief LVGL 暂停期间 (滚动图模式) 丢弃按键事件，恢复后从松开状态开始
  */
-static void keypad_read_cb(lv_indev_t * indev, lv_indev_data_t * data)
+static void keypad_discard(void)
 {
-    data->state = LV_INDEV_STATE_REL; 
-
-    /* 下=确认, 上=返回, 左=上一个, 右=下一个 */
-    if (gpio_pin_get_dt(&btn_down) > 0) {
-        data->state = LV_INDEV_STATE_PR;
-        data->key = LV_KEY_ENTER;
-        LOG_INF("Down Key Pressed!");
-    } else if (gpio_pin_get_dt(&btn_up) > 0) {
-        data->state = LV_INDEV_STATE_PR;
-        data->key = LV_KEY_ESC;
-        LOG_INF("Up Key Pressed!");
-    } else if (gpio_pin_get_dt(&btn_left) > 0) {
-        data->state = LV_INDEV_STATE_PR;
-        data->key = LV_KEY_PREV;
-        LOG_INF("Left Key Pressed!");
-    } else if (gpio_pin_get_dt(&btn_right) > 0) {
-        data->state = LV_INDEV_STATE_PR;
-        data->key = LV_KEY_NEXT;
-        LOG_INF("Right Key Pressed!");
+    struct key_event ev;
+
+    while (key_input_get(&ev) == 0) {
     }
+    keypad_state = LV_INDEV_STATE_REL;
 }
 
 /**
- * @brief 定时器回调：刷新数据
+ * @brief 刷新数据：每次唤醒都取空传感器消息队列 (K_NO_WAIT，队列为空时几乎没有开销)
  */
-static void ui_timer_cb(lv_timer_t * t) {
+static void ui_update(void) {
+
+    /* --- 0. Flash 中的快照在文件系统挂载后才恢复，实时数据到齐前持续检查 --- */
+    if (ui_warm_pending()) {
+        ui_show_warm_start();
+    }
     
     /* --- 1. 光照数据处理 --- */
     uint16_t als_val;
-    if (k_msgq_get(&als_msgq, &als_val, K_NO_WAIT) == 0) {
-        cached_lux = als_val; 
-        
-        lv_chart_set_next_value(chart_light, ser_lux, cached_lux);
-        lv_label_set_text_fmt(label_lux, "Lux: %d", cached_lux);
+    while (k_msgq_get(&als_msgq, &als_val, K_NO_WAIT) == 0) {
+        ui_apply_lux(als_val);
 
         // 背光控制逻辑
         // A. 确定目标亮度（限定在 20-255 之间）
-        float target_bl = (float)cached_lux;
+        float target_bl = (float)als_val;
         if (target_bl > 255.0f) target_bl = 255.0f;
         if (target_bl < 20.0f) target_bl = 20.0f;
 
@@ -429,86 +197,24 @@ static void ui_timer_cb(lv_timer_t * t) {
         backlight_set((uint8_t)current_backlight_f);
     }
 
-    /* --- 2. 温湿度数据处理 (数值显示修复核心) --- */
+    /* --- 2. 温湿度数据处理 --- */
     aht10_data_t sensor_data;
-    if (k_msgq_get(&aht10_msgq, &sensor_data, K_NO_WAIT) == 0) {
-        cached_temp = sensor_data.temperature;
-        cached_humi = sensor_data.humidity;
-
-        // A. 更新进度条 (圆环)
-        lv_arc_set_value(meter_temp, (int)cached_temp);
-        lv_arc_set_value(meter_humi, (int)cached_humi);
-
-        // B. 【新增】更新中间的文字数值
-        // 之前这里漏掉了，所以一直显示初始的 "0"
-        lv_label_set_text_fmt(label_temp_val, "%d", (int)cached_temp);
-        lv_label_set_text_fmt(label_humi_val, "%d", (int)cached_humi);
+    while (k_msgq_get(&aht10_msgq, &sensor_data, K_NO_WAIT) == 0) {
+        ui_apply_env(&sensor_data);
     }
 
-    /* --- 3. IMU 数据占位 --- */
-    // 更新右上角的文字
+    /* --- 3. IMU 数据 --- */
     icm20608_data_t imu_data;
     if (k_msgq_get(&imu_msgq, &imu_data, K_NO_WAIT) == 0) {
-        
-        if (is_ball_active && imu_ball) {
-            /* * 小球物理映射算法修复：
-             * 1. 屏幕中心是 (120, 120)。
-             * 2. 小球大小是 20x20，所以小球中心对准屏幕中心时，其左上角坐标应为 (110, 110)。
-             * 3. 加速度计 X 轴对应屏幕 Y 轴，Y 轴对应屏幕 X 轴（取决于你的安装方向）。
-             */
-            
-            // 1. 设定灵敏度和滤波系数
-            const float sensitivity = 100.0f; 
-            const float filter_gain = 0.15f; // 滤波系数(0.0~1.0)，越小越平滑，0.1~0.2 效果最佳
-
-            // 2. 计算目标位置 (针对你的板子映射：accel_x->x, accel_y->y)
-            // 如果方向反了，请在 imu_data 前加负号
-            float target_x = 110.0f + (imu_data.accel_x * sensitivity);
-            float target_y = 110.0f - (imu_data.accel_y * sensitivity);
-
-            // 3. 一阶滤波：让当前位置向目标位置“平滑靠拢”
-            ball_current_x = (ball_current_x * (1.0f - filter_gain)) + (target_x * filter_gain);
-            ball_current_y = (ball_current_y * (1.0f - filter_gain)) + (target_y * filter_gain);
-
-            // 4. 边界检查
-            if(ball_current_x < 0) ball_current_x = 0;
-            if(ball_current_x > 220) ball_current_x = 220;
-            if(ball_current_y < 0) ball_current_y = 0;
-            if(ball_current_y > 220) ball_current_y = 220;
-
-            // 5. 应用坐标 (转换为整数)
-            lv_obj_set_pos(imu_ball, (int16_t)ball_current_x, (int16_t)ball_current_y);
-        } 
-        else {
-            /* 标准数值模式 (重置平滑坐标为中心，防止下次进入时闪现) */
-            ball_current_x = 110.0f;
-            ball_current_y = 110.0f;
-
-            lv_label_set_text_fmt(label_accel, 
-                "IMU Data:\nAX: %.2f\nAY: %.2f\nAZ: %.2f\nTemp: %.1f", 
-                (double)imu_data.accel_x, (double)imu_data.accel_y, (double)imu_data.accel_z,
-                (double)imu_data.temp);
-
-            if (imu_data.accel_z < 0.5f) {
-                lv_obj_set_style_border_color(imu_cont_global, lv_palette_main(LV_PALETTE_RED), 0);
-            } else {
-                lv_obj_set_style_border_color(imu_cont_global, lv_color_hex(0x00AEEF), 0);
-            }
-        }
+        ui_apply_imu(&imu_data);
     }
 }
 
 /**
- * @brief 初始化按键硬件和 LVGL 输入设备
+ * @brief 初始化 LVGL 输入设备 (按键的中断和消抖由 gpio-keys 驱动负责)
  */
 void input_init(void)
 {
-    /* 初始化 GPIO */
-    gpio_pin_configure_dt(&btn_up, GPIO_INPUT);
-    gpio_pin_configure_dt(&btn_down, GPIO_INPUT);
-    gpio_pin_configure_dt(&btn_left, GPIO_INPUT);
-    gpio_pin_configure_dt(&btn_right, GPIO_INPUT);
-
     /* --- LVGL v9 新版注册方式 --- */
     
     /* 1. 创建一个输入设备对象，类型设为 KEYPAD */
@@ -517,6 +223,9 @@ void input_init(void)
     
     /* 2. 绑定读取回调函数 */
     lv_indev_set_read_cb(indev, keypad_read_cb);
+    /* 事件模式：不创建读取定时器，有按键事件时由显示线程调用 lv_indev_read() */
+    lv_indev_set_mode(indev, LV_INDEV_MODE_EVENT);
+    keypad_indev = indev;
 
     /* 3. 创建并关联组 (Group) */
     input_group = lv_group_create();
@@ -526,33 +235,183 @@ void input_init(void)
 
 void display_thread_entry(void *p1, void *p2, void *p3)
 {
+    int ret;
+
     LOG_INF("Display Thread started");
-    
-    if (!device_is_ready(dev)) {
-        LOG_ERR("Display device not ready!");
+
+    /*
+     * 屏幕节点在设备树中标记了 zephyr,deferred-init，LVGL 也关闭了自动初始化 (LV_Z_AUTO_INIT=n)：
+     * 控制器复位/退出休眠的几百毫秒等待放在本线程里进行，与传感器线程的初始化并行，
+     * 而不是在 POST_KERNEL 阶段串行阻塞所有线程的启动。
+     */
+    boot_prof_begin(BOOT_STEP_DISPLAY);
+    ret = device_init(dev);
+    if (ret == -EALREADY) {
+        ret = 0;
+    }
+    boot_prof_end(BOOT_STEP_DISPLAY, ret);
+    if (ret < 0) {
+        LOG_ERR("Display init failed: %d", ret);
         return;
     }
 
-    display_blanking_off(dev);
-    k_msleep(120);
+    /* LVGL 初始化之前，先把 Flash 中预渲染的开机画面直接推到屏幕上并点亮 */
+    boot_prof_begin(BOOT_STEP_BOOT_FRAME);
+    ret = boot_frame_show(dev);
+    boot_prof_end(BOOT_STEP_BOOT_FRAME, ret);
+    if (ret == 0) {
+        display_blanking_off(dev);
+        backlight_init();
+        backlight_set(100);
+    } else if (ret != -ENOENT) {
+        LOG_WRN("Boot frame invalid: %d", ret);
+    }
 
-    backlight_init();
-    // 开机先亮起来
-    backlight_set(100); 
+    boot_prof_begin(BOOT_STEP_DASHBOARD);
+    ret = lvgl_init();
+    if (ret < 0) {
+        boot_prof_end(BOOT_STEP_DASHBOARD, ret);
+        LOG_ERR("LVGL init failed: %d", ret);
+        return;
+    }
+
+    /* 刷新改为 SPI DMA 后台发送，LVGL 同时渲染另一块绘图缓冲 */
+    ret = lcd_flush_attach(lv_display_get_default(), dev);
+    if (ret < 0) {
+        LOG_WRN("Async flush unavailable (%d), using display_write", ret);
+    }
 
     /* --- 初始化输入设备 --- */
     input_init();
 
+    /* 开机画面需要 (重新) 采集时，首帧先不显示旧值，保存的是不含数值的静态界面 */
+    bool capture = boot_frame_capture_needed(lv_display_get_horizontal_resolution(NULL),
+                                             lv_display_get_vertical_resolution(NULL));
+
+    /* 没有开机画面时屏幕仍处于消隐状态：先渲染完首帧，再打开显示和背光，不需要额外等待 */
+    bool xip = asset_xip_lock_if_mapped();
+
+    ui_set_warm_hold(capture);
     setup_pandora_dashboard();
+    lv_refr_now(NULL);
+    if (xip) {
+        asset_xip_unlock();
+    }
 
-    lv_timer_create(ui_timer_cb, 100, NULL);
+    display_blanking_off(dev);
+    backlight_init();
+    backlight_set(100);
+    boot_prof_end(BOOT_STEP_DASHBOARD, 0);
+
+    if (capture) {
+        ret = boot_frame_capture(lv_display_get_default());
+        if (ret < 0) {
+            LOG_WRN("Boot frame capture failed: %d", ret);
+        }
+        ui_set_warm_hold(false);
+        xip = asset_xip_lock_if_mapped();
+        ui_show_warm_start();
+        if (xip) {
+            asset_xip_unlock();
+        }
+    }
 
     while (1) {
-        lv_task_handler(); 
-        k_msleep(30);      
+        uint32_t sleep_ms = DISPLAY_MAX_SLEEP_MS;
+        uint32_t events;
+        uint32_t sensor_at = (uint32_t)atomic_set(&wake_stamp_sensor, 0);
+        uint32_t input_at = (uint32_t)atomic_set(&wake_stamp_input, 0);
+
+        /* 滚动图模式下屏幕由 roll_plot 直接驱动，LVGL 暂停，只等新的采样 */
+        if (!roll_plot_poll(dev)) {
+            /* 本轮处理的传感器数据/按键登记到下一帧，上屏时统计延迟 */
+            if (sensor_at != 0) {
+                lcd_flush_latency_mark(LCD_LATENCY_SENSOR, sensor_at);
+            }
+            if (input_at != 0) {
+                lcd_flush_latency_mark(LCD_LATENCY_INPUT, input_at);
+            }
+            /* 排版和渲染会读取映射窗口中的字体/图片，只在这一段与 Flash 写入/擦除互斥 */
+            bool xip = asset_xip_lock_if_mapped();
+
+            auto_rotate_poll(dev);
+            if (key_input_pending()) {
+                while (key_input_pending()) {
+                    lv_indev_read(keypad_indev);
+                }
+                /* 按键的反馈不等刷新周期，本轮 lv_timer_handler() 就重绘 */
+                lv_timer_ready(lv_display_get_refr_timer(lv_display_get_default()));
+            }
+            ui_update();
+            /* 返回值是距离下一个 LVGL 定时器 (刷新、输入读取、动画) 到期的毫秒数 */
+            uint32_t next = lv_timer_handler();
+
+            if (xip) {
+                asset_xip_unlock();
+            }
+            sleep_ms = MIN(next, DISPLAY_MAX_SLEEP_MS);   // 没有定时器时返回 LV_NO_TIMER_READY
+            /* 测试耗时较长，在锁外运行，由测试自己逐帧加锁 */
+            lcd_flush_poll();
+            ui_bench_poll();
+        } else {
+            keypad_discard();
+        }
+
+        events = k_event_wait(&display_events, DISPLAY_EVT_ALL, false, K_MSEC(sleep_ms));
+        // 与 data_center_wait() 相同：原子地取走并清除当前置位的事件，两步之间的唤醒不会丢
+        if (events != 0) {
+            events = k_event_clear(&display_events, DISPLAY_EVT_ALL) & DISPLAY_EVT_ALL;
+        }
+
+        k_spinlock_key_t key = k_spin_lock(&loop_lock);
+
+        loop_stats.wakeups++;
+        loop_stats.sleep_ms += sleep_ms;
+        if (events != 0) {
+            loop_stats.event_wakeups++;
+        }
+        k_spin_unlock(&loop_lock, key);
     }
 }
 
+uint32_t display_imu_period_ms(void)
+{
+    /* 小球的一阶滤波按 20 ms 采样整定，需要每个采样；数值模式 10 Hz 足够阅读 */
+    return ui_imu_ball_active() ? 0 : DISPLAY_IMU_PERIOD_MS;
+}
+
+void display_wake(uint32_t events)
+{
+    uint32_t now = k_cycle_get_32() | 1;   // 0 表示没有待上屏的变化
+
+    /* 只保留最早的到达时刻，上屏前多次唤醒不会把延迟算短 */
+    if (events & DISPLAY_EVT_SENSOR) {
+        atomic_cas(&wake_stamp_sensor, 0, now);
+    }
+    if (events & DISPLAY_EVT_INPUT) {
+        atomic_cas(&wake_stamp_input, 0, now);
+    }
+    k_event_post(&display_events, events);
+}
+
+void display_get_loop_stats(struct display_loop_stats *out)
+{
+    k_spinlock_key_t key = k_spin_lock(&loop_lock);
+
+    *out = loop_stats;
+    out->elapsed_ms = (uint32_t)(k_uptime_get() - loop_stats_since);
+    k_spin_unlock(&loop_lock, key);
+}
+
+void display_reset_loop_stats(void)
+{
+    k_spinlock_key_t key = k_spin_lock(&loop_lock);
+
+    memset(&loop_stats, 0, sizeof(loop_stats));
+    loop_stats_since = k_uptime_get();
+    k_spin_unlock(&loop_lock, key);
+}
+
 // 线程栈和定义
 
 #define DISPLAY_STACK_SIZE 8192
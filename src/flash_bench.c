@@ -0,0 +1,300 @@
+/*
+ * application/src/flash_bench.c
+ * QSPI NOR Flash 基准测试：norflash bench [次数]
+ *
+ * 测试项 (每项重复 N 次，给出 最小/平均/最大)：
+ *   - 擦除耗时：4KB 扇区、64KB 块、整个测试区 (多块一次擦除)
+ *   - 页编程吞吐：不同单次写入大小 (超过一页 256B 时由驱动拆分)
+ *   - flash_read 吞吐：不同单次读取大小
+ *   - 从内存映射 (XIP) 窗口 memcpy 的吞吐
+ *
+ * 只擦写 bench_partition 测试区，其余分区不受影响。
+ * 直接调用 flash_erase/flash_write (不经过 flash_area 包装)，测得的是驱动本身的耗时，
+ * 因此每一批擦写自行持有 asset_xip_lock() 并在结束后重新进入内存映射模式。
+ * native_sim 上只要 Flash 模拟器的设备树中有 bench_partition 分区即可运行，
+ * XIP 一项读取的是模拟器内存。
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/shell/shell.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "asset_store.h"
+
+/* ---------------- 配置参数 ---------------- */
+#define BENCH_DEV            FIXED_PARTITION_DEVICE(bench_partition)
+#define BENCH_OFFSET         FIXED_PARTITION_OFFSET(bench_partition)
+#define BENCH_SIZE           FIXED_PARTITION_SIZE(bench_partition)
+#define BENCH_SECTOR         4096
+#define BENCH_BLOCK          (64 * 1024)
+/* 块擦除需要 64KB 对齐：测试区内第一个对齐的块及其后的完整块数 */
+#define BENCH_BLOCK_FIRST    ROUND_UP(BENCH_OFFSET, BENCH_BLOCK)
+#define BENCH_BLOCKS         ((BENCH_OFFSET + BENCH_SIZE - BENCH_BLOCK_FIRST) / BENCH_BLOCK)
+#define BENCH_PROG_BYTES     (16 * 1024)   // 每次编程测试写入的总量
+#define BENCH_READ_BYTES     BENCH_BLOCK   // 每次读取测试读取的总量
+#define BENCH_DEFAULT_RUNS   5
+#define BENCH_MAX_RUNS       20
+
+BUILD_ASSERT(BENCH_BLOCKS >= 2, "bench_partition 至少需要两个 64KB 对齐的块");
+
+static const uint32_t prog_chunks[] = {16, 64, 256, 1024, 4096};
+static const uint32_t read_chunks[] = {16, 256, 4096};
+
+static uint8_t bench_buf[4096];
+
+struct bench_stat {
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+    uint32_t n;
+};
+
+static inline uint32_t elapsed_us(uint32_t t0)
+{
+    return (uint32_t)k_cyc_to_us_floor64(k_cycle_get_32() - t0);
+}
+
+/* KB/s = 字节数 / 微秒 * 1e6 / 1024 */
+static inline uint32_t kbps(uint32_t bytes, uint32_t us)
+{
+    return us ? (uint32_t)((uint64_t)bytes * 1000000 / 1024 / us) : 0;
+}
+
+static void stat_add(struct bench_stat *s, uint32_t v)
+{
+    if (s->n == 0 || v < s->min) {
+        s->min = v;
+    }
+    if (s->n == 0 || v > s->max) {
+        s->max = v;
+    }
+    s->sum += v;
+    s->n++;
+}
+
+/* 耗时类结果按 ms 打印 (保留一位小数) */
+static void print_time(const struct shell *sh, const char *name, const struct bench_stat *s)
+{
+    uint32_t mean = s->n ? (uint32_t)(s->sum / s->n) : 0;
+
+    shell_print(sh, "%-18s %6u.%u %6u.%u %6u.%u  ms", name,
+                s->min / 1000, s->min % 1000 / 100, mean / 1000, mean % 1000 / 100,
+                s->max / 1000, s->max % 1000 / 100);
+}
+
+static void print_rate(const struct shell *sh, const char *name, const struct bench_stat *s)
+{
+    shell_print(sh, "%-18s %8u %8u %8u  KB/s", name, s->min,
+                s->n ? (uint32_t)(s->sum / s->n) : 0, s->max);
+}
+
+/* 一次擦除并计时；持锁期间内存映射窗口不可用 */
+static int timed_erase(off_t off, size_t len, uint32_t *us)
+{
+    uint32_t t0;
+    int ret;
+
+    asset_xip_lock();
+    t0 = k_cycle_get_32();
+    ret = flash_erase(BENCH_DEV, off, len);
+    *us = elapsed_us(t0);
+    asset_xip_remap();
+    asset_xip_unlock();
+    return ret;
+}
+
+static int bench_erase(const struct shell *sh, int runs)
+{
+    struct bench_stat sector = {0}, block = {0}, region = {0};
+    uint32_t us;
+    int ret;
+
+    for (int i = 0; i < runs; i++) {
+        /* 扇区和块轮流使用测试区内的不同位置，分散磨损 */
+        off_t s_off = BENCH_OFFSET + (i * BENCH_SECTOR) % BENCH_SIZE;
+        off_t b_off = BENCH_BLOCK_FIRST + (i % BENCH_BLOCKS) * BENCH_BLOCK;
+
+        ret = timed_erase(s_off, BENCH_SECTOR, &us);
+        if (ret < 0) {
+            return ret;
+        }
+        stat_add(&sector, us);
+
+        ret = timed_erase(b_off, BENCH_BLOCK, &us);
+        if (ret < 0) {
+            return ret;
+        }
+        stat_add(&block, us);
+
+        ret = timed_erase(BENCH_BLOCK_FIRST, BENCH_BLOCKS * BENCH_BLOCK, &us);
+        if (ret < 0) {
+            return ret;
+        }
+        stat_add(&region, us);
+    }
+
+    print_time(sh, "擦除 4KB 扇区", &sector);
+    print_time(sh, "擦除 64KB 块", &block);
+    shell_print(sh, "  (测试区整体擦除: %u 个 64KB 块)", (uint32_t)BENCH_BLOCKS);
+    print_time(sh, "擦除测试区", &region);
+    return 0;
+}
+
+static int bench_program(const struct shell *sh, int runs)
+{
+    char name[24];
+    uint32_t us, t0;
+    int ret = 0;
+
+    for (size_t i = 0; i < sizeof(bench_buf); i++) {
+        bench_buf[i] = (uint8_t)(i * 31 + 7);
+    }
+
+    for (size_t c = 0; c < ARRAY_SIZE(prog_chunks); c++) {
+        struct bench_stat s = {0};
+        uint32_t chunk = prog_chunks[c];
+
+        for (int i = 0; i < runs; i++) {
+            off_t base = BENCH_BLOCK_FIRST + (i % BENCH_BLOCKS) * BENCH_BLOCK;
+
+            /* 擦除不计入编程时间 */
+            ret = timed_erase(base, BENCH_BLOCK, &us);
+            if (ret < 0) {
+                return ret;
+            }
+
+            asset_xip_lock();
+            t0 = k_cycle_get_32();
+            for (uint32_t done = 0; done < BENCH_PROG_BYTES && ret == 0; done += chunk) {
+                ret = flash_write(BENCH_DEV, base + done, bench_buf + done % sizeof(bench_buf),
+                                  chunk);
+            }
+            us = elapsed_us(t0);
+            asset_xip_remap();
+            asset_xip_unlock();
+            if (ret < 0) {
+                return ret;
+            }
+            stat_add(&s, kbps(BENCH_PROG_BYTES, us));
+        }
+
+        snprintf(name, sizeof(name), "编程 %uB/次", chunk);
+        print_rate(sh, name, &s);
+    }
+
+    /* 最后一次写入的数据通过映射窗口读回比对，顺带确认重新映射正常 */
+    off_t last = BENCH_BLOCK_FIRST + ((runs - 1) % BENCH_BLOCKS) * BENCH_BLOCK;
+    const uint8_t *xip = asset_xip_ptr(last);
+
+    if (xip != NULL) {
+        asset_xip_lock();
+        ret = memcmp(xip, bench_buf, sizeof(bench_buf));
+        asset_xip_unlock();
+        if (ret != 0) {
+            shell_error(sh, "映射窗口读回的数据与写入不一致!");
+            return -EIO;
+        }
+    }
+    return 0;
+}
+
+static int bench_read(const struct shell *sh, int runs)
+{
+    char name[24];
+    uint32_t us, t0;
+    int ret = 0;
+
+    for (size_t c = 0; c < ARRAY_SIZE(read_chunks); c++) {
+        struct bench_stat s = {0};
+        uint32_t chunk = read_chunks[c];
+
+        for (int i = 0; i < runs; i++) {
+            t0 = k_cycle_get_32();
+            for (uint32_t done = 0; done < BENCH_READ_BYTES && ret == 0; done += chunk) {
+                ret = flash_read(BENCH_DEV, BENCH_BLOCK_FIRST + done, bench_buf, chunk);
+            }
+            us = elapsed_us(t0);
+            if (ret < 0) {
+                return ret;
+            }
+            stat_add(&s, kbps(BENCH_READ_BYTES, us));
+        }
+
+        snprintf(name, sizeof(name), "flash_read %uB/次", chunk);
+        print_rate(sh, name, &s);
+    }
+    return 0;
+}
+
+static int bench_xip(const struct shell *sh, int runs)
+{
+    const uint8_t *xip = asset_xip_ptr(BENCH_BLOCK_FIRST);
+    struct bench_stat s = {0};
+    uint32_t us, t0;
+
+    if (xip == NULL) {
+        shell_print(sh, "%-18s 不可用", "XIP memcpy");
+        return 0;
+    }
+
+    for (int i = 0; i < runs; i++) {
+        asset_xip_lock();
+        t0 = k_cycle_get_32();
+        for (uint32_t done = 0; done < BENCH_READ_BYTES; done += sizeof(bench_buf)) {
+            memcpy(bench_buf, xip + done, sizeof(bench_buf));
+        }
+        us = elapsed_us(t0);
+        asset_xip_unlock();
+        stat_add(&s, kbps(BENCH_READ_BYTES, us));
+    }
+
+    print_rate(sh, "XIP memcpy 4KB/次", &s);
+    return 0;
+}
+
+static int cmd_norflash_bench(const struct shell *sh, size_t argc, char **argv)
+{
+    int runs = (argc > 1) ? atoi(argv[1]) : BENCH_DEFAULT_RUNS;
+    int ret;
+
+    if (!device_is_ready(BENCH_DEV)) {
+        shell_error(sh, "Flash 设备未就绪");
+        return -ENODEV;
+    }
+    if (runs < 1 || runs > BENCH_MAX_RUNS) {
+        shell_error(sh, "次数范围 1..%d", BENCH_MAX_RUNS);
+        return -EINVAL;
+    }
+
+    shell_print(sh, "%s, 测试区 0x%06x + %u KB, 每项 %d 次",
+                BENCH_DEV->name, (uint32_t)BENCH_OFFSET, (uint32_t)BENCH_SIZE / 1024, runs);
+    shell_print(sh, "%-18s %8s %8s %8s", "测试项", "最小", "平均", "最大");
+
+    ret = bench_erase(sh, runs);
+    if (ret == 0) {
+        ret = bench_program(sh, runs);
+    }
+    if (ret == 0) {
+        ret = bench_read(sh, runs);
+    }
+    if (ret == 0) {
+        ret = bench_xip(sh, runs);
+    }
+    if (ret < 0) {
+        shell_error(sh, "测试失败: %d", ret);
+    }
+    return ret;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_norflash,
+    SHELL_CMD_ARG(bench, NULL, "QSPI Flash 基准测试 (只擦写测试区): bench [次数]",
+                  cmd_norflash_bench, 1, 1),
+    SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(norflash, &sub_norflash, "W25Q128 QSPI Flash", NULL);
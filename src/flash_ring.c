@@ -0,0 +1,547 @@
+/*
+ * application/src/flash_ring.c
+ * 裸 Flash 环形记录日志：直接使用 storage_partition，不经过 LittleFS
+ *
+ * 布局 (每个 4KB 扇区)：
+ *   [扇区头 16B: magic | seq | reserved | crc32] [记录][记录]...[0xFF 擦除区]
+ * 记录：
+ *   [len 2B | reserved 2B | crc32 4B] [对齐填充 0xFF] [payload] [对齐填充 0xFF]
+ * 扇区头、记录头和 payload 都从写入对齐粒度的整数倍处开始。
+ *
+ * 写入顺序沿扇区号递增并回绕，扇区序号 seq 全局单调递增，
+ * 所以把扇区按物理位置排开后，序号是一个“旋转过的有序数组”，可以二分查找头部。
+ * 序号按序列号算术比较 (差值看作有符号数)，32 位回绕后跳过 0 继续递增。
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/sys/crc.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/logging/log.h>
+#include <string.h>
+#include <errno.h>
+
+#include "flash_ring.h"
+
+LOG_MODULE_REGISTER(FLASH_RING, LOG_LEVEL_INF);
+
+/* ---------------- 配置参数 ---------------- */
+#define RING_PARTITION_ID   FIXED_PARTITION_ID(storage_partition)
+#define RING_MAGIC          0x474E5252u   // "RRNG"
+#define RING_SEQ_INVALID    0u            // 扇区头无效/已擦除时返回的序号
+#define RING_LEN_ERASED     0xFFFFu
+
+struct ring_sector_hdr {
+    uint32_t magic;
+    uint32_t seq;
+    uint32_t reserved;
+    uint32_t crc;       // 前 12 字节的 CRC32
+} __packed;
+
+struct ring_record_hdr {
+    uint16_t len;
+    uint16_t reserved;
+    uint32_t crc;       // payload 的 CRC32
+} __packed;
+
+BUILD_ASSERT(ROUND_UP(sizeof(struct ring_sector_hdr), FLASH_RING_ALIGN_MAX) +
+             ROUND_UP(sizeof(struct ring_record_hdr), FLASH_RING_ALIGN_MAX) +
+             FLASH_RING_MAX_RECORD == FLASH_RING_SECTOR_SIZE);
+
+static const struct flash_area *fa;
+static uint32_t align;          // 写入对齐粒度
+static uint32_t first_off;      // 扇区内第一条记录的偏移
+static uint32_t rec_hdr_span;   // 记录头按对齐粒度填充后的长度，即 payload 相对记录的偏移
+static uint32_t sector_count;
+
+static uint32_t head;           // 正在写入的扇区
+static uint32_t head_seq;
+static uint32_t tail;           // 最旧数据所在扇区
+static uint32_t write_off;      // 正在写入扇区内的偏移
+static uint32_t stat_records;
+static uint32_t stat_erases;
+static bool ring_ready;
+
+static K_MUTEX_DEFINE(ring_lock);
+
+static inline off_t sector_addr(uint32_t sector)
+{
+    return (off_t)sector * FLASH_RING_SECTOR_SIZE;
+}
+
+static inline uint32_t ring_next(uint32_t sector)
+{
+    return (sector + 1 == sector_count) ? 0 : sector + 1;
+}
+
+static inline uint32_t seq_next(uint32_t seq)
+{
+    return (seq + 1 == RING_SEQ_INVALID) ? seq + 2 : seq + 1;
+}
+
+/* a 不早于 b；环形内同时存在的序号相差远小于 2^31 */
+static inline bool seq_after_eq(uint32_t a, uint32_t b)
+{
+    return (int32_t)(a - b) >= 0;
+}
+
+/* 读取扇区序号，扇区头无效 (擦除态或残缺) 时返回 RING_SEQ_INVALID */
+static uint32_t sector_seq(uint32_t sector)
+{
+    struct ring_sector_hdr hdr;
+
+    if (flash_area_read(fa, sector_addr(sector), &hdr, sizeof(hdr)) < 0) {
+        return RING_SEQ_INVALID;
+    }
+    if (hdr.magic != RING_MAGIC ||
+        hdr.crc != crc32_ieee((const uint8_t *)&hdr, offsetof(struct ring_sector_hdr, crc))) {
+        return RING_SEQ_INVALID;
+    }
+    return hdr.seq;
+}
+
+/* 整个扇区都是擦除态；擦除或写扇区头途中掉电会留下非空但无效的扇区 */
+static bool sector_is_blank(uint32_t sector)
+{
+    uint8_t chunk[64];
+
+    for (uint32_t off = 0; off < FLASH_RING_SECTOR_SIZE; off += sizeof(chunk)) {
+        if (flash_area_read(fa, sector_addr(sector) + off, chunk, sizeof(chunk)) < 0) {
+            return false;
+        }
+        for (size_t i = 0; i < sizeof(chunk); i++) {
+            if (chunk[i] != 0xFF) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static int sector_erase(uint32_t sector)
+{
+    stat_erases++;
+    return flash_area_erase(fa, sector_addr(sector), FLASH_RING_SECTOR_SIZE);
+}
+
+static int sector_write_hdr(uint32_t sector, uint32_t seq)
+{
+    struct ring_sector_hdr hdr = {
+        .magic = RING_MAGIC,
+        .seq = seq,
+        .reserved = 0xFFFFFFFFu,
+    };
+    uint8_t buf[ROUND_UP(sizeof(hdr), FLASH_RING_ALIGN_MAX)];
+
+    hdr.crc = crc32_ieee((const uint8_t *)&hdr, offsetof(struct ring_sector_hdr, crc));
+    memset(buf, 0xFF, first_off);
+    memcpy(buf, &hdr, sizeof(hdr));
+    return flash_area_write(fa, sector_addr(sector), buf, first_off);
+}
+
+static inline uint32_t record_span(size_t len)
+{
+    return rec_hdr_span + ROUND_UP(len, align);
+}
+
+/*
+ * 校验扇区内 off 处的记录
+ * 返回: > 0 记录长度; 0 到达擦除区; -EBADMSG 记录损坏
+ * buf 不为空时同时把 payload 拷贝出去 (调用方保证空间足够)
+ */
+static int record_check(uint32_t sector, uint32_t off, void *buf)
+{
+    struct ring_record_hdr hdr;
+    uint8_t chunk[64];
+    uint32_t crc = 0;
+    off_t addr = sector_addr(sector) + off;
+    int ret;
+
+    if (off + rec_hdr_span > FLASH_RING_SECTOR_SIZE) {
+        return 0;
+    }
+
+    ret = flash_area_read(fa, addr, &hdr, sizeof(hdr));
+    if (ret < 0) {
+        return ret;
+    }
+    if (hdr.len == RING_LEN_ERASED) {
+        return 0;
+    }
+    if (hdr.len == 0 || off + record_span(hdr.len) > FLASH_RING_SECTOR_SIZE) {
+        return -EBADMSG;
+    }
+
+    addr += rec_hdr_span;
+    for (uint32_t done = 0; done < hdr.len; ) {
+        uint32_t n = MIN(sizeof(chunk), hdr.len - done);
+
+        ret = flash_area_read(fa, addr + done, chunk, n);
+        if (ret < 0) {
+            return ret;
+        }
+        crc = crc32_ieee_update(crc, chunk, n);
+        if (buf != NULL) {
+            memcpy((uint8_t *)buf + done, chunk, n);
+        }
+        done += n;
+    }
+
+    return (crc == hdr.crc) ? hdr.len : -EBADMSG;
+}
+
+/* 扫描头扇区，找到第一个可写位置；遇到残缺记录则把扇区视为已写满 */
+static uint32_t sector_find_write_off(uint32_t sector)
+{
+    uint32_t off = first_off;
+
+    while (off < FLASH_RING_SECTOR_SIZE) {
+        int len = record_check(sector, off, NULL);
+
+        if (len == 0) {
+            return off;
+        }
+        if (len < 0) {
+            LOG_WRN("扇区 %u 偏移 %u 处记录损坏，跳到下一扇区", sector, off);
+            return FLASH_RING_SECTOR_SIZE;
+        }
+        off += record_span(len);
+    }
+    return FLASH_RING_SECTOR_SIZE;
+}
+
+/* 切换到已预擦除的下一个扇区，并继续预擦除再下一个扇区 */
+static int ring_advance(void)
+{
+    uint32_t next = ring_next(head);
+    uint32_t pre;
+    int ret;
+
+    ret = sector_write_hdr(next, seq_next(head_seq));
+    if (ret < 0) {
+        return ret;
+    }
+    head = next;
+    head_seq = seq_next(head_seq);
+    write_off = first_off;
+
+    pre = ring_next(head);
+    if (pre == tail) {
+        // 环形已满：最旧的扇区被回收
+        tail = ring_next(tail);
+    }
+    return sector_erase(pre);
+}
+
+/* 空分区：从扇区 0 开始 */
+static int ring_format(void)
+{
+    int ret;
+
+    ret = sector_erase(0);
+    if (ret == 0) {
+        ret = sector_erase(1);
+    }
+    if (ret == 0) {
+        ret = sector_write_hdr(0, 1);
+    }
+    head = 0;
+    head_seq = 1;
+    tail = 0;
+    write_off = first_off;
+    return ret;
+}
+
+/* 开机恢复：O(log n) 次扇区头读取定位头部 */
+static int ring_recover(void)
+{
+    uint32_t lo = 0, hi, base, first_valid;
+
+    /* 扇区 0 恰好是头部之后的预擦除扇区时，从扇区 1 开始是一段严格递增序列 */
+    base = sector_seq(0);
+    if (base == RING_SEQ_INVALID) {
+        lo = 1;
+        base = sector_seq(1);
+        if (base == RING_SEQ_INVALID) {
+            LOG_INF("分区为空，初始化环形日志");
+            return ring_format();
+        }
+    }
+
+    first_valid = lo;
+
+    /* 二分查找最后一个序号不早于 base 的扇区，即序号最大的头扇区 */
+    hi = sector_count - 1;
+    while (lo < hi) {
+        uint32_t mid = (lo + hi + 1) / 2;
+        uint32_t seq = sector_seq(mid);
+
+        if (seq != RING_SEQ_INVALID && seq_after_eq(seq, base)) {
+            lo = mid;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    head = lo;
+    head_seq = sector_seq(head);
+
+    /* 尾部紧跟在头部之后 (中间最多隔一个预擦除扇区)；都无效说明环形尚未写满一圈 */
+    tail = first_valid;
+    for (uint32_t i = 0, s = ring_next(head); i < 2; i++, s = ring_next(s)) {
+        uint32_t seq = sector_seq(s);
+
+        if (seq != RING_SEQ_INVALID && !seq_after_eq(seq, head_seq)) {
+            tail = s;
+            break;
+        }
+    }
+
+    write_off = sector_find_write_off(head);
+
+    /*
+     * 保证头部之后有一个预擦除扇区：上次可能在切换扇区途中掉电，
+     * 留下写了一半的扇区头 (序号无效但不是擦除态)，直接写入会失败
+     */
+    uint32_t pre = ring_next(head);
+
+    if (!sector_is_blank(pre)) {
+        if (pre == tail) {
+            tail = ring_next(tail);
+        }
+        return sector_erase(pre);
+    }
+    return 0;
+}
+
+int flash_ring_init(void)
+{
+    int ret;
+
+    k_mutex_lock(&ring_lock, K_FOREVER);
+
+    if (ring_ready) {
+        ret = 0;
+        goto out;
+    }
+
+    ret = flash_area_open(RING_PARTITION_ID, &fa);
+    if (ret < 0) {
+        LOG_ERR("无法打开 storage 分区: %d", ret);
+        goto out;
+    }
+
+    align = MAX(flash_area_align(fa), 4u);
+    if (align > FLASH_RING_ALIGN_MAX || !IS_POWER_OF_TWO(align)) {
+        LOG_ERR("不支持的写入对齐: %u", align);
+        ret = -ENOTSUP;
+        goto out;
+    }
+    first_off = ROUND_UP(sizeof(struct ring_sector_hdr), align);
+    rec_hdr_span = ROUND_UP(sizeof(struct ring_record_hdr), align);
+    sector_count = fa->fa_size / FLASH_RING_SECTOR_SIZE;
+    if (sector_count < 3) {
+        ret = -EINVAL;
+        goto out;
+    }
+
+    ret = ring_recover();
+    if (ret < 0) {
+        LOG_ERR("环形日志恢复失败: %d", ret);
+        goto out;
+    }
+
+    ring_ready = true;
+    LOG_INF("环形日志就绪: %u 扇区, 头 %u (seq %u, 偏移 %u), 尾 %u",
+            sector_count, head, head_seq, write_off, tail);
+
+out:
+    k_mutex_unlock(&ring_lock);
+    return ret;
+}
+
+int flash_ring_append(const void *data, size_t len)
+{
+    struct ring_record_hdr hdr;
+    uint8_t pad[FLASH_RING_ALIGN_MAX];
+    off_t addr;
+    size_t body;
+    int ret;
+
+    if (len == 0 || len > FLASH_RING_MAX_RECORD) {
+        return -EINVAL;
+    }
+
+    k_mutex_lock(&ring_lock, K_FOREVER);
+
+    if (!ring_ready) {
+        ret = -ENODEV;
+        goto out;
+    }
+
+    if (write_off + record_span(len) > FLASH_RING_SECTOR_SIZE) {
+        ret = ring_advance();
+        if (ret < 0) {
+            goto out;
+        }
+    }
+
+    /* 先写记录头 (含 CRC)，再写 payload：掉电时留下的是一条 CRC 不匹配的记录 */
+    hdr.len = (uint16_t)len;
+    hdr.reserved = 0xFFFF;
+    hdr.crc = crc32_ieee(data, len);
+
+    /* 记录头补 0xFF 到一个对齐单位，payload 从对齐位置开始 */
+    addr = sector_addr(head) + write_off;
+    memset(pad, 0xFF, rec_hdr_span);
+    memcpy(pad, &hdr, sizeof(hdr));
+    ret = flash_area_write(fa, addr, pad, rec_hdr_span);
+    if (ret < 0) {
+        goto out;
+    }
+    addr += rec_hdr_span;
+
+    /* 对齐部分直接写，末尾不足一个对齐单位的部分补 0xFF 后写入 */
+    body = ROUND_DOWN(len, align);
+    if (body > 0) {
+        ret = flash_area_write(fa, addr, data, body);
+        if (ret < 0) {
+            goto out;
+        }
+    }
+    if (len > body) {
+        memset(pad, 0xFF, align);
+        memcpy(pad, (const uint8_t *)data + body, len - body);
+        ret = flash_area_write(fa, addr + body, pad, align);
+        if (ret < 0) {
+            goto out;
+        }
+    }
+
+    write_off += record_span(len);
+    stat_records++;
+
+out:
+    if (ret < 0) {
+        LOG_ERR("追加记录失败: %d", ret);
+    }
+    k_mutex_unlock(&ring_lock);
+    return ret;
+}
+
+void flash_ring_cursor_init(struct flash_ring_cursor *cur)
+{
+    k_mutex_lock(&ring_lock, K_FOREVER);
+    cur->sector = tail;
+    cur->offset = first_off;
+    cur->seq = ring_ready ? sector_seq(tail) : RING_SEQ_INVALID;
+    k_mutex_unlock(&ring_lock);
+}
+
+int flash_ring_read(struct flash_ring_cursor *cur, void *buf, size_t size)
+{
+    int ret;
+
+    k_mutex_lock(&ring_lock, K_FOREVER);
+
+    if (!ring_ready || cur->seq == RING_SEQ_INVALID) {
+        ret = -ENOENT;
+        goto out;
+    }
+
+    while (1) {
+        /* 游标停留期间扇区可能已被回收重写 */
+        if (sector_seq(cur->sector) != cur->seq) {
+            ret = -ESTALE;
+            goto out;
+        }
+        if (cur->sector == head && cur->offset >= write_off) {
+            ret = -ENOENT;
+            goto out;
+        }
+
+        struct ring_record_hdr hdr;
+
+        ret = flash_area_read(fa, sector_addr(cur->sector) + cur->offset, &hdr, sizeof(hdr));
+        if (ret < 0) {
+            goto out;
+        }
+
+        if (cur->offset + rec_hdr_span <= FLASH_RING_SECTOR_SIZE &&
+            hdr.len != RING_LEN_ERASED && hdr.len <= size) {
+            ret = record_check(cur->sector, cur->offset, buf);
+            if (ret > 0) {
+                cur->offset += record_span(ret);
+                goto out;
+            }
+        } else if (hdr.len != RING_LEN_ERASED && hdr.len <= FLASH_RING_MAX_RECORD &&
+                   cur->offset + record_span(hdr.len) <= FLASH_RING_SECTOR_SIZE) {
+            /* 缓冲区放不下这条记录：跳过并报告 */
+            cur->offset += record_span(hdr.len);
+            ret = -ENOMEM;
+            goto out;
+        }
+
+        /* 扇区末尾、擦除区或损坏记录：进入下一个扇区 */
+        if (cur->sector == head) {
+            ret = -ENOENT;
+            goto out;
+        }
+        cur->sector = ring_next(cur->sector);
+        cur->offset = first_off;
+        cur->seq = sector_seq(cur->sector);
+    }
+
+out:
+    k_mutex_unlock(&ring_lock);
+    return ret;
+}
+
+int flash_ring_clear(void)
+{
+    int ret = 0;
+
+    k_mutex_lock(&ring_lock, K_FOREVER);
+
+    if (!ring_ready) {
+        ret = -ENODEV;
+        goto out;
+    }
+
+    /* 只需擦掉所有带扇区头的扇区 */
+    for (uint32_t s = 0; s < sector_count && ret == 0; s++) {
+        if (sector_seq(s) != RING_SEQ_INVALID) {
+            ret = sector_erase(s);
+        }
+    }
+    if (ret == 0) {
+        ret = ring_format();
+    }
+
+out:
+    k_mutex_unlock(&ring_lock);
+    return ret;
+}
+
+void flash_ring_get_info(struct flash_ring_info *info)
+{
+    k_mutex_lock(&ring_lock, K_FOREVER);
+    info->sector_count = sector_count;
+    info->head_sector = head;
+    info->tail_sector = tail;
+    info->head_seq = head_seq;
+    info->write_offset = write_off;
+    info->records = stat_records;
+    info->erases = stat_erases;
+    k_mutex_unlock(&ring_lock);
+}
+
+static int auto_init_flash_ring(void)
+{
+    // 失败只记录日志，不影响系统启动；使用者调用 API 时会得到 -ENODEV
+    flash_ring_init();
+    return 0;
+}
+
+/* APPLICATION 级别初始化：QSPI Flash 驱动在 POST_KERNEL 阶段已就绪 */
+SYS_INIT(auto_init_flash_ring, APPLICATION, 60);
@@ -0,0 +1,454 @@
+/*
+ * application/src/flash_stats.c
+ * Flash 访问统计：flash_area_* 包装函数 + 持久化
+ *
+ * CMakeLists.txt 中通过 -Wl,--wrap=flash_area_xxx 把所有对 flash_area_xxx 的调用
+ * 重定向到这里的 __wrap_flash_area_xxx，原函数以 __real_flash_area_xxx 调用。
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/fs/fs.h>
+#include <zephyr/sys/crc.h>
+#include <zephyr/logging/log.h>
+#include <string.h>
+
+#include "flash_stats.h"
+#include "boot_prof.h"
+#include "asset_store.h"
+
+LOG_MODULE_REGISTER(FLASH_STATS, LOG_LEVEL_INF);
+
+/* ---------------- 配置参数 ---------------- */
+#define STATS_MAGIC          0x54534C46u   // "FLST"
+#define STATS_VERSION        2             // v2: 扇区擦除次数改为 32 位 (v1 为 16 位，读取时扩展)
+#define STATS_LOAD_CHUNK     64            // 读回扇区表时每次处理的扇区数
+#define STATS_THREAD_STACK   2048
+#define STATS_THREAD_PRIO    14
+
+#define FS_PART_ID     FIXED_PARTITION_ID(filesystem_partition)
+#define RING_PART_ID   FIXED_PARTITION_ID(storage_partition)
+#define FS_SECTORS     (FIXED_PARTITION_SIZE(filesystem_partition) / FLASH_STATS_SECTOR)
+#define RING_SECTORS   (FIXED_PARTITION_SIZE(storage_partition) / FLASH_STATS_SECTOR)
+
+struct stats_file_hdr {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t uptime_s;
+    uint32_t records;
+    uint64_t logical_bytes;
+    uint32_t fs_sectors;
+    uint32_t ring_sectors;
+} __packed;
+
+static struct flash_part_counters parts[FLASH_STATS_PART_COUNT];
+/* 额定寿命 10 万次，16 位计数会在寿命到达之前饱和 */
+static uint32_t fs_erases[FS_SECTORS];
+static uint32_t ring_erases[RING_SECTORS];
+static uint32_t logical_records;
+static uint64_t logical_bytes;
+static uint32_t saved_uptime_s;     // 文件中保存的累计运行时间 (之前各次开机)
+static uint32_t reset_uptime_s;     // 本次开机计数起点 (清零时的开机时长)，未清零为 0
+static bool loaded;
+
+static struct k_spinlock lock;
+static K_MUTEX_DEFINE(file_lock);
+
+/* 链接器提供的原始实现 */
+int __real_flash_area_read(const struct flash_area *fa, off_t off, void *dst, size_t len);
+int __real_flash_area_write(const struct flash_area *fa, off_t off, const void *src, size_t len);
+int __real_flash_area_erase(const struct flash_area *fa, off_t off, size_t len);
+int __real_flash_area_flatten(const struct flash_area *fa, off_t off, size_t len);
+
+static enum flash_stats_part part_of(const struct flash_area *fa)
+{
+    if (fa->fa_id == FS_PART_ID) {
+        return FLASH_STATS_FS;
+    } else if (fa->fa_id == RING_PART_ID) {
+        return FLASH_STATS_RING;
+    }
+    return FLASH_STATS_OTHER;
+}
+
+static uint32_t *sector_table(enum flash_stats_part part, uint32_t *count)
+{
+    switch (part) {
+    case FLASH_STATS_FS:
+        *count = FS_SECTORS;
+        return fs_erases;
+    case FLASH_STATS_RING:
+        *count = RING_SECTORS;
+        return ring_erases;
+    default:
+        *count = 0;
+        return NULL;
+    }
+}
+
+static inline uint32_t uptime_now_s(void)
+{
+    return (uint32_t)(k_uptime_get() / 1000);
+}
+
+/* 清零内存中的全部统计，运行时间从现在重新计 */
+static void stats_clear(void)
+{
+    k_spinlock_key_t key = k_spin_lock(&lock);
+
+    memset(parts, 0, sizeof(parts));
+    memset(fs_erases, 0, sizeof(fs_erases));
+    memset(ring_erases, 0, sizeof(ring_erases));
+    logical_records = 0;
+    logical_bytes = 0;
+    saved_uptime_s = 0;
+    reset_uptime_s = uptime_now_s();
+    k_spin_unlock(&lock, key);
+}
+
+static void account_erase(const struct flash_area *fa, off_t off, size_t len)
+{
+    enum flash_stats_part part = part_of(fa);
+    uint32_t first = off / FLASH_STATS_SECTOR;
+    uint32_t n = DIV_ROUND_UP(len, FLASH_STATS_SECTOR);
+    uint32_t count;
+    uint32_t *tbl = sector_table(part, &count);
+    k_spinlock_key_t key = k_spin_lock(&lock);
+
+    parts[part].erase_ops++;
+    parts[part].erase_sectors += n;
+    for (uint32_t s = first; tbl != NULL && s < first + n && s < count; s++) {
+        if (tbl[s] < UINT32_MAX) {
+            tbl[s]++;
+        }
+    }
+    k_spin_unlock(&lock, key);
+}
+
+/* ---------------- 包装函数 ---------------- */
+
+int __wrap_flash_area_read(const struct flash_area *fa, off_t off, void *dst, size_t len)
+{
+    int ret = __real_flash_area_read(fa, off, dst, len);
+
+    if (ret == 0) {
+        struct flash_part_counters *c = &parts[part_of(fa)];
+        k_spinlock_key_t key = k_spin_lock(&lock);
+
+        c->read_ops++;
+        c->read_bytes += len;
+        k_spin_unlock(&lock, key);
+    }
+    return ret;
+}
+
+/*
+ * 写入/擦除会让 QSPI 退出内存映射模式，期间不能有人读映射窗口 (见 asset_store.h)，
+ * 完成后立即重新进入映射模式。没有资源包时不加锁，写入不会等待显示线程。
+ */
+int __wrap_flash_area_write(const struct flash_area *fa, off_t off, const void *src, size_t len)
+{
+    bool xip = asset_xip_lock_if_mapped();
+    int ret = __real_flash_area_write(fa, off, src, len);
+
+    if (xip) {
+        asset_xip_remap();
+        asset_xip_unlock();
+    }
+
+    if (ret == 0) {
+        struct flash_part_counters *c = &parts[part_of(fa)];
+        k_spinlock_key_t key = k_spin_lock(&lock);
+
+        c->prog_ops++;
+        c->prog_bytes += len;
+        k_spin_unlock(&lock, key);
+    }
+    return ret;
+}
+
+int __wrap_flash_area_erase(const struct flash_area *fa, off_t off, size_t len)
+{
+    bool xip = asset_xip_lock_if_mapped();
+    int ret = __real_flash_area_erase(fa, off, len);
+
+    if (xip) {
+        asset_xip_remap();
+        asset_xip_unlock();
+    }
+
+    if (ret == 0) {
+        account_erase(fa, off, len);
+    }
+    return ret;
+}
+
+/* LittleFS 的块擦除走 flash_area_flatten，在 NOR Flash 上它就是擦除 */
+int __wrap_flash_area_flatten(const struct flash_area *fa, off_t off, size_t len)
+{
+    bool xip = asset_xip_lock_if_mapped();
+    int ret = __real_flash_area_flatten(fa, off, len);
+
+    if (xip) {
+        asset_xip_remap();
+        asset_xip_unlock();
+    }
+
+    if (ret == 0) {
+        account_erase(fa, off, len);
+    }
+    return ret;
+}
+
+/* ---------------- 查询接口 ---------------- */
+
+void flash_stats_note_record(uint32_t bytes)
+{
+    k_spinlock_key_t key = k_spin_lock(&lock);
+
+    logical_records++;
+    logical_bytes += bytes;
+    k_spin_unlock(&lock, key);
+}
+
+int flash_stats_get(enum flash_stats_part part, struct flash_part_counters *out)
+{
+    if (part >= FLASH_STATS_PART_COUNT) {
+        return -EINVAL;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&lock);
+
+    *out = parts[part];
+    k_spin_unlock(&lock, key);
+    return 0;
+}
+
+void flash_stats_get_logical(uint32_t *records, uint64_t *bytes, uint32_t *uptime_s)
+{
+    k_spinlock_key_t key = k_spin_lock(&lock);
+
+    *records = logical_records;
+    *bytes = logical_bytes;
+    *uptime_s = saved_uptime_s + (uptime_now_s() - reset_uptime_s);
+    k_spin_unlock(&lock, key);
+}
+
+const uint32_t *flash_stats_sector_erases(enum flash_stats_part part, uint32_t *sectors)
+{
+    return sector_table(part, sectors);
+}
+
+/* ---------------- 持久化 ---------------- */
+
+static int file_write(struct fs_file_t *f, const void *buf, size_t len, uint32_t *crc)
+{
+    ssize_t n = fs_write(f, buf, len);
+
+    *crc = crc32_ieee_update(*crc, buf, len);
+    return (n == (ssize_t)len) ? 0 : -EIO;
+}
+
+int flash_stats_save(void)
+{
+    struct stats_file_hdr hdr = {
+        .magic = STATS_MAGIC,
+        .version = STATS_VERSION,
+        .fs_sectors = FS_SECTORS,
+        .ring_sectors = RING_SECTORS,
+    };
+    struct flash_part_counters snap[FLASH_STATS_PART_COUNT];
+    struct fs_file_t f;
+    uint32_t crc = 0;
+    int ret;
+
+    k_mutex_lock(&file_lock, K_FOREVER);
+    if (!loaded) {
+        // 旧文件还没合并进来，这时保存会覆盖掉历史数据
+        ret = -EAGAIN;
+        goto out;
+    }
+
+    flash_stats_get_logical(&hdr.records, &hdr.logical_bytes, &hdr.uptime_s);
+    k_spinlock_key_t key = k_spin_lock(&lock);
+
+    memcpy(snap, parts, sizeof(snap));
+    k_spin_unlock(&lock, key);
+
+    fs_file_t_init(&f);
+    ret = fs_open(&f, FLASH_STATS_FILE, FS_O_CREATE | FS_O_WRITE | FS_O_TRUNC);
+    if (ret < 0) {
+        goto out;
+    }
+    /* 扇区表直接写出，不加锁：统计值允许有一两次擦除的误差 */
+    ret = file_write(&f, &hdr, sizeof(hdr), &crc);
+    if (ret == 0) {
+        ret = file_write(&f, snap, sizeof(snap), &crc);
+    }
+    if (ret == 0) {
+        ret = file_write(&f, fs_erases, sizeof(fs_erases), &crc);
+    }
+    if (ret == 0) {
+        ret = file_write(&f, ring_erases, sizeof(ring_erases), &crc);
+    }
+    if (ret == 0 && fs_write(&f, &crc, sizeof(crc)) != sizeof(crc)) {
+        ret = -EIO;
+    }
+    fs_close(&f);
+
+out:
+    k_mutex_unlock(&file_lock);
+    return ret;
+}
+
+/* 读出 n 个扇区的擦除次数并累加 CRC；v1 文件中是 16 位，读入后原地扩展为 32 位 */
+static int read_counts(struct fs_file_t *f, uint16_t version, uint32_t *out, uint32_t n,
+                       uint32_t *crc)
+{
+    size_t len = n * ((version == 1) ? sizeof(uint16_t) : sizeof(uint32_t));
+
+    if (fs_read(f, out, len) != (ssize_t)len) {
+        return -EIO;
+    }
+    *crc = crc32_ieee_update(*crc, (uint8_t *)out, len);
+
+    if (version == 1) {
+        /* 从后往前扩展，不会覆盖还没扩展的 16 位值 */
+        for (uint32_t i = n; i-- > 0;) {
+            uint16_t v;
+
+            memcpy(&v, (uint8_t *)out + i * sizeof(v), sizeof(v));
+            out[i] = v;
+        }
+    }
+    return 0;
+}
+
+/* 读回保存的统计，累加到本次开机已有的计数上 */
+static int stats_load(void)
+{
+    static uint32_t chunk[STATS_LOAD_CHUNK];
+    struct stats_file_hdr hdr;
+    struct flash_part_counters saved[FLASH_STATS_PART_COUNT];
+    struct fs_file_t f;
+    uint32_t crc = 0, file_crc;
+    int ret;
+
+    fs_file_t_init(&f);
+    ret = fs_open(&f, FLASH_STATS_FILE, FS_O_READ);
+    if (ret < 0) {
+        return ret;
+    }
+
+    ret = -EBADMSG;
+    if (fs_read(&f, &hdr, sizeof(hdr)) != sizeof(hdr) || hdr.magic != STATS_MAGIC ||
+        (hdr.version != 1 && hdr.version != STATS_VERSION) || hdr.fs_sectors != FS_SECTORS ||
+        hdr.ring_sectors != RING_SECTORS) {
+        goto out;
+    }
+    crc = crc32_ieee_update(crc, (uint8_t *)&hdr, sizeof(hdr));
+    if (fs_read(&f, saved, sizeof(saved)) != sizeof(saved)) {
+        goto out;
+    }
+    crc = crc32_ieee_update(crc, (uint8_t *)saved, sizeof(saved));
+
+    /* 先校验整个文件，再合并 */
+    for (int t = 0; t < 2; t++) {
+        uint32_t count = (t == 0) ? FS_SECTORS : RING_SECTORS;
+
+        for (uint32_t s = 0; s < count; s += STATS_LOAD_CHUNK) {
+            if (read_counts(&f, hdr.version, chunk, MIN(STATS_LOAD_CHUNK, count - s), &crc) < 0) {
+                goto out;
+            }
+        }
+    }
+    if (fs_read(&f, &file_crc, sizeof(file_crc)) != sizeof(file_crc) || file_crc != crc) {
+        goto out;
+    }
+
+    /* 扇区表：重新定位到文件中的位置逐表合并 */
+    ret = fs_seek(&f, sizeof(hdr) + sizeof(saved), FS_SEEK_SET);
+    for (int t = 0; t < 2 && ret == 0; t++) {
+        uint32_t count, dummy_crc = 0;
+        uint32_t *tbl = sector_table((t == 0) ? FLASH_STATS_FS : FLASH_STATS_RING, &count);
+
+        for (uint32_t s = 0; s < count && ret == 0; s += STATS_LOAD_CHUNK) {
+            uint32_t n = MIN(STATS_LOAD_CHUNK, count - s);
+
+            ret = read_counts(&f, hdr.version, chunk, n, &dummy_crc);
+            if (ret < 0) {
+                break;
+            }
+            k_spinlock_key_t key = k_spin_lock(&lock);
+
+            for (uint32_t i = 0; i < n; i++) {
+                tbl[s + i] = (uint32_t)MIN((uint64_t)tbl[s + i] + chunk[i], UINT32_MAX);
+            }
+            k_spin_unlock(&lock, key);
+        }
+    }
+    if (ret < 0) {
+        /* 校验之后读取仍然失败：扇区表可能只合并了一部分，整体清零，不留半份历史 */
+        stats_clear();
+        goto out;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&lock);
+
+    for (int p = 0; p < FLASH_STATS_PART_COUNT; p++) {
+        parts[p].read_ops += saved[p].read_ops;
+        parts[p].read_bytes += saved[p].read_bytes;
+        parts[p].prog_ops += saved[p].prog_ops;
+        parts[p].prog_bytes += saved[p].prog_bytes;
+        parts[p].erase_ops += saved[p].erase_ops;
+        parts[p].erase_sectors += saved[p].erase_sectors;
+    }
+    logical_records += hdr.records;
+    logical_bytes += hdr.logical_bytes;
+    saved_uptime_s = hdr.uptime_s;
+    k_spin_unlock(&lock, key);
+
+out:
+    fs_close(&f);
+    return ret;
+}
+
+void flash_stats_reset(void)
+{
+    k_mutex_lock(&file_lock, K_FOREVER);
+    stats_clear();
+    fs_unlink(FLASH_STATS_FILE);
+    k_mutex_unlock(&file_lock);
+}
+
+/* 等待 /lfs 挂载后合并历史统计，之后周期性保存 */
+void flash_stats_thread_entry(void *p1, void *p2, void *p3)
+{
+    int ret;
+
+    /* 挂载失败时一直等待：统计仍在内存中累计，只是不保存 */
+    boot_ready_wait(BOOT_READY_FS, K_FOREVER);
+
+    k_mutex_lock(&file_lock, K_FOREVER);
+    ret = stats_load();
+    loaded = true;
+    k_mutex_unlock(&file_lock);
+
+    if (ret == 0) {
+        LOG_INF("已恢复 Flash 统计 (累计运行 %u 秒)", saved_uptime_s);
+    } else if (ret != -ENOENT) {
+        LOG_WRN("Flash 统计文件无效 (%d)，重新开始计数", ret);
+    }
+
+    while (1) {
+        k_msleep(FLASH_STATS_SAVE_INTERVAL);
+        ret = flash_stats_save();
+        if (ret < 0) {
+            LOG_ERR("保存 Flash 统计失败: %d", ret);
+        }
+    }
+}
+
+K_THREAD_DEFINE(flash_stats_tid, STATS_THREAD_STACK,
+                flash_stats_thread_entry, NULL, NULL, NULL,
+                STATS_THREAD_PRIO, 0, 0);
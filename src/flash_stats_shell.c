@@ -0,0 +1,134 @@
+/*
+ * application/src/flash_stats_shell.c
+ * Flash 统计 Shell 命令：flashstats show / heat / save / reset
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+#include <string.h>
+
+#include "flash_stats.h"
+
+#define HEAT_COLUMNS  64
+
+static const char *const part_names[FLASH_STATS_PART_COUNT] = {
+    [FLASH_STATS_FS] = "fs",
+    [FLASH_STATS_RING] = "ring",
+    [FLASH_STATS_OTHER] = "other",
+};
+
+static int cmd_flashstats_show(const struct shell *sh, size_t argc, char **argv)
+{
+    struct flash_part_counters c;
+    uint32_t records, uptime_s;
+    uint64_t lbytes;
+
+    flash_stats_get_logical(&records, &lbytes, &uptime_s);
+    shell_print(sh, "累计运行 %u 秒, 逻辑记录 %u 条 / %llu 字节", uptime_s, records, lbytes);
+    shell_print(sh, "%-6s %10s %12s %10s %12s %8s %8s", "分区", "读次数", "读字节",
+                "写次数", "写字节", "擦除", "扇区");
+
+    for (int p = 0; p < FLASH_STATS_PART_COUNT; p++) {
+        flash_stats_get(p, &c);
+        shell_print(sh, "%-6s %10u %12llu %10u %12llu %8u %8u", part_names[p], c.read_ops,
+                    c.read_bytes, c.prog_ops, c.prog_bytes, c.erase_ops, c.erase_sectors);
+    }
+
+    /* 写放大：文件系统实际编程 + 擦除的字节数 / 逻辑记录字节数 */
+    flash_stats_get(FLASH_STATS_FS, &c);
+    if (records > 0) {
+        shell_print(sh, "每条记录: 编程 %llu 字节, 擦除 %u.%02u 扇区",
+                    c.prog_bytes / records, c.erase_sectors / records,
+                    (c.erase_sectors * 100 / records) % 100);
+        shell_print(sh, "写放大: 编程 %.1fx, 含擦除 %.1fx",
+                    (double)c.prog_bytes / lbytes,
+                    (double)(c.prog_bytes + (uint64_t)c.erase_sectors * FLASH_STATS_SECTOR) / lbytes);
+    }
+    return 0;
+}
+
+static int parse_part(const char *name)
+{
+    for (int p = 0; p < FLASH_STATS_PART_COUNT; p++) {
+        if (strcmp(name, part_names[p]) == 0) {
+            return p;
+        }
+    }
+    return -EINVAL;
+}
+
+/* 擦除次数热力图：每个字符一个扇区，按最大值分 10 级 */
+static int cmd_flashstats_heat(const struct shell *sh, size_t argc, char **argv)
+{
+    static const char levels[] = " .:-=+*#%@";
+    int part = (argc > 1) ? parse_part(argv[1]) : FLASH_STATS_FS;
+    const uint32_t *tbl;
+    uint32_t count, uptime_s, records;
+    uint32_t min = UINT32_MAX, max = 0;
+    uint64_t sum = 0, lbytes;
+    char line[HEAT_COLUMNS + 1];
+
+    tbl = (part >= 0) ? flash_stats_sector_erases(part, &count) : NULL;
+    if (tbl == NULL) {
+        shell_error(sh, "只支持 fs 和 ring 分区");
+        return -EINVAL;
+    }
+
+    for (uint32_t s = 0; s < count; s++) {
+        min = MIN(min, tbl[s]);
+        max = MAX(max, tbl[s]);
+        sum += tbl[s];
+    }
+
+    for (uint32_t row = 0; row < count; row += HEAT_COLUMNS) {
+        uint32_t n = MIN(HEAT_COLUMNS, count - row);
+
+        for (uint32_t i = 0; i < n; i++) {
+            uint32_t v = tbl[row + i];
+
+            line[i] = (max == 0) ? levels[0] : levels[(uint64_t)v * (sizeof(levels) - 2) / max];
+        }
+        line[n] = '\0';
+        shell_print(sh, "%04x |%s|", row, line);
+    }
+
+    shell_print(sh, "扇区 %u 个, 擦除次数 最小 %u / 平均 %llu / 最大 %u", count, min,
+                sum / count, max);
+
+    /* 寿命预测：按最热扇区的擦除速率推算达到额定寿命的剩余时间 */
+    flash_stats_get_logical(&records, &lbytes, &uptime_s);
+    if (max > 0 && uptime_s > 0) {
+        uint64_t remain_s = (uint64_t)(FLASH_STATS_ENDURANCE - MIN(max, FLASH_STATS_ENDURANCE)) *
+                            uptime_s / max;
+
+        shell_print(sh, "按当前速率, 最热扇区约 %llu 天后达到 %u 次擦写寿命",
+                    remain_s / 86400, FLASH_STATS_ENDURANCE);
+    }
+    return 0;
+}
+
+static int cmd_flashstats_save(const struct shell *sh, size_t argc, char **argv)
+{
+    int ret = flash_stats_save();
+
+    if (ret < 0) {
+        shell_error(sh, "保存失败: %d", ret);
+    }
+    return ret;
+}
+
+static int cmd_flashstats_reset(const struct shell *sh, size_t argc, char **argv)
+{
+    flash_stats_reset();
+    return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_flashstats,
+    SHELL_CMD(show, NULL, "各分区读/写/擦除计数与写放大", cmd_flashstats_show),
+    SHELL_CMD_ARG(heat, NULL, "扇区擦除次数热力图: heat [fs|ring]", cmd_flashstats_heat, 1, 1),
+    SHELL_CMD(save, NULL, "立即保存统计", cmd_flashstats_save),
+    SHELL_CMD(reset, NULL, "清零统计", cmd_flashstats_reset),
+    SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(flashstats, &sub_flashstats, "Flash 访问统计命令", NULL);
@@ -6,6 +6,9 @@
 #include <zephyr/logging/log.h>
 #include <string.h>
 
+#include "fs_thread.h"
+#include "boot_prof.h"
+
 // 注册日志模块
 LOG_MODULE_REGISTER(FS_CHECK, LOG_LEVEL_INF);
 
@@ -14,8 +17,11 @@ LOG_MODULE_REGISTER(FS_CHECK, LOG_LEVEL_INF);
 #define STORAGE_PARTITION_ID FIXED_PARTITION_ID(filesystem_partition)
 
 // 定义 LittleFS 的配置结构
+// read/prog/cache/lookahead 大小和 block_cycles 取自 Kconfig (见 prj.conf 中的 LittleFS 调优参数)
 FS_LITTLEFS_DECLARE_DEFAULT_CONFIG(lfs_data);
 
+static uint32_t mount_time_us;
+
 static struct fs_mount_t fs_mnt = {
     .type = FS_LITTLEFS,
     .fs_data = &lfs_data,
@@ -25,27 +31,44 @@ static struct fs_mount_t fs_mnt = {
 
 /**
  * @brief 文件系统自检函数
- * 执行挂载和一次性读写测试
+ * 执行挂载 (记录耗时)，再做只读检查或一次性读写测试
  */
 void fs_check_thread_entry(void *p1, void *p2, void *p3)
 {
     int ret;
-    struct fs_file_t file;
-    const char *test_file_path = "/lfs/boot_test.txt";
-    const char *test_string = "FS Self-Test Passed";
-    char read_buf[32] = {0};
 
     LOG_INF("=== 开始文件系统硬件自检 ===");
 
-    /* 1. 尝试挂载 */
+    /* 1. 尝试挂载 (挂载成功即置位 BOOT_READY_FS，依赖文件系统的线程等待该事件) */
+    uint32_t t0 = k_cycle_get_32();
+
+    boot_prof_begin(BOOT_STEP_FS);
     ret = fs_mount(&fs_mnt);
+    mount_time_us = (uint32_t)k_cyc_to_us_floor64(k_cycle_get_32() - t0);
+    boot_prof_end(BOOT_STEP_FS, ret);
     if (ret < 0) {
         // 如果是 -84 (Corrupted)，Zephyr 的 littlefs 插件通常会自动格式化
         // 这里的错误处理主要针对硬件无法连接等严重问题
         LOG_ERR("文件系统挂载失败: %d", ret);
         return; 
     }
-    LOG_INF("1. 挂载成功: %s", fs_mnt.mnt_point);
+    LOG_INF("1. 挂载成功: %s (耗时 %u us)", fs_mnt.mnt_point, mount_time_us);
+
+#if !IS_ENABLED(CONFIG_APP_FS_BOOT_WRITE_SELF_TEST)
+    /* 只读检查：读取卷信息即可确认文件系统可用 */
+    struct fs_statvfs st;
+
+    ret = fs_statvfs(fs_mnt.mnt_point, &st);
+    if (ret == 0) {
+        LOG_INF("2. 卷信息: 块大小 %lu, 空闲 %lu / %lu 块", st.f_frsize, st.f_bfree, st.f_blocks);
+    } else {
+        LOG_ERR("2. 读取卷信息失败: %d", ret);
+    }
+#else
+    struct fs_file_t file;
+    const char *test_file_path = "/lfs/boot_test.txt";
+    const char *test_string = "FS Self-Test Passed";
+    char read_buf[32] = {0};
 
     /* 2. 基础读写测试 */
     fs_file_t_init(&file);
@@ -73,6 +96,7 @@ void fs_check_thread_entry(void *p1, void *p2, void *p3)
             }
         }
     }
+#endif /* CONFIG_APP_FS_BOOT_WRITE_SELF_TEST */
 
     /* 3. 线程退出 */
     LOG_INF("自检线程任务完成，正在退出并释放资源...");
@@ -81,9 +105,15 @@ void fs_check_thread_entry(void *p1, void *p2, void *p3)
     return; 
 }
 
+uint32_t fs_mount_time_us(void)
+{
+    return mount_time_us;
+}
+
 /* ---------------- 2. 线程定义 ---------------- */
-// 设置较高的优先级 (例如 5)，确保它在存储和显示线程之前完成自检
-#define FS_CHECK_PRIORITY 5
+// 优先级低于传感器和显示线程，挂载不再抢占首帧显示的关键路径；
+// 高于存储线程 (12)，依赖文件系统的线程通过 BOOT_READY_FS 事件等待挂载完成
+#define FS_CHECK_PRIORITY 11
 #define FS_CHECK_STACK_SIZE 2048
 
 K_THREAD_DEFINE(fs_check_tid, FS_CHECK_STACK_SIZE,
@@ -0,0 +1,270 @@
+/*
+ * application/src/glyph_cache.c
+ * 字形位图 LRU 缓存：替换字体的 get_glyph_bitmap，缓存展开后的 A8 位图
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/dlist.h>
+#include <zephyr/sys/sys_heap.h>
+#include <zephyr/linker/section_tags.h>
+#include <zephyr/logging/log.h>
+#include <string.h>
+
+#include "glyph_cache.h"
+
+LOG_MODULE_REGISTER(GLYPH_CACHE, LOG_LEVEL_INF);
+
+typedef const void *(*get_bitmap_fn)(lv_font_glyph_dsc_t *, lv_draw_buf_t *);
+
+struct glyph_entry {
+    sys_dnode_t node;        // LRU 链表，头部为最近使用
+    const lv_font_t *font;
+    uint32_t gid;
+    uint32_t len;
+    uint8_t *data;
+};
+
+struct font_slot {
+    const lv_font_t *font;
+    get_bitmap_fn orig;
+};
+
+/* 位图数据放在 SRAM1，与两块绘图缓冲同一区域 (段不会被清零，由 sys_heap 初始化) */
+static uint8_t pool[GLYPH_CACHE_BYTES] Z_GENERIC_SECTION(SRAM1) __aligned(8);
+static struct sys_heap heap;
+
+static struct glyph_entry entries[GLYPH_CACHE_SLOTS];
+static sys_dlist_t lru;
+static sys_dlist_t free_list;
+
+static struct font_slot fonts[GLYPH_CACHE_MAX_FONTS];
+static lv_font_t wrapped[GLYPH_CACHE_MAX_FONTS];
+static int font_count;
+
+static struct glyph_cache_stats stats;
+static bool inited;
+static K_MUTEX_DEFINE(cache_lock);
+
+static void cache_reset(void)
+{
+    sys_heap_init(&heap, pool, sizeof(pool));
+    sys_dlist_init(&lru);
+    sys_dlist_init(&free_list);
+    for (int i = 0; i < GLYPH_CACHE_SLOTS; i++) {
+        sys_dlist_append(&free_list, &entries[i].node);
+    }
+    stats.entries = 0;
+    stats.used_bytes = 0;
+}
+
+static void evict_tail(void)
+{
+    struct glyph_entry *e = CONTAINER_OF(sys_dlist_peek_tail(&lru), struct glyph_entry, node);
+
+    sys_dlist_remove(&e->node);
+    sys_heap_free(&heap, e->data);
+    stats.used_bytes -= e->len;
+    stats.entries--;
+    stats.evictions++;
+    sys_dlist_append(&free_list, &e->node);
+}
+
+static struct glyph_entry *lookup(const lv_font_t *font, uint32_t gid)
+{
+    struct glyph_entry *e;
+
+    SYS_DLIST_FOR_EACH_CONTAINER(&lru, e, node) {
+        if (e->font == font && e->gid == gid) {
+            return e;
+        }
+    }
+    return NULL;
+}
+
+static void insert(const lv_font_t *font, uint32_t gid, const uint8_t *src, uint32_t len)
+{
+    struct glyph_entry *e;
+    void *mem;
+
+    if (len > stats.budget / 2) {
+        // 单个字形占用超过一半预算时不缓存，避免一次冲掉全部常用字形
+        stats.uncached++;
+        return;
+    }
+
+    while (!sys_dlist_is_empty(&lru) &&
+           (sys_dlist_is_empty(&free_list) || stats.used_bytes + len > stats.budget)) {
+        evict_tail();
+    }
+
+    mem = sys_heap_alloc(&heap, len);
+    while (mem == NULL && !sys_dlist_is_empty(&lru)) {
+        evict_tail();      // 碎片导致分配失败时继续淘汰
+        mem = sys_heap_alloc(&heap, len);
+    }
+    if (mem == NULL) {
+        stats.uncached++;
+        return;
+    }
+
+    e = CONTAINER_OF(sys_dlist_get(&free_list), struct glyph_entry, node);
+    e->font = font;
+    e->gid = gid;
+    e->len = len;
+    e->data = mem;
+    memcpy(mem, src, len);
+    sys_dlist_prepend(&lru, &e->node);
+    stats.used_bytes += len;
+    stats.entries++;
+}
+
+static get_bitmap_fn orig_of(const lv_font_t *font)
+{
+    for (int i = 0; i < font_count; i++) {
+        if (fonts[i].font == font) {
+            return fonts[i].orig;
+        }
+    }
+    return NULL;
+}
+
+static const void *cached_get_bitmap(lv_font_glyph_dsc_t *g_dsc, lv_draw_buf_t *draw_buf)
+{
+    const lv_font_t *font = g_dsc->resolved_font;
+    get_bitmap_fn orig = orig_of(font);
+    uint32_t gid = g_dsc->gid.index;
+    struct glyph_entry *e;
+    const void *ret;
+
+    if (orig == NULL) {
+        return NULL;
+    }
+
+    k_mutex_lock(&cache_lock, K_FOREVER);
+    e = (draw_buf != NULL) ? lookup(font, gid) : NULL;
+    if (e != NULL && e->len == draw_buf->header.stride * g_dsc->box_h) {
+        memcpy(draw_buf->data, e->data, e->len);
+        sys_dlist_remove(&e->node);
+        sys_dlist_prepend(&lru, &e->node);
+        stats.hits++;
+        k_mutex_unlock(&cache_lock);
+        return draw_buf;
+    }
+    stats.misses++;
+    k_mutex_unlock(&cache_lock);
+
+    /* 未命中：调用原回调从 Flash 读取并展开 (不持锁，期间可能访问 XIP 窗口) */
+    ret = orig(g_dsc, draw_buf);
+
+    /* 只缓存展开到 draw_buf 中的位图；返回其他指针的 (如矢量字体) 不处理 */
+    if (ret == draw_buf && draw_buf != NULL) {
+        k_mutex_lock(&cache_lock, K_FOREVER);
+        e = lookup(font, gid);
+        if (e != NULL) {
+            // 同一字形尺寸变了 (stride 不同)，旧数据作废
+            sys_dlist_remove(&e->node);
+            sys_heap_free(&heap, e->data);
+            stats.used_bytes -= e->len;
+            stats.entries--;
+            sys_dlist_append(&free_list, &e->node);
+        }
+        insert(font, gid, draw_buf->data, draw_buf->header.stride * g_dsc->box_h);
+        k_mutex_unlock(&cache_lock);
+    } else {
+        k_mutex_lock(&cache_lock, K_FOREVER);
+        stats.uncached++;
+        k_mutex_unlock(&cache_lock);
+    }
+    return ret;
+}
+
+static int attach_locked(lv_font_t *font)
+{
+    if (!inited) {
+        stats.budget = GLYPH_CACHE_BYTES;
+        cache_reset();
+        inited = true;
+    }
+    if (font->get_glyph_bitmap == cached_get_bitmap) {
+        return 0;
+    }
+    if (font_count == GLYPH_CACHE_MAX_FONTS) {
+        return -ENOMEM;
+    }
+    fonts[font_count].font = font;
+    fonts[font_count].orig = font->get_glyph_bitmap;
+    font_count++;
+    font->get_glyph_bitmap = cached_get_bitmap;
+    return 0;
+}
+
+int glyph_cache_attach(lv_font_t *font)
+{
+    int ret;
+
+    k_mutex_lock(&cache_lock, K_FOREVER);
+    ret = attach_locked(font);
+    k_mutex_unlock(&cache_lock);
+    return ret;
+}
+
+const lv_font_t *glyph_cache_wrap(const lv_font_t *font)
+{
+    const lv_font_t *ret = font;
+
+    k_mutex_lock(&cache_lock, K_FOREVER);
+    for (int i = 0; i < font_count; i++) {
+        /* 已经接管的 RAM 字体，或者之前为同一个常量字体建立过的副本 */
+        if (fonts[i].font == font) {
+            goto out;
+        }
+        if (fonts[i].font == &wrapped[i] && wrapped[i].dsc == font->dsc) {
+            ret = &wrapped[i];
+            goto out;
+        }
+    }
+    if (font_count < GLYPH_CACHE_MAX_FONTS) {
+        wrapped[font_count] = *font;
+        ret = &wrapped[font_count];
+        attach_locked(&wrapped[font_count]);
+    } else {
+        LOG_WRN("接管的字体已满，%p 不经过缓存", (void *)font);
+    }
+
+out:
+    k_mutex_unlock(&cache_lock);
+    return ret;
+}
+
+void glyph_cache_set_budget(uint32_t bytes)
+{
+    k_mutex_lock(&cache_lock, K_FOREVER);
+    stats.budget = MIN(bytes, GLYPH_CACHE_BYTES);
+    while (stats.used_bytes > stats.budget) {
+        evict_tail();
+    }
+    k_mutex_unlock(&cache_lock);
+}
+
+void glyph_cache_clear(void)
+{
+    k_mutex_lock(&cache_lock, K_FOREVER);
+    if (inited) {
+        cache_reset();
+    }
+    stats.hits = 0;
+    stats.misses = 0;
+    stats.evictions = 0;
+    stats.uncached = 0;
+    k_mutex_unlock(&cache_lock);
+}
+
+void glyph_cache_get_stats(struct glyph_cache_stats *out)
+{
+    k_mutex_lock(&cache_lock, K_FOREVER);
+    *out = stats;
+    if (!inited) {
+        out->budget = GLYPH_CACHE_BYTES;
+    }
+    k_mutex_unlock(&cache_lock);
+}
@@ -0,0 +1,55 @@
+/*
+ * application/src/glyph_cache_shell.c
+ * 字形缓存 Shell 命令：glyph stats / budget / clear
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+#include <stdlib.h>
+
+#include "glyph_cache.h"
+
+static int cmd_glyph_stats(const struct shell *sh, size_t argc, char **argv)
+{
+    struct glyph_cache_stats s;
+    uint32_t lookups;
+
+    glyph_cache_get_stats(&s);
+    lookups = s.hits + s.misses;
+    shell_print(sh, "命中 %u / 未命中 %u (命中率 %u%%), 淘汰 %u, 未缓存 %u", s.hits, s.misses,
+                lookups ? s.hits * 100 / lookups : 0, s.evictions, s.uncached);
+    shell_print(sh, "已缓存 %u 个字形, %u / %u 字节 (缓存区 %u 字节, SRAM1)", s.entries,
+                s.used_bytes, s.budget, GLYPH_CACHE_BYTES);
+    return 0;
+}
+
+static int cmd_glyph_budget(const struct shell *sh, size_t argc, char **argv)
+{
+    long bytes = strtol(argv[1], NULL, 0);
+
+    if (bytes < 0) {
+        shell_error(sh, "预算无效");
+        return -EINVAL;
+    }
+    glyph_cache_set_budget(bytes);
+    if (bytes > GLYPH_CACHE_BYTES) {
+        shell_print(sh, "超过缓存区大小，按 %u 字节", GLYPH_CACHE_BYTES);
+    }
+    return 0;
+}
+
+static int cmd_glyph_clear(const struct shell *sh, size_t argc, char **argv)
+{
+    glyph_cache_clear();
+    shell_print(sh, "已清空");
+    return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_glyph,
+    SHELL_CMD(stats, NULL, "命中/未命中与占用", cmd_glyph_stats),
+    SHELL_CMD_ARG(budget, NULL, "设置字节预算 (0 相当于关闭缓存)", cmd_glyph_budget, 2, 0),
+    SHELL_CMD(clear, NULL, "清空缓存和计数", cmd_glyph_clear),
+    SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(glyph, &sub_glyph, "字形位图缓存", NULL);
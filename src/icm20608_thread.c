@@ -8,6 +8,10 @@
 #include <zephyr/logging/log.h>
 #include "icm20608.h"
 #include "data_center.h"
+#include "imu_recorder.h"
+#include "telemetry.h"
+#include "boot_prof.h"
+#include "display_thread.h"
 
 LOG_MODULE_REGISTER(ICM_TASK, LOG_LEVEL_INF);
 
@@ -25,12 +29,15 @@ static struct gpio_callback icm_gpio_cb;
 
 /* 信号量：中断通知线程读取 */
 static K_SEM_DEFINE(icm_sem, 0, 1); 
+/* 数据就绪中断计数：与实际读取次数比较即可知道漏读了多少帧 */
+static atomic_t icm_irq_count;
 /* 定义消息队列 */
 /* 参数：队列名, 数据大小, 最大消息数(1代表只保留最新), 对齐字节 */
 K_MSGQ_DEFINE(imu_msgq, sizeof(icm20608_data_t), 1, 4);
 
 /* 中断处理函数 */
 void icm_isr_handler(const struct device *port, struct gpio_callback *cb, uint32_t pins) {
+    atomic_inc(&icm_irq_count);
     k_sem_give(&icm_sem);
 }
 #endif
@@ -39,9 +46,19 @@ void icm20608_thread_entry(void *p1, void *p2, void *p3)
 {
     int ret;
     icm20608_data_t sensor_data;
+    int16_t raw[ICM20608_RAW_WORDS];
+    uint16_t cur_odr = ICM20608_DEFAULT_ODR_HZ;      // 最近一次请求的 ODR
+    uint16_t applied_odr = ICM20608_DEFAULT_ODR_HZ;  // 驱动实际生效的 ODR (整数分频后)
+    uint16_t want_odr;
+    bool streaming;
+    uint32_t irq_seen = 0;
+    int64_t last_publish = 0;
+    int64_t last_wake = 0;
 
     LOG_INF("ICM20608 Thread starting...");
 
+    boot_prof_begin(BOOT_STEP_ICM20608);
+
     /* ========================================================== */
     /* 模式选择：请根据实际情况注释掉不需要的一种 */
     
@@ -53,10 +70,12 @@ void icm20608_thread_entry(void *p1, void *p2, void *p3)
     ret = icm20608_init_interrupt(&dev_i2c, &dev_int, &icm_gpio_cb, icm_isr_handler);
     #else
     LOG_ERR("DeviceTree overlay lacks 'int-gpios'. Cannot use Interrupt mode.");
+    boot_prof_end(BOOT_STEP_ICM20608, -ENOTSUP);
     return;
     #endif
     /* ========================================================== */
 
+    boot_prof_end(BOOT_STEP_ICM20608, ret);
     if (ret != 0) {
         LOG_ERR("ICM20608 Init failed! Error code: %d", ret);
         return;
@@ -67,23 +86,60 @@ void icm20608_thread_entry(void *p1, void *p2, void *p3)
         #if DT_NODE_HAS_PROP(ICM_NODE, int_gpios)
         k_sem_take(&icm_sem, K_FOREVER);
         #endif 
+
+        /* 录制/遥测期间切换到它们要求的 ODR，结束后恢复默认 */
+        want_odr = MAX(imu_recorder_wanted_odr(), telemetry_wanted_odr());
+        streaming = (want_odr != 0);
+        if (want_odr == 0) {
+            want_odr = ICM20608_DEFAULT_ODR_HZ;
+        }
+        if (want_odr != cur_odr) {
+            ret = icm20608_set_odr(&dev_i2c, want_odr);
+            if (ret > 0) {
+                cur_odr = want_odr;
+                applied_odr = (uint16_t)ret;
+            }
+        }
         
-        // 读取并打印
-        ret = icm20608_read_data(&dev_i2c, &sensor_data);
+        // 读取原始数据，先交给录制器 (只做拷贝，不阻塞)
+        ret = icm20608_read_raw(&dev_i2c, raw);
         if (ret == 0) {
-            LOG_DBG("ACC: X=%.2f Y=%.2f Z=%.2f | GYRO: X=%.2f Y=%.2f Z=%.2f | Temp: %.2f",
-                        (double)sensor_data.accel_x, (double)sensor_data.accel_y, (double)sensor_data.accel_z,
-                        (double)sensor_data.gyro_x, (double)sensor_data.gyro_y, (double)sensor_data.gyro_z,
-                        (double)sensor_data.temp);
-
-            // 将数据放入消息队列供其他模块使用
-            k_msgq_put(&imu_msgq, &sensor_data, K_NO_WAIT);
-            // 同时更新数据中心的全局状态
-            data_center_update_imu(&sensor_data);
+            uint32_t missed = 0;
+
+            #if DT_NODE_HAS_PROP(ICM_NODE, int_gpios)
+            uint32_t irqs = (uint32_t)atomic_get(&icm_irq_count);
+
+            missed = (irq_seen != 0 && irqs - irq_seen > 1) ? irqs - irq_seen - 1 : 0;
+            irq_seen = irqs;
+            #endif
+            imu_recorder_feed(raw, missed, applied_odr);
+            telemetry_push_imu(raw);
+
+            /* 高速录制时，显示和数据中心仍按原来的节奏 (约 50Hz) 更新 */
+            if (k_uptime_get() - last_publish >= 20) {
+                last_publish = k_uptime_get();
+                icm20608_convert(raw, &sensor_data);
+                LOG_DBG("ACC: X=%.2f Y=%.2f Z=%.2f | GYRO: X=%.2f Y=%.2f Z=%.2f | Temp: %.2f",
+                            (double)sensor_data.accel_x, (double)sensor_data.accel_y, (double)sensor_data.accel_z,
+                            (double)sensor_data.gyro_x, (double)sensor_data.gyro_y, (double)sensor_data.gyro_z,
+                            (double)sensor_data.temp);
+
+                // 将数据放入消息队列供其他模块使用
+                k_msgq_put(&imu_msgq, &sensor_data, K_NO_WAIT);
+                // 显示线程按界面需要的频率唤醒，中间的采样被队列中的新值覆盖
+                if (last_publish - last_wake >= display_imu_period_ms()) {
+                    last_wake = last_publish;
+                    display_wake(DISPLAY_EVT_SENSOR);
+                }
+                // 同时更新数据中心的全局状态
+                data_center_update_imu(&sensor_data);
+            }
         }
 
-        // 轮询模式下必须有延时，防止串口刷屏；中断模式下该延时可极大减小或注释掉
-        k_msleep(20);
+        // 轮询模式下必须有延时，防止串口刷屏；录制/遥测期间不休眠，每个数据就绪中断都要读取
+        if (!streaming) {
+            k_msleep(20);
+        }
     }
 }
 
@@ -0,0 +1,133 @@
+/*
+ * application/src/imu_rec_shell.c
+ * IMU 录制 Shell 命令：imurec start / stop / arm / status / dump / clear
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+#include <stdlib.h>
+
+#include "imu_recorder.h"
+#include "flash_ring.h"
+
+/* dump 使用的读缓冲区：一条环形日志记录 */
+static uint8_t dump_buf[FLASH_RING_MAX_RECORD];
+
+static uint32_t arg_u32(size_t argc, char **argv, int idx, uint32_t def)
+{
+    return (argc > idx) ? strtoul(argv[idx], NULL, 10) : def;
+}
+
+static int cmd_imurec_start(const struct shell *sh, size_t argc, char **argv)
+{
+    uint32_t seconds = arg_u32(argc, argv, 1, IMU_REC_DEFAULT_SECONDS);
+    uint32_t odr = arg_u32(argc, argv, 2, IMU_REC_DEFAULT_ODR_HZ);
+    int ret = imu_recorder_start(seconds, odr);
+
+    if (ret == -EBUSY) {
+        shell_error(sh, "正在录制中");
+    } else {
+        shell_print(sh, "录制请求已提交: %u 秒 @ %u Hz", seconds, odr);
+    }
+    return ret;
+}
+
+static int cmd_imurec_stop(const struct shell *sh, size_t argc, char **argv)
+{
+    imu_recorder_stop();
+    return 0;
+}
+
+static int cmd_imurec_arm(const struct shell *sh, size_t argc, char **argv)
+{
+    uint32_t mg = strtoul(argv[1], NULL, 10);
+    uint32_t seconds = arg_u32(argc, argv, 2, IMU_REC_DEFAULT_SECONDS);
+    uint32_t odr = arg_u32(argc, argv, 3, IMU_REC_DEFAULT_ODR_HZ);
+    int ret = imu_recorder_arm(MIN(mg, 1000), seconds, odr);
+
+    if (ret == -EBUSY) {
+        shell_error(sh, "正在录制中");
+        return ret;
+    }
+    if (mg == 0) {
+        shell_print(sh, "运动触发已关闭");
+    } else {
+        shell_print(sh, "运动触发: |a| 偏离 1g 超过 %u mg 时录制 %u 秒 @ %u Hz", mg, seconds, odr);
+    }
+    return 0;
+}
+
+static int cmd_imurec_status(const struct shell *sh, size_t argc, char **argv)
+{
+    struct imu_recorder_stats st;
+
+    imu_recorder_get_stats(&st);
+    shell_print(sh, "状态: %s%s, 录制 #%u @ %u Hz", st.active ? "录制中" : "空闲",
+                st.armed ? " (运动触发已就绪)" : "", st.burst, st.odr_hz);
+    shell_print(sh, "样本: %u, 缓冲区满丢弃: %u, 漏读: %u", st.samples, st.lost, st.missed);
+    shell_print(sh, "写入块: %u (每块 %u 个样本), 失败: %u", st.blocks,
+                (uint32_t)IMU_REC_BLOCK_SAMPLES, st.write_errors);
+
+    /* 乒乓缓冲下，写完一块的时间必须小于填满一块的时间 */
+    if (st.write_avg_us > 0) {
+        shell_print(sh, "单块写入: 平均 %u us, 最大 %u us", st.write_avg_us, st.write_max_us);
+        shell_print(sh, "可持续采样率: 平均 %u Hz, 最坏情况 %u Hz",
+                    (uint32_t)(IMU_REC_BLOCK_SAMPLES * 1000000ULL / st.write_avg_us),
+                    (uint32_t)(IMU_REC_BLOCK_SAMPLES * 1000000ULL / st.write_max_us));
+    }
+    return 0;
+}
+
+/* 输出指定录制 (默认最近一次) 的全部样本，CSV: seq,ax,ay,az,gx,gy,gz */
+static int cmd_imurec_dump(const struct shell *sh, size_t argc, char **argv)
+{
+    struct imu_recorder_stats st;
+    struct flash_ring_cursor cur;
+    const struct imu_block_hdr *hdr = (const struct imu_block_hdr *)dump_buf;
+    const struct imu_sample *s = (const struct imu_sample *)(dump_buf + sizeof(*hdr));
+    uint32_t burst, blocks = 0;
+    int len;
+
+    imu_recorder_get_stats(&st);
+    burst = arg_u32(argc, argv, 1, st.burst);
+
+    flash_ring_cursor_init(&cur);
+    while ((len = flash_ring_read(&cur, dump_buf, sizeof(dump_buf))) > 0) {
+        if (len < sizeof(*hdr) || hdr->magic != IMU_REC_MAGIC || hdr->burst != burst) {
+            continue;
+        }
+        if (blocks++ == 0) {
+            shell_print(sh, "# burst %u, %u Hz", burst, hdr->odr_hz);
+        }
+        for (uint16_t i = 0; i < hdr->count; i++) {
+            shell_print(sh, "%u,%d,%d,%d,%d,%d,%d", hdr->first_seq + i,
+                        s[i].accel[0], s[i].accel[1], s[i].accel[2],
+                        s[i].gyro[0], s[i].gyro[1], s[i].gyro[2]);
+        }
+    }
+
+    if (len == -ESTALE) {
+        shell_error(sh, "读取期间数据被覆盖");
+        return len;
+    }
+    shell_print(sh, "# %u 块", blocks);
+    return 0;
+}
+
+static int cmd_imurec_clear(const struct shell *sh, size_t argc, char **argv)
+{
+    return flash_ring_clear();
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_imurec,
+    SHELL_CMD_ARG(start, NULL, "开始录制: start [秒] [ODR Hz]", cmd_imurec_start, 1, 2),
+    SHELL_CMD(stop, NULL, "停止录制", cmd_imurec_stop),
+    SHELL_CMD_ARG(arm, NULL, "运动触发: arm <阈值 mg, 0 关闭> [秒] [ODR Hz]",
+                  cmd_imurec_arm, 2, 2),
+    SHELL_CMD(status, NULL, "录制状态与写入耗时统计", cmd_imurec_status),
+    SHELL_CMD_ARG(dump, NULL, "以 CSV 输出录制数据: dump [录制编号]", cmd_imurec_dump, 1, 1),
+    SHELL_CMD(clear, NULL, "擦除全部录制数据", cmd_imurec_clear),
+    SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(imurec, &sub_imurec, "IMU 高速录制命令", NULL);
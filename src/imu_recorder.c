@@ -0,0 +1,342 @@
+/*
+ * application/src/imu_recorder.c
+ * IMU 高速突发录制：乒乓缓冲 + 低优先级写线程
+ *
+ * 缓冲区所有权：
+ *   - fill_idx 指向的缓冲区归 IMU 线程 (生产者) 独占，只有它写入样本；
+ *   - buf_busy 中置位的缓冲区归写线程，写完后由写线程清位归还。
+ * 生产者从不等待：没有空闲缓冲区时直接丢弃样本并计数。
+ *
+ * 状态只用原子操作切换，控制侧 (Shell) 只在 REC_IDLE 下改写录制参数；
+ * 生产者不拿锁，运动触发也只是一次 CAS，ctrl_lock 只在控制侧之间互斥。
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/logging/log.h>
+#include <string.h>
+
+#include "imu_recorder.h"
+#include "flash_ring.h"
+
+LOG_MODULE_REGISTER(IMU_REC, LOG_LEVEL_INF);
+
+/* ---------------- 配置参数 ---------------- */
+#define IMU_REC_WRITER_STACK_SIZE  1024
+#define IMU_REC_WRITER_PRIORITY    12     // 与存储线程同级，低于所有采集线程
+#define IMU_REC_BUF_COUNT          2
+#define ACCEL_LSB_PER_G            16384  // ±2g 量程
+
+enum rec_state {
+    REC_IDLE,
+    REC_ARMED,        // 参数已设置，等待运动触发
+    REC_STARTING,     // 控制侧已设置参数，等待生产者接管
+    REC_RECORDING,
+};
+
+struct rec_buf {
+    struct imu_block_hdr hdr;
+    struct imu_sample samples[IMU_REC_BLOCK_SAMPLES];
+};
+
+BUILD_ASSERT(sizeof(struct rec_buf) <= FLASH_RING_MAX_RECORD);
+
+static struct rec_buf bufs[IMU_REC_BUF_COUNT];
+static atomic_t buf_busy;          // bit i: 缓冲区 i 正在等待/正在写入 Flash
+static int fill_idx = -1;          // 生产者当前填充的缓冲区，-1 表示没有
+K_MSGQ_DEFINE(rec_write_q, sizeof(uint8_t), IMU_REC_BUF_COUNT, 1);
+
+static atomic_t state = ATOMIC_INIT(REC_IDLE);
+static atomic_t stop_req;
+static atomic_t triggered;         // 运动触发的录制，由写线程打印日志
+static K_MUTEX_DEFINE(ctrl_lock);
+
+/* 本次录制参数 (REC_STARTING 之前由控制侧写入) */
+static uint16_t rec_burst;
+static uint16_t rec_odr;           // 请求的 ODR，传感器只支持 1kHz 的整数分频，实际值可能不同
+static uint32_t rec_seconds;
+
+/* 生产者接管后写入 */
+static uint16_t rec_odr_applied;   // 驱动实际生效的 ODR (块头记录的是每块采集时的实际值)
+static uint32_t rec_total;         // 本次录制的目标样本数
+
+/* 运动触发阈值 (REC_ARMED 之前由控制侧写入) */
+static uint16_t arm_mg;
+
+/* 统计 (生产者/写线程各自只写自己的字段) */
+static uint32_t seq;               // 本次录制的样本序号
+static uint32_t stat_lost;
+static uint32_t stat_missed;
+static uint32_t stat_blocks;
+static uint32_t stat_errors;
+static uint64_t stat_write_us_total;
+static uint32_t stat_write_us_max;
+
+/* 录制编号取环形日志当前扇区序号的低 16 位，跨重启也基本不会重复 */
+static uint16_t next_burst_id(void)
+{
+    struct flash_ring_info info;
+    uint16_t id;
+
+    flash_ring_get_info(&info);
+    id = (uint16_t)info.head_seq;
+    return (id == rec_burst) ? id + 1 : id;
+}
+
+static void set_params(uint32_t seconds, uint16_t odr_hz)
+{
+    seconds = CLAMP(seconds, 1, IMU_REC_MAX_SECONDS);
+    rec_burst = next_burst_id();
+    rec_odr = odr_hz;
+    rec_seconds = seconds;
+}
+
+/* ---------------- 生产者 (IMU 线程上下文) ---------------- */
+
+static bool buf_claim(uint16_t odr_hz)
+{
+    for (int i = 0; i < IMU_REC_BUF_COUNT; i++) {
+        if (!atomic_test_bit(&buf_busy, i)) {
+            struct imu_block_hdr *hdr = &bufs[i].hdr;
+
+            hdr->magic = IMU_REC_MAGIC;
+            hdr->burst = rec_burst;
+            hdr->count = 0;
+            hdr->first_seq = seq;
+            hdr->uptime_ms = k_uptime_get_32();
+            hdr->odr_hz = odr_hz;
+            hdr->reserved = 0xFFFF;
+            fill_idx = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void buf_submit(void)
+{
+    uint8_t idx = (uint8_t)fill_idx;
+
+    /* 队列深度等于缓冲区个数，这里不会失败 */
+    atomic_set_bit(&buf_busy, idx);
+    k_msgq_put(&rec_write_q, &idx, K_NO_WAIT);
+    fill_idx = -1;
+}
+
+/* from: 接管前的状态；与控制侧竞争失败时返回 false */
+static bool rec_begin(atomic_val_t from, uint16_t odr_hz)
+{
+    /* 时长按实际生效的 ODR 折算成样本数 */
+    rec_odr_applied = odr_hz;
+    rec_total = rec_seconds * odr_hz;
+    seq = 0;
+    stat_lost = 0;
+    stat_missed = 0;
+    fill_idx = -1;
+    atomic_clear(&stop_req);
+    if (!atomic_cas(&state, from, REC_RECORDING)) {
+        return false;
+    }
+    LOG_INF("开始录制 #%u: %u 个样本 @ %u Hz (请求 %u Hz)", rec_burst, rec_total,
+            rec_odr_applied, rec_odr);
+    return true;
+}
+
+static void rec_end(void)
+{
+    /* 最后一块不满也要交给写线程；生产者持有的缓冲区一定可以提交 */
+    if (fill_idx >= 0 && bufs[fill_idx].hdr.count > 0) {
+        buf_submit();
+    }
+    fill_idx = -1;
+    atomic_set(&state, REC_IDLE);
+    LOG_INF("录制 #%u 结束: 样本 %u, 丢弃 %u, 漏读 %u", rec_burst, seq, stat_lost, stat_missed);
+}
+
+/* 加速度模长偏离 1g 超过阈值即认为发生运动，全部用整数平方比较 */
+static bool motion_detected(const int16_t raw[7], uint16_t threshold_mg)
+{
+    int64_t mag2 = (int64_t)raw[0] * raw[0] + (int64_t)raw[1] * raw[1] +
+                   (int64_t)raw[2] * raw[2];
+    int64_t lo = (int64_t)ACCEL_LSB_PER_G * MAX(1000 - threshold_mg, 0) / 1000;
+    int64_t hi = (int64_t)ACCEL_LSB_PER_G * (1000 + threshold_mg) / 1000;
+
+    return mag2 < lo * lo || mag2 > hi * hi;
+}
+
+void imu_recorder_feed(const int16_t raw[7], uint32_t missed, uint16_t odr_hz)
+{
+    struct rec_buf *b;
+
+    switch (atomic_get(&state)) {
+    case REC_IDLE:
+        return;
+    case REC_ARMED:
+        if (!motion_detected(raw, arm_mg)) {
+            return;
+        }
+        /* 单次触发：参数在 arm 时已设置好，CAS 接管后自动解除，需要时重新 arm */
+        if (!rec_begin(REC_ARMED, odr_hz)) {
+            return;
+        }
+        atomic_set(&triggered, 1);
+        missed = 0;
+        break;
+    case REC_STARTING:
+        /* 与 imu_recorder_stop() 竞争：停止请求先到则本次不开始 */
+        if (!rec_begin(REC_STARTING, odr_hz)) {
+            return;
+        }
+        missed = 0;
+        break;
+    default:
+        break;
+    }
+
+    /* 漏读的样本只跳过序号，块头的 first_seq 会反映出这个缺口 */
+    if (missed > 0) {
+        stat_missed += missed;
+        seq += missed;
+        if (fill_idx >= 0 && bufs[fill_idx].hdr.count > 0) {
+            buf_submit();
+        }
+    }
+
+    /*
+     * 块头只有一个 ODR：速率变化时 (运动触发后从默认 ODR 切到录制 ODR，
+     * 或遥测要求更高的 ODR) 先提交当前块，新样本从新块开始
+     */
+    if (fill_idx >= 0 && bufs[fill_idx].hdr.odr_hz != odr_hz) {
+        if (bufs[fill_idx].hdr.count > 0) {
+            buf_submit();
+        } else {
+            bufs[fill_idx].hdr.odr_hz = odr_hz;
+        }
+    }
+
+    if (fill_idx < 0 && !buf_claim(odr_hz)) {
+        stat_lost++;
+    } else {
+        b = &bufs[fill_idx];
+        memcpy(b->samples[b->hdr.count].accel, &raw[0], sizeof(int16_t) * 3);
+        memcpy(b->samples[b->hdr.count].gyro, &raw[4], sizeof(int16_t) * 3);
+        if (++b->hdr.count == IMU_REC_BLOCK_SAMPLES) {
+            buf_submit();
+        }
+    }
+    seq++;
+
+    if (seq >= rec_total || atomic_get(&stop_req)) {
+        rec_end();
+    }
+}
+
+uint16_t imu_recorder_wanted_odr(void)
+{
+    atomic_val_t st = atomic_get(&state);
+
+    return (st == REC_STARTING || st == REC_RECORDING) ? rec_odr : 0;
+}
+
+/* ---------------- 控制接口 ---------------- */
+
+int imu_recorder_start(uint32_t seconds, uint16_t odr_hz)
+{
+    int ret = 0;
+
+    k_mutex_lock(&ctrl_lock, K_FOREVER);
+    /* 手动启动取代尚未触发的 arm；先解除再改参数，避免与生产者的触发竞争 */
+    atomic_cas(&state, REC_ARMED, REC_IDLE);
+    if (atomic_get(&state) != REC_IDLE) {
+        ret = -EBUSY;
+    } else {
+        set_params(seconds, odr_hz);
+        atomic_set(&state, REC_STARTING);
+    }
+    k_mutex_unlock(&ctrl_lock);
+    return ret;
+}
+
+void imu_recorder_stop(void)
+{
+    /* 收尾 (提交最后一块) 由生产者在下一个样本到来时完成 */
+    if (!atomic_cas(&state, REC_STARTING, REC_IDLE)) {
+        atomic_set(&stop_req, 1);
+    }
+}
+
+int imu_recorder_arm(uint16_t threshold_mg, uint32_t seconds, uint16_t odr_hz)
+{
+    int ret = 0;
+
+    k_mutex_lock(&ctrl_lock, K_FOREVER);
+    /* 重新 arm 或关闭：先解除，生产者看到 REC_IDLE 后不再读取参数 */
+    atomic_cas(&state, REC_ARMED, REC_IDLE);
+    if (atomic_get(&state) != REC_IDLE) {
+        ret = -EBUSY;
+    } else if (threshold_mg > 0) {
+        set_params(seconds, odr_hz);
+        arm_mg = threshold_mg;
+        atomic_set(&state, REC_ARMED);
+    }
+    k_mutex_unlock(&ctrl_lock);
+    return ret;
+}
+
+void imu_recorder_get_stats(struct imu_recorder_stats *stats)
+{
+    atomic_val_t st = atomic_get(&state);
+
+    stats->active = (st == REC_STARTING || st == REC_RECORDING);
+    stats->armed = (st == REC_ARMED);
+    stats->burst = rec_burst;
+    stats->odr_hz = rec_odr_applied;
+    stats->samples = seq;
+    stats->lost = stat_lost;
+    stats->missed = stat_missed;
+    stats->blocks = stat_blocks;
+    stats->write_errors = stat_errors;
+    stats->write_avg_us = stat_blocks ? (uint32_t)(stat_write_us_total / stat_blocks) : 0;
+    stats->write_max_us = stat_write_us_max;
+}
+
+/* ---------------- 写线程 ---------------- */
+
+void imu_rec_writer_entry(void *p1, void *p2, void *p3)
+{
+    uint8_t idx;
+    uint32_t t0, us;
+    int ret;
+
+    while (1) {
+        k_msgq_get(&rec_write_q, &idx, K_FOREVER);
+
+        struct rec_buf *b = &bufs[idx];
+
+        if (atomic_clear(&triggered)) {
+            LOG_INF("运动触发录制 #%u", b->hdr.burst);
+        }
+
+        size_t len = sizeof(b->hdr) + b->hdr.count * sizeof(struct imu_sample);
+
+        t0 = k_cycle_get_32();
+        ret = flash_ring_append(b, len);
+        us = (uint32_t)k_cyc_to_us_floor64(k_cycle_get_32() - t0);
+
+        if (ret == 0) {
+            stat_blocks++;
+            stat_write_us_total += us;
+            stat_write_us_max = MAX(stat_write_us_max, us);
+        } else {
+            stat_errors++;
+            LOG_ERR("写入录制块失败: %d", ret);
+        }
+
+        /* 归还缓冲区 */
+        atomic_clear_bit(&buf_busy, idx);
+    }
+}
+
+K_THREAD_DEFINE(imu_rec_writer_tid, IMU_REC_WRITER_STACK_SIZE,
+                imu_rec_writer_entry, NULL, NULL, NULL,
+                IMU_REC_WRITER_PRIORITY, 0, 0);
@@ -0,0 +1,337 @@
+/*
+ * application/src/key_gesture.c
+ * 摇杆按键手势：边沿队列 + 按时间戳驱动的状态机 (系统工作队列中的一个延时工作项)
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/input/input.h>
+#include <zephyr/logging/log.h>
+#include <errno.h>
+#include <stdio.h>
+
+#include "key_gesture.h"
+#include "key_input.h"
+#include "display_thread.h"
+#include "roll_plot.h"
+#include "auto_rotate.h"
+
+LOG_MODULE_REGISTER(KEY_GESTURE, LOG_LEVEL_INF);
+
+/* 四个按键在同一个 gpio-keys 节点下，别名与原来直接读 GPIO 时相同 */
+#define KEYS_NODE  DT_PARENT(DT_ALIAS(sw_up))
+
+BUILD_ASSERT(DT_NODE_HAS_COMPAT(KEYS_NODE, gpio_keys),
+             "sw-up 等按键需要是 gpio-keys 节点的子节点");
+BUILD_ASSERT((KEY_GESTURE_EDGE_LEN & (KEY_GESTURE_EDGE_LEN - 1)) == 0,
+             "KEY_GESTURE_EDGE_LEN 必须是 2 的幂");
+
+#define KEY_COUNT  4
+
+/* 下标与 KEY_BIT_* 的位号一致 */
+static const uint16_t key_codes[KEY_COUNT] = {
+    INPUT_KEY_UP, INPUT_KEY_DOWN, INPUT_KEY_LEFT, INPUT_KEY_RIGHT,
+};
+static const char *const key_names[KEY_COUNT] = {"UP", "DOWN", "LEFT", "RIGHT"};
+
+static const char *const gesture_names[KEY_GESTURE_COUNT] = {
+    [KEY_GESTURE_CLICK] = "click",
+    [KEY_GESTURE_DOUBLE_CLICK] = "double-click",
+    [KEY_GESTURE_LONG_PRESS] = "long-press",
+    [KEY_GESTURE_REPEAT] = "repeat",
+    [KEY_GESTURE_CHORD] = "chord",
+};
+
+/* ---------------- 边沿队列：输入回调写，状态机读 ---------------- */
+
+struct key_edge {
+    uint32_t t_ms;
+    uint8_t key;
+    bool pressed;
+};
+
+static struct key_edge edges[KEY_GESTURE_EDGE_LEN];
+static atomic_t edge_head;      // 只由输入回调写
+static atomic_t edge_tail;      // 只由状态机写
+static atomic_t edge_dropped;
+
+/* ---------------- 状态机 ---------------- */
+
+enum key_phase {
+    PH_IDLE,
+    PH_DOWN,          // 第一次按下，等待松开或长按超时
+    PH_WAIT_DOUBLE,   // 已松开，等待第二次按下或双击超时
+    PH_DOWN2,         // 第二次按下，松开即双击
+    PH_HELD,          // 长按已触发，按连发间隔产生 repeat
+    PH_CHORD,         // 属于组合键，松开前不再产生单键手势
+};
+
+struct key_fsm {
+    uint8_t phase;
+    uint16_t repeats;
+    uint32_t t_down;
+    uint32_t deadline;    // PH_DOWN / PH_WAIT_DOUBLE / PH_DOWN2 / PH_HELD 的下一个超时
+};
+
+static struct key_fsm fsm[KEY_COUNT];
+
+static void gesture_work_fn(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(gesture_work, gesture_work_fn);
+
+K_MSGQ_DEFINE(key_gesture_msgq, sizeof(struct key_gesture_evt), 8, 4);
+static atomic_t watching;
+
+static struct k_spinlock stats_lock;
+static struct key_gesture_stats stats;
+
+static inline bool time_reached(uint32_t now, uint32_t deadline)
+{
+    return (int32_t)(now - deadline) >= 0;
+}
+
+/* 原始按下/松开交给 LVGL keypad */
+static void forward_key(int i, bool pressed)
+{
+    struct key_event ev = { .code = key_codes[i], .pressed = pressed };
+
+    key_input_push(&ev);
+    display_wake(DISPLAY_EVT_INPUT);
+}
+
+/* 界面绑定的手势动作 (动作本身只提交请求，由显示线程执行) */
+static void gesture_bind(const struct key_gesture_evt *evt)
+{
+    if (evt->type == KEY_GESTURE_LONG_PRESS && evt->keys == KEY_BIT_UP) {
+        /* 长按返回键：进入/退出滚动光照图 */
+        roll_plot_request(!roll_plot_is_active());
+    } else if (evt->type == KEY_GESTURE_DOUBLE_CLICK && evt->keys == KEY_BIT_UP) {
+        /* 双击返回键：开关自动旋转 */
+        auto_rotate_enable(!auto_rotate_is_enabled());
+    } else if (evt->type == KEY_GESTURE_CHORD && evt->keys == (KEY_BIT_LEFT | KEY_BIT_RIGHT)) {
+        /* 左右同时按：顺时针旋转 90° */
+        auto_rotate_set((enum display_orientation)((auto_rotate_current() + 1) % 4));
+    }
+}
+
+static void emit(enum key_gesture type, uint8_t keys, uint16_t repeat, uint32_t t)
+{
+    struct key_gesture_evt evt = {
+        .type = type,
+        .keys = keys,
+        .repeat = repeat,
+        .t_ms = t,
+    };
+    k_spinlock_key_t key = k_spin_lock(&stats_lock);
+
+    stats.gestures[type]++;
+    k_spin_unlock(&stats_lock, key);
+
+    LOG_DBG("%s keys 0x%x", gesture_names[type], keys);
+    gesture_bind(&evt);
+    if (atomic_get(&watching)) {
+        k_msgq_put(&key_gesture_msgq, &evt, K_NO_WAIT);
+    }
+}
+
+/* 处理时刻 t 之前到期的超时 (连发可能一次补上多个) */
+static void fsm_advance(uint32_t t)
+{
+    for (int i = 0; i < KEY_COUNT; i++) {
+        struct key_fsm *k = &fsm[i];
+
+        while (k->phase != PH_IDLE && k->phase != PH_CHORD && time_reached(t, k->deadline)) {
+            switch (k->phase) {
+            case PH_DOWN2:
+                /* 第二次按下后按住：第一次按键算单击 */
+                emit(KEY_GESTURE_CLICK, BIT(i), 0, k->deadline);
+                __fallthrough;
+            case PH_DOWN:
+                emit(KEY_GESTURE_LONG_PRESS, BIT(i), 0, k->deadline);
+                k->phase = PH_HELD;
+                k->repeats = 0;
+                k->deadline += KEY_GESTURE_REPEAT_MS;
+                break;
+            case PH_HELD:
+                emit(KEY_GESTURE_REPEAT, BIT(i), ++k->repeats, k->deadline);
+                if (BIT(i) & KEY_GESTURE_REPEAT_KEYS) {
+                    forward_key(i, false);
+                    forward_key(i, true);
+                }
+                k->deadline += KEY_GESTURE_REPEAT_MS;
+                break;
+            case PH_WAIT_DOUBLE:
+                emit(KEY_GESTURE_CLICK, BIT(i), 0, k->deadline);
+                k->phase = PH_IDLE;
+                break;
+            default:
+                k->phase = PH_IDLE;
+                break;
+            }
+        }
+    }
+}
+
+static void fsm_press(int i, uint32_t t)
+{
+    struct key_fsm *k = &fsm[i];
+    uint8_t chord = 0;
+
+    /* 另一个键刚按下不久、还没有形成其他手势：组合键 */
+    for (int j = 0; j < KEY_COUNT; j++) {
+        if (j != i && fsm[j].phase == PH_DOWN && t - fsm[j].t_down <= KEY_GESTURE_CHORD_MS) {
+            chord |= BIT(j);
+        }
+    }
+    if (chord) {
+        for (int j = 0; j < KEY_COUNT; j++) {
+            if (chord & BIT(j)) {
+                fsm[j].phase = PH_CHORD;
+            }
+        }
+        k->phase = PH_CHORD;
+        emit(KEY_GESTURE_CHORD, chord | BIT(i), 0, t);
+        return;
+    }
+
+    k->phase = (k->phase == PH_WAIT_DOUBLE) ? PH_DOWN2 : PH_DOWN;
+    k->t_down = t;
+    k->deadline = t + KEY_GESTURE_LONG_MS;
+}
+
+static void fsm_release(int i, uint32_t t)
+{
+    struct key_fsm *k = &fsm[i];
+
+    switch (k->phase) {
+    case PH_DOWN:
+        k->phase = PH_WAIT_DOUBLE;
+        k->deadline = t + KEY_GESTURE_DOUBLE_MS;
+        break;
+    case PH_DOWN2:
+        emit(KEY_GESTURE_DOUBLE_CLICK, BIT(i), 0, t);
+        k->phase = PH_IDLE;
+        break;
+    default:
+        k->phase = PH_IDLE;
+        break;
+    }
+}
+
+static void gesture_work_fn(struct k_work *work)
+{
+    uint32_t t0 = k_cycle_get_32();
+    uint32_t n = 0;
+    uint32_t now;
+    int32_t next = -1;
+    atomic_val_t tail = atomic_get(&edge_tail);
+
+    /* 边沿按自己的时间戳处理：先补上该边沿之前到期的超时，工作队列晚运行不影响判定 */
+    while (tail != atomic_get(&edge_head)) {
+        struct key_edge e = edges[tail & (KEY_GESTURE_EDGE_LEN - 1)];
+
+        atomic_set(&edge_tail, ++tail);
+        fsm_advance(e.t_ms);
+        forward_key(e.key, e.pressed);
+        if (e.pressed) {
+            fsm_press(e.key, e.t_ms);
+        } else {
+            fsm_release(e.key, e.t_ms);
+        }
+        n++;
+    }
+
+    now = k_uptime_get_32();
+    fsm_advance(now);
+
+    /* 只在还有超时未到时重新调度，空闲时不运行 */
+    for (int i = 0; i < KEY_COUNT; i++) {
+        if (fsm[i].phase != PH_IDLE && fsm[i].phase != PH_CHORD) {
+            int32_t left = (int32_t)(fsm[i].deadline - now);
+
+            next = (next < 0) ? left : MIN(next, left);
+        }
+    }
+    if (next >= 0) {
+        k_work_reschedule(&gesture_work, K_MSEC(next));
+    }
+
+    uint32_t us = (uint32_t)k_cyc_to_us_ceil32(k_cycle_get_32() - t0);
+    k_spinlock_key_t key = k_spin_lock(&stats_lock);
+
+    stats.edges += n;
+    stats.runs++;
+    stats.max_run_us = MAX(stats.max_run_us, us);
+    k_spin_unlock(&stats_lock, key);
+}
+
+/* 输入回调：只记录带时间戳的边沿，判定全部在状态机中进行 */
+static void key_edge_cb(struct input_event *evt, void *user_data)
+{
+    atomic_val_t h = atomic_get(&edge_head);
+    int i;
+
+    ARG_UNUSED(user_data);
+
+    if (evt->type != INPUT_EV_KEY) {
+        return;
+    }
+    for (i = 0; i < KEY_COUNT && key_codes[i] != evt->code; i++) {
+    }
+    if (i == KEY_COUNT) {
+        return;
+    }
+    if ((uint32_t)(h - atomic_get(&edge_tail)) >= KEY_GESTURE_EDGE_LEN) {
+        atomic_inc(&edge_dropped);
+        return;
+    }
+
+    edges[h & (KEY_GESTURE_EDGE_LEN - 1)] = (struct key_edge){
+        .t_ms = k_uptime_get_32(),
+        .key = (uint8_t)i,
+        .pressed = (evt->value != 0),
+    };
+    /* atomic_set 带内存屏障：状态机看到新的 head 时，边沿内容已经写入 */
+    atomic_set(&edge_head, h + 1);
+    k_work_reschedule(&gesture_work, K_NO_WAIT);
+}
+
+INPUT_CALLBACK_DEFINE(DEVICE_DT_GET(KEYS_NODE), key_edge_cb, NULL);
+
+void key_gesture_watch(bool on)
+{
+    atomic_set(&watching, on);
+    if (!on) {
+        k_msgq_purge(&key_gesture_msgq);
+    }
+}
+
+int key_gesture_get(struct key_gesture_evt *evt, k_timeout_t timeout)
+{
+    return k_msgq_get(&key_gesture_msgq, evt, timeout) == 0 ? 0 : -EAGAIN;
+}
+
+void key_gesture_get_stats(struct key_gesture_stats *out)
+{
+    k_spinlock_key_t key = k_spin_lock(&stats_lock);
+
+    *out = stats;
+    k_spin_unlock(&stats_lock, key);
+    out->edges_dropped = (uint32_t)atomic_get(&edge_dropped);
+}
+
+const char *key_gesture_name(enum key_gesture type)
+{
+    return (type < KEY_GESTURE_COUNT) ? gesture_names[type] : "?";
+}
+
+void key_gesture_keys_str(uint8_t keys, char *buf, size_t len)
+{
+    size_t pos = 0;
+
+    buf[0] = '\0';
+    for (int i = 0; i < KEY_COUNT && pos < len; i++) {
+        if (keys & BIT(i)) {
+            pos += snprintf(buf + pos, len - pos, "%s%s", pos ? "+" : "", key_names[i]);
+        }
+    }
+}
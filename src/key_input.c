@@ -0,0 +1,58 @@
+/*
+ * application/src/key_input.c
+ * 交给 LVGL keypad 的按键事件：单生产者/单消费者无锁队列
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <errno.h>
+
+#include "key_input.h"
+
+LOG_MODULE_REGISTER(KEY_INPUT, LOG_LEVEL_INF);
+
+BUILD_ASSERT((KEY_INPUT_QUEUE_LEN & (KEY_INPUT_QUEUE_LEN - 1)) == 0,
+             "KEY_INPUT_QUEUE_LEN 必须是 2 的幂");
+
+static struct key_event ring[KEY_INPUT_QUEUE_LEN];
+static atomic_t head;       // 只由生产者 (手势状态机) 写
+static atomic_t tail;       // 只由消费者 (显示线程) 写
+static atomic_t dropped;
+
+int key_input_push(const struct key_event *ev)
+{
+    atomic_val_t h = atomic_get(&head);
+
+    if ((uint32_t)(h - atomic_get(&tail)) >= KEY_INPUT_QUEUE_LEN) {
+        atomic_inc(&dropped);
+        LOG_WRN("按键队列已满，丢弃事件 (code %u)", ev->code);
+        return -ENOSPC;
+    }
+
+    ring[h & (KEY_INPUT_QUEUE_LEN - 1)] = *ev;
+    /* atomic_set 带内存屏障：消费者看到新的 head 时，上面的事件内容已经写入 */
+    atomic_set(&head, h + 1);
+    return 0;
+}
+
+int key_input_get(struct key_event *ev)
+{
+    atomic_val_t t = atomic_get(&tail);
+
+    if (t == atomic_get(&head)) {
+        return -EAGAIN;
+    }
+    *ev = ring[t & (KEY_INPUT_QUEUE_LEN - 1)];
+    atomic_set(&tail, t + 1);
+    return 0;
+}
+
+bool key_input_pending(void)
+{
+    return atomic_get(&tail) != atomic_get(&head);
+}
+
+uint32_t key_input_dropped(void)
+{
+    return (uint32_t)atomic_get(&dropped);
+}
@@ -0,0 +1,69 @@
+/*
+ * application/src/key_shell.c
+ * 按键手势 Shell 命令：keys watch [秒] / keys stats
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+#include <stdlib.h>
+
+#include "key_gesture.h"
+#include "key_input.h"
+
+#define KEYS_WATCH_DEFAULT_S  10
+#define KEYS_WATCH_MAX_S      300
+
+static int cmd_keys_watch(const struct shell *sh, size_t argc, char **argv)
+{
+    int seconds = (argc > 1) ? atoi(argv[1]) : KEYS_WATCH_DEFAULT_S;
+    int64_t end;
+    struct key_gesture_evt evt;
+    char keys[24];
+
+    if (seconds < 1 || seconds > KEYS_WATCH_MAX_S) {
+        shell_error(sh, "时间范围 1..%d 秒", KEYS_WATCH_MAX_S);
+        return -EINVAL;
+    }
+
+    shell_print(sh, "显示 %d 秒内的按键手势...", seconds);
+    key_gesture_watch(true);
+    end = k_uptime_get() + seconds * 1000;
+    while (k_uptime_get() < end) {
+        if (key_gesture_get(&evt, K_MSEC(100)) < 0) {
+            continue;
+        }
+        key_gesture_keys_str(evt.keys, keys, sizeof(keys));
+        if (evt.type == KEY_GESTURE_REPEAT) {
+            shell_print(sh, "%8u ms  %-12s %s #%u", evt.t_ms, key_gesture_name(evt.type), keys,
+                        evt.repeat);
+        } else {
+            shell_print(sh, "%8u ms  %-12s %s", evt.t_ms, key_gesture_name(evt.type), keys);
+        }
+    }
+    key_gesture_watch(false);
+    return 0;
+}
+
+static int cmd_keys_stats(const struct shell *sh, size_t argc, char **argv)
+{
+    struct key_gesture_stats st;
+
+    key_gesture_get_stats(&st);
+    shell_print(sh, "边沿 %u 个 (队列满丢弃 %u), 状态机运行 %u 次, 单次最长 %u us",
+                st.edges, st.edges_dropped, st.runs, st.max_run_us);
+    for (int i = 0; i < KEY_GESTURE_COUNT; i++) {
+        shell_print(sh, "  %-12s %u", key_gesture_name(i), st.gestures[i]);
+    }
+    if (key_input_dropped()) {
+        shell_print(sh, "LVGL 按键队列满丢弃 %u 个事件", key_input_dropped());
+    }
+    return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_keys,
+    SHELL_CMD_ARG(watch, NULL, "实时显示按键手势: watch [秒]", cmd_keys_watch, 1, 1),
+    SHELL_CMD(stats, NULL, "边沿与手势计数", cmd_keys_stats),
+    SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(keys, &sub_keys, "摇杆按键手势 (单击/双击/长按/连发/组合键)", NULL);
@@ -0,0 +1,257 @@
+/*
+ * application/src/lcd_flush.c
+ * LVGL flush 回调：通过 ST7789V 驱动的异步写入把绘图缓冲交给 SPI DMA 发送
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/display.h>
+#include <zephyr/logging/log.h>
+#include <lvgl.h>
+#include <string.h>
+
+#include "lcd_flush.h"
+#include "asset_store.h"
+#include "display_thread.h"
+#include "st7789v.h"
+
+LOG_MODULE_REGISTER(LCD_FLUSH, LOG_LEVEL_INF);
+
+/* ---------------- 配置参数 ---------------- */
+#define LCD_FLUSH_WAIT_TIMEOUT    K_MSEC(200)   // 单块传输的最长等待 (240x24 像素 20MHz 约 6ms)
+#define LCD_BENCH_TIMEOUT_MS      30000
+
+static const struct device *lcd_dev;
+static volatile bool use_async = true;
+static atomic_t flush_count;
+
+static K_SEM_DEFINE(bench_req, 0, 1);
+static K_SEM_DEFINE(bench_done, 0, 1);
+static K_MUTEX_DEFINE(bench_lock);
+static struct lcd_bench_result bench;
+
+/*
+ * 延迟统计：pending 是已登记、还没有进入某一帧的变化；
+ * 一帧的最后一块提交时转入 inflight，这块发送完时记账。
+ * 前一块发送完 LVGL 才提交下一块，所以 inflight 非空时下一次完成的一定是最后一块。
+ * flush 回调在显示线程、完成回调在驱动线程，用自旋锁保护。
+ */
+static struct k_spinlock lat_lock;
+static uint32_t lat_pending[LCD_LATENCY_SRC_COUNT];
+static uint32_t lat_inflight[LCD_LATENCY_SRC_COUNT];
+static uint8_t lat_pending_mask;
+static uint8_t lat_inflight_mask;
+static struct lcd_latency latency[LCD_LATENCY_SRC_COUNT];
+
+/* 本帧的最后一块即将提交 */
+static void latency_frame_last(void)
+{
+    k_spinlock_key_t key = k_spin_lock(&lat_lock);
+
+    memcpy(lat_inflight, lat_pending, sizeof(lat_inflight));
+    lat_inflight_mask = lat_pending_mask;
+    lat_pending_mask = 0;
+    k_spin_unlock(&lat_lock, key);
+}
+
+/* 本帧的最后一块已发送完 */
+static void latency_frame_done(void)
+{
+    uint32_t now = k_cycle_get_32();
+    k_spinlock_key_t key = k_spin_lock(&lat_lock);
+
+    for (int i = 0; i < LCD_LATENCY_SRC_COUNT; i++) {
+        if (lat_inflight_mask & BIT(i)) {
+            uint32_t us = (uint32_t)k_cyc_to_us_floor64(now - lat_inflight[i]);
+
+            latency[i].count++;
+            latency[i].sum_us += us;
+            latency[i].max_us = MAX(latency[i].max_us, us);
+        }
+    }
+    lat_inflight_mask = 0;
+    k_spin_unlock(&lat_lock, key);
+}
+
+static void flush_done(const struct device *dev, int result, void *user_data)
+{
+    if (result < 0) {
+        LOG_ERR("异步写入失败: %d", result);
+    }
+    latency_frame_done();
+    /* 只清除 flushing 标志，可以在驱动线程中调用 */
+    lv_display_flush_ready((lv_display_t *)user_data);
+}
+
+static void lcd_flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
+{
+    uint16_t w = lv_area_get_width(area);
+    uint16_t h = lv_area_get_height(area);
+    struct display_buffer_descriptor desc = {
+        .buf_size = w * h * 2U,
+        .width = w,
+        .height = h,
+        .pitch = w,
+    };
+    int ret;
+
+    /* 与 Zephyr 自带的 16 位回调一致：按屏幕的字节序就地交换 */
+    if (IS_ENABLED(CONFIG_LV_COLOR_16_SWAP)) {
+        lv_draw_sw_rgb565_swap(px_map, w * h);
+    }
+    atomic_inc(&flush_count);
+    if (lv_display_flush_is_last(disp)) {
+        latency_frame_last();
+    }
+
+    if (use_async) {
+        ret = st7789v_write_async(lcd_dev, area->x1, area->y1, &desc, px_map, flush_done, disp);
+        if (ret == 0) {
+            return;
+        }
+        LOG_ERR("异步写入提交失败: %d", ret);
+    } else {
+        display_write(lcd_dev, area->x1, area->y1, &desc, px_map);
+    }
+    latency_frame_done();
+    lv_display_flush_ready(disp);
+}
+
+static void lcd_flush_wait_cb(lv_display_t *disp)
+{
+    ARG_UNUSED(disp);
+    lcd_flush_wait();
+}
+
+int lcd_flush_attach(lv_display_t *disp, const struct device *dev)
+{
+    if (disp == NULL || !device_is_ready(dev)) {
+        return -ENODEV;
+    }
+    if (lv_display_get_color_format(disp) != LV_COLOR_FORMAT_RGB565) {
+        return -ENOTSUP;
+    }
+
+    lcd_dev = dev;
+    lv_display_set_flush_cb(disp, lcd_flush_cb);
+    lv_display_set_flush_wait_cb(disp, lcd_flush_wait_cb);
+    return 0;
+}
+
+void lcd_flush_set_async(bool async)
+{
+    lcd_flush_wait();
+    use_async = async;
+}
+
+bool lcd_flush_is_async(void)
+{
+    return use_async;
+}
+
+void lcd_flush_wait(void)
+{
+    if (lcd_dev != NULL && st7789v_wait_idle(lcd_dev, LCD_FLUSH_WAIT_TIMEOUT) < 0) {
+        LOG_WRN("等待 SPI 传输超时");
+    }
+}
+
+int lcd_flush_bench(uint32_t frames, bool async, struct lcd_bench_result *out)
+{
+    int ret;
+
+    if (lcd_dev == NULL) {
+        return -ENODEV;
+    }
+    if (k_mutex_lock(&bench_lock, K_NO_WAIT) < 0) {
+        return -EBUSY;
+    }
+
+    k_sem_reset(&bench_done);
+    bench = (struct lcd_bench_result){ .frames = frames, .async = async };
+    k_sem_give(&bench_req);
+    display_wake(DISPLAY_EVT_CMD);
+
+    ret = k_sem_take(&bench_done, K_MSEC(LCD_BENCH_TIMEOUT_MS));
+    if (ret == 0) {
+        *out = bench;
+    } else {
+        // 显示线程超时后仍会完成这次测试，结果丢弃
+        ret = -ETIMEDOUT;
+    }
+    k_mutex_unlock(&bench_lock);
+    return ret;
+}
+
+void lcd_flush_poll(void)
+{
+    lv_display_t *disp = lv_display_get_default();
+    k_thread_runtime_stats_t st0, st1;
+    struct st7789v_stats spi0, spi1;
+    bool saved = use_async;
+    uint32_t t0, flush0;
+
+    if (k_sem_take(&bench_req, K_NO_WAIT) < 0) {
+        return;
+    }
+
+    lcd_flush_set_async(bench.async);
+    flush0 = atomic_get(&flush_count);
+    st7789v_get_stats(lcd_dev, &spi0);
+    k_thread_runtime_stats_get(k_current_get(), &st0);
+    t0 = k_cycle_get_32();
+
+    for (uint32_t i = 0; i < bench.frames; i++) {
+        /* 逐帧持有映射窗口，帧间让出给 Flash 写入/擦除 */
+        bool xip = asset_xip_lock_if_mapped();
+
+        lv_obj_invalidate(lv_screen_active());
+        lv_refr_now(disp);
+        if (xip) {
+            asset_xip_unlock();
+        }
+    }
+    lcd_flush_wait();
+
+    uint32_t cycles = k_cycle_get_32() - t0;
+
+    k_thread_runtime_stats_get(k_current_get(), &st1);
+    bench.elapsed_us = (uint32_t)k_cyc_to_us_floor64(cycles);
+    bench.flushes = atomic_get(&flush_count) - flush0;
+    st7789v_get_stats(lcd_dev, &spi1);
+    bench.spi_transfers = spi1.transfers - spi0.transfers;
+    bench.cs_cycles = spi1.cs_cycles - spi0.cs_cycles;
+    bench.pixel_bytes = spi1.pixel_bytes - spi0.pixel_bytes;
+    bench.rgb444 = st7789v_is_rgb444(lcd_dev);
+    bench.cpu_permille = cycles ? (uint32_t)((st1.execution_cycles - st0.execution_cycles) *
+                                             1000 / cycles) : 0;
+    lcd_flush_set_async(saved);
+
+    k_sem_give(&bench_done);
+}
+
+void lcd_flush_latency_mark(enum lcd_latency_src src, uint32_t stamp)
+{
+    k_spinlock_key_t key = k_spin_lock(&lat_lock);
+
+    if (!(lat_pending_mask & BIT(src))) {
+        lat_pending[src] = stamp;
+        lat_pending_mask |= BIT(src);
+    }
+    k_spin_unlock(&lat_lock, key);
+}
+
+void lcd_flush_get_latency(struct lcd_latency out[LCD_LATENCY_SRC_COUNT])
+{
+    k_spinlock_key_t key = k_spin_lock(&lat_lock);
+
+    memcpy(out, latency, sizeof(latency));
+    k_spin_unlock(&lat_lock, key);
+}
+
+void lcd_flush_reset_latency(void)
+{
+    k_spinlock_key_t key = k_spin_lock(&lat_lock);
+
+    memset(latency, 0, sizeof(latency));
+    k_spin_unlock(&lat_lock, key);
+}
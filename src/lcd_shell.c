@@ -0,0 +1,253 @@
+/*
+ * application/src/lcd_shell.c
+ * 屏幕刷新 Shell 命令：lcd bench [帧数] [sync|async] / lcd mode [sync|async] / lcd depth [12|16]
+ *                     lcd roll [on|off] / lcd rotate [0|90|180|270|auto] / lcd stats
+ *                     lcd loop [reset]
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/shell/shell.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lcd_flush.h"
+#include "roll_plot.h"
+#include "auto_rotate.h"
+#include "st7789v.h"
+#include "display_thread.h"
+
+#define LCD_NODE      DT_CHOSEN(zephyr_display)
+#define LCD_SPI_HZ    DT_PROP(LCD_NODE, spi_max_frequency)
+
+static const struct device *const lcd = DEVICE_DT_GET(LCD_NODE);
+
+static int parse_mode(const struct shell *sh, const char *arg, bool *async)
+{
+    if (strcmp(arg, "async") == 0) {
+        *async = true;
+    } else if (strcmp(arg, "sync") == 0) {
+        *async = false;
+    } else {
+        shell_error(sh, "模式为 sync 或 async");
+        return -EINVAL;
+    }
+    return 0;
+}
+
+static void print_result(const struct shell *sh, const struct lcd_bench_result *r)
+{
+    uint32_t fps_x10 = r->elapsed_us ? (uint32_t)((uint64_t)r->frames * 10000000 / r->elapsed_us) : 0;
+
+    shell_print(sh, "%-5s %3u 帧 %6u ms  %3u.%u fps  每帧 %u 次 flush  显示线程 CPU %u.%u%%",
+                r->async ? "async" : "sync", r->frames, r->elapsed_us / 1000,
+                fps_x10 / 10, fps_x10 % 10, r->frames ? r->flushes / r->frames : 0,
+                r->cpu_permille / 10, r->cpu_permille % 10);
+    if (r->frames) {
+        uint32_t bytes = r->pixel_bytes / r->frames;
+
+        shell_print(sh, "      每帧 SPI 传输 %u.%u 次, 片选 %u 次",
+                    r->spi_transfers / r->frames, r->spi_transfers * 10 / r->frames % 10,
+                    r->cs_cycles / r->frames);
+        /* 链路上限：只算像素数据，不含命令和 DMA 启动开销 */
+        shell_print(sh, "      %s 每帧 %u 字节, %u MHz 链路上限 %u fps",
+                    r->rgb444 ? "RGB444" : "RGB565", bytes, LCD_SPI_HZ / 1000000,
+                    bytes ? (uint32_t)((uint64_t)LCD_SPI_HZ / 8 / bytes) : 0);
+    }
+}
+
+static int cmd_lcd_bench(const struct shell *sh, size_t argc, char **argv)
+{
+    int frames = (argc > 1) ? atoi(argv[1]) : LCD_BENCH_DEFAULT_FRAMES;
+    struct lcd_bench_result r;
+    bool modes[2] = {false, true};
+    int n = 2;
+    int ret;
+
+    if (roll_plot_is_active()) {
+        shell_error(sh, "滚动图模式下 LVGL 暂停，先执行 lcd roll off");
+        return -EBUSY;
+    }
+    if (frames < 1 || frames > LCD_BENCH_MAX_FRAMES) {
+        shell_error(sh, "帧数范围 1..%d", LCD_BENCH_MAX_FRAMES);
+        return -EINVAL;
+    }
+    /* 不指定模式时两种都测，便于对比 */
+    if (argc > 2) {
+        ret = parse_mode(sh, argv[2], &modes[0]);
+        if (ret < 0) {
+            return ret;
+        }
+        n = 1;
+    }
+
+    for (int i = 0; i < n; i++) {
+        ret = lcd_flush_bench(frames, modes[i], &r);
+        if (ret < 0) {
+            shell_error(sh, "测试失败: %d", ret);
+            return ret;
+        }
+        print_result(sh, &r);
+    }
+    return 0;
+}
+
+static int cmd_lcd_mode(const struct shell *sh, size_t argc, char **argv)
+{
+    bool async;
+    int ret;
+
+    if (argc > 1) {
+        ret = parse_mode(sh, argv[1], &async);
+        if (ret < 0) {
+            return ret;
+        }
+        lcd_flush_set_async(async);
+    }
+    shell_print(sh, "刷新模式: %s", lcd_flush_is_async() ? "async (SPI DMA 后台发送)" : "sync");
+    return 0;
+}
+
+static int cmd_lcd_depth(const struct shell *sh, size_t argc, char **argv)
+{
+    int ret;
+
+    if (!device_is_ready(lcd)) {
+        shell_error(sh, "屏幕未就绪");
+        return -ENODEV;
+    }
+    if (argc > 1) {
+        int bits = atoi(argv[1]);
+
+        if (bits != 12 && bits != 16) {
+            shell_error(sh, "位深为 12 或 16");
+            return -EINVAL;
+        }
+        ret = st7789v_set_rgb444(lcd, bits == 12);
+        if (ret < 0) {
+            shell_error(sh, "切换失败: %d", ret);
+            return ret;
+        }
+    }
+    shell_print(sh, "接口格式: %s", st7789v_is_rgb444(lcd) ? "RGB444 (12 位)" : "RGB565 (16 位)");
+    return 0;
+}
+
+static int cmd_lcd_roll(const struct shell *sh, size_t argc, char **argv)
+{
+    if (argc > 1) {
+        if (strcmp(argv[1], "on") == 0) {
+            roll_plot_request(true);
+        } else if (strcmp(argv[1], "off") == 0) {
+            roll_plot_request(false);
+        } else {
+            shell_error(sh, "参数为 on 或 off");
+            return -EINVAL;
+        }
+        /* 由显示线程切换，等它处理完再报告状态 */
+        k_msleep(100);
+    }
+    shell_print(sh, "滚动图模式: %s", roll_plot_is_active() ? "开 (每个采样发送 1 列)" : "关");
+    return 0;
+}
+
+static int cmd_lcd_rotate(const struct shell *sh, size_t argc, char **argv)
+{
+    static const uint16_t deg[] = {0, 90, 180, 270};
+
+    if (argc > 1) {
+        if (strcmp(argv[1], "auto") == 0) {
+            auto_rotate_enable(true);
+        } else {
+            int d = atoi(argv[1]);
+            size_t i;
+
+            for (i = 0; i < ARRAY_SIZE(deg) && deg[i] != d; i++) {
+            }
+            if (i == ARRAY_SIZE(deg)) {
+                shell_error(sh, "方向为 0/90/180/270 或 auto");
+                return -EINVAL;
+            }
+            auto_rotate_set((enum display_orientation)(DISPLAY_ORIENTATION_NORMAL + i));
+        }
+        /* 由显示线程切换，等它处理完再报告状态 */
+        k_msleep(100);
+    }
+    shell_print(sh, "屏幕方向 %u°%s", deg[auto_rotate_current()],
+                auto_rotate_is_enabled() ? " (自动)" : "");
+    return 0;
+}
+
+static int cmd_lcd_stats(const struct shell *sh, size_t argc, char **argv)
+{
+    struct st7789v_stats s;
+
+    if (!device_is_ready(lcd)) {
+        shell_error(sh, "屏幕未就绪");
+        return -ENODEV;
+    }
+    st7789v_get_stats(lcd, &s);
+    shell_print(sh, "像素写入 %u 次, 其中 %u 次省略 CASET/RASET", s.writes, s.window_skips);
+    shell_print(sh, "SPI 传输 %u 次, 片选 %u 次 (含初始化等单独命令)", s.transfers, s.cs_cycles);
+    if (s.writes) {
+        shell_print(sh, "平均每次写入 %u.%u 次传输, %u 字节像素数据", s.transfers / s.writes,
+                    s.transfers * 10 / s.writes % 10, s.pixel_bytes / s.writes);
+    }
+    return 0;
+}
+
+static void print_latency(const struct shell *sh, const char *name, const struct lcd_latency *l)
+{
+    if (l->count == 0) {
+        shell_print(sh, "%s -> 上屏: 无样本", name);
+        return;
+    }
+    shell_print(sh, "%s -> 上屏: %u 次, 平均 %u.%u ms, 最大 %u.%u ms", name, l->count,
+                l->sum_us / l->count / 1000, l->sum_us / l->count / 100 % 10,
+                l->max_us / 1000, l->max_us / 100 % 10);
+}
+
+static int cmd_lcd_loop(const struct shell *sh, size_t argc, char **argv)
+{
+    struct display_loop_stats st;
+    struct lcd_latency lat[LCD_LATENCY_SRC_COUNT];
+
+    if (argc > 1) {
+        if (strcmp(argv[1], "reset") != 0) {
+            shell_error(sh, "参数为 reset");
+            return -EINVAL;
+        }
+        display_reset_loop_stats();
+        lcd_flush_reset_latency();
+        shell_print(sh, "统计已清零");
+        return 0;
+    }
+
+    display_get_loop_stats(&st);
+    lcd_flush_get_latency(lat);
+    if (st.elapsed_ms == 0 || st.wakeups == 0) {
+        shell_print(sh, "还没有统计数据");
+        return 0;
+    }
+    shell_print(sh, "%u.%u s 内唤醒 %u 次 (%u.%u 次/秒), 事件唤醒 %u 次, 平均计划睡眠 %u ms",
+                st.elapsed_ms / 1000, st.elapsed_ms / 100 % 10, st.wakeups,
+                (uint32_t)((uint64_t)st.wakeups * 1000 / st.elapsed_ms),
+                (uint32_t)((uint64_t)st.wakeups * 10000 / st.elapsed_ms % 10),
+                st.event_wakeups, st.sleep_ms / st.wakeups);
+    print_latency(sh, "传感器采样", &lat[LCD_LATENCY_SENSOR]);
+    print_latency(sh, "按键", &lat[LCD_LATENCY_INPUT]);
+    return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_lcd,
+    SHELL_CMD_ARG(bench, NULL, "整屏刷新基准测试: bench [帧数] [sync|async]", cmd_lcd_bench, 1, 2),
+    SHELL_CMD_ARG(mode, NULL, "查看/切换刷新模式: mode [sync|async]", cmd_lcd_mode, 1, 1),
+    SHELL_CMD_ARG(depth, NULL, "查看/切换接口位深: depth [12|16]", cmd_lcd_depth, 1, 1),
+    SHELL_CMD_ARG(roll, NULL, "整屏滚动光照曲线 (硬件滚动): roll [on|off]", cmd_lcd_roll, 1, 1),
+    SHELL_CMD_ARG(rotate, NULL, "硬件旋转: rotate [0|90|180|270|auto]", cmd_lcd_rotate, 1, 1),
+    SHELL_CMD(stats, NULL, "SPI 传输与片选计数", cmd_lcd_stats),
+    SHELL_CMD_ARG(loop, NULL, "显示线程唤醒次数与上屏延迟: loop [reset]", cmd_lcd_loop, 1, 1),
+    SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(lcd, &sub_lcd, "ST7789V 屏幕刷新", NULL);
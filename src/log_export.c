@@ -0,0 +1,181 @@
+/*
+ * application/src/log_export.c
+ * 日志二进制导出：分段文件 → COBS 帧 → Shell 传输层
+ *
+ * 数据路径只有一个缓冲区：文件数据直接读进帧缓冲区的数据区，
+ * COBS 在同一个缓冲区里原地编码，整块交给传输层。
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/fs/fs.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/crc.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/logging/log.h>
+#include <string.h>
+
+#include "log_export.h"
+#include "log_store.h"
+
+LOG_MODULE_REGISTER(LOG_EXPORT, LOG_LEVEL_INF);
+
+#define FRAME_RAW_MAX   (sizeof(struct log_export_hdr) + LOG_EXPORT_CHUNK + sizeof(uint32_t))
+/* COBS 每 254 字节增加 1 字节开销，再加开头的 code 字节和结尾的 0x00 */
+#define COBS_HEADROOM   (FRAME_RAW_MAX / 254 + 2)
+
+/*
+ * 原始帧放在 COBS_HEADROOM 之后，编码结果从缓冲区开头写起。
+ * 编码第 i 个输入字节时输出位置最多是 i + i/254 + 1，始终不超过输入位置，
+ * 所以原地编码不会覆盖还没读到的数据。
+ */
+static uint8_t frame_buf[COBS_HEADROOM + FRAME_RAW_MAX];
+static uint8_t *const frame_raw = frame_buf + COBS_HEADROOM;
+static const uint8_t stream_sync = 0x00;
+static K_MUTEX_DEFINE(export_lock);
+
+/* COBS 编码，输出末尾追加 0x00 分隔符，返回输出长度；dst 可以与 src 重叠，只要 dst 在前 */
+static size_t cobs_encode(const uint8_t *src, size_t len, uint8_t *dst)
+{
+    size_t code_pos = 0, out = 1;
+    uint8_t code = 1;
+
+    for (size_t i = 0; i < len; i++) {
+        if (src[i] != 0) {
+            dst[out++] = src[i];
+            code++;
+        }
+        if (src[i] == 0 || code == 0xFF) {
+            dst[code_pos] = code;
+            code_pos = out++;
+            code = 1;
+        }
+    }
+    dst[code_pos] = code;
+    dst[out++] = 0x00;
+    return out;
+}
+
+/* 写满为止：传输层发送缓冲区满时让出 CPU 等待中断把数据发走 */
+static int tx_write(const struct shell *sh, const uint8_t *buf, size_t len)
+{
+    size_t cnt;
+    int ret;
+
+    while (len > 0) {
+        ret = sh->iface->api->write(sh->iface, buf, len, &cnt);
+        if (ret < 0) {
+            return ret;
+        }
+        buf += cnt;
+        len -= cnt;
+        if (cnt == 0) {
+            k_sleep(K_TICKS(1));
+        }
+    }
+    return 0;
+}
+
+/* 数据已经在 frame_raw 的数据区里，这里补帧头和 CRC 后编码发送 */
+static int frame_send(const struct shell *sh, uint8_t type, uint32_t seg, uint32_t offset,
+                      uint16_t len)
+{
+    struct log_export_hdr *hdr = (struct log_export_hdr *)frame_raw;
+    size_t raw_len = sizeof(*hdr) + len;
+
+    hdr->type = type;
+    hdr->version = LOG_EXPORT_VERSION;
+    hdr->len = sys_cpu_to_le16(len);
+    hdr->seg = sys_cpu_to_le32(seg);
+    hdr->offset = sys_cpu_to_le32(offset);
+    sys_put_le32(crc32_ieee(frame_raw, raw_len), &frame_raw[raw_len]);
+
+    return tx_write(sh, frame_buf, cobs_encode(frame_raw, raw_len + sizeof(uint32_t), frame_buf));
+}
+
+static inline uint8_t *frame_data(void)
+{
+    return frame_raw + sizeof(struct log_export_hdr);
+}
+
+/* 发送一个分段中 [offset, size) 的内容 */
+static int export_segment(const struct shell *sh, uint32_t start, uint32_t offset, uint32_t size,
+                          uint32_t *sent)
+{
+    char path[LOG_SEG_PATH_MAX];
+    struct fs_file_t file;
+    ssize_t n;
+    int ret;
+
+    log_store_segment_path(start, path);
+    fs_file_t_init(&file);
+    ret = fs_open(&file, path, FS_O_READ);
+    if (ret < 0) {
+        // 导出期间分段被配额回收，跳过即可
+        return (ret == -ENOENT) ? 0 : ret;
+    }
+
+    ret = fs_seek(&file, offset, FS_SEEK_SET);
+    while (ret == 0 && offset < size) {
+        n = fs_read(&file, frame_data(), MIN(LOG_EXPORT_CHUNK, size - offset));
+        if (n <= 0) {
+            ret = (int)n;
+            break;
+        }
+        ret = frame_send(sh, LOG_EXPORT_DATA, start, offset, (uint16_t)n);
+        offset += n;
+        *sent += n;
+    }
+
+    fs_close(&file);
+    return ret;
+}
+
+int log_export_run(const struct shell *sh, uint32_t from_seg, uint32_t offset)
+{
+    uint32_t start, size, from, segments = 0, total = 0, sent = 0;
+    int64_t t0 = k_uptime_get();
+    int ret;
+
+    if (k_mutex_lock(&export_lock, K_NO_WAIT) != 0) {
+        return -EBUSY;
+    }
+
+    /* RAM 中的压缩帧先落盘，保证导出内容是完整的 */
+    ret = log_store_flush();
+    if (ret < 0) {
+        goto out;
+    }
+
+    /* 统计本次要发送的分段数和字节数，供主机显示进度；续传偏移只对 from_seg 本身有效 */
+    for (from = from_seg; log_store_next_segment(from, &start, &size) == 0; from = start + 1) {
+        uint32_t skip = (start == from_seg) ? MIN(offset, size) : 0;
+
+        segments++;
+        total += size - skip;
+    }
+
+    /* 流开头的 0x00 让主机丢弃命令回显，重新同步到帧边界 */
+    ret = tx_write(sh, &stream_sync, 1);
+    if (ret == 0) {
+        sys_put_le32(segments, frame_data());
+        sys_put_le32(total, frame_data() + 4);
+        ret = frame_send(sh, LOG_EXPORT_START, from_seg, offset, 8);
+    }
+
+    for (from = from_seg; ret == 0 && log_store_next_segment(from, &start, &size) == 0;
+         from = start + 1) {
+        ret = export_segment(sh, start, (start == from_seg) ? MIN(offset, size) : 0, size, &sent);
+    }
+
+    sys_put_le32(sent, frame_data());
+    sys_put_le32((uint32_t)(k_uptime_get() - t0), frame_data() + 4);
+    sys_put_le32((uint32_t)ret, frame_data() + 8);
+    frame_send(sh, LOG_EXPORT_END, 0, 0, 12);
+
+out:
+    if (ret < 0) {
+        LOG_ERR("导出失败: %d", ret);
+    }
+    k_mutex_unlock(&export_lock);
+    return ret;
+}
@@ -0,0 +1,278 @@
+/*
+ * application/src/log_shell.c
+ * 传感器日志 Shell 命令：datalog info / query / bench / export
+ *
+ * 注意：Zephyr 日志子系统已经占用了 "log" 根命令，这里使用 "datalog"。
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+
+#include "log_store.h"
+#include "log_export.h"
+#include "ts_codec.h"
+
+/* 对照基准：原 CSV 格式 "1760000000,23.45,56.78,123\n" 每条约 27 字节 */
+#define CSV_BYTES_PER_RECORD  27
+
+/* 聚合方式 */
+enum query_agg {
+    QUERY_AGG_NONE,    // 逐条输出
+    QUERY_AGG_AVG,
+    QUERY_AGG_MIN,
+    QUERY_AGG_MAX,
+    QUERY_AGG_COUNT,
+};
+
+struct query_ctx {
+    const struct shell *sh;
+    enum query_agg agg;
+    uint32_t count;
+    double temp_acc, humi_acc, lux_acc;   // 均值累加 / 极值
+};
+
+static int query_print_cb(const struct log_record *rec, void *user_data)
+{
+    struct query_ctx *ctx = user_data;
+
+    shell_print(ctx->sh, "%u,%.2f,%.2f,%u", rec->ts,
+                (double)rec->temperature, (double)rec->humidity, rec->lux);
+    return 0;
+}
+
+static int query_agg_cb(const struct log_record *rec, void *user_data)
+{
+    struct query_ctx *ctx = user_data;
+    double t = rec->temperature, h = rec->humidity, l = rec->lux;
+
+    switch (ctx->agg) {
+    case QUERY_AGG_AVG:
+        ctx->temp_acc += t;
+        ctx->humi_acc += h;
+        ctx->lux_acc += l;
+        break;
+    case QUERY_AGG_MIN:
+        ctx->temp_acc = MIN(ctx->temp_acc, t);
+        ctx->humi_acc = MIN(ctx->humi_acc, h);
+        ctx->lux_acc = MIN(ctx->lux_acc, l);
+        break;
+    case QUERY_AGG_MAX:
+        ctx->temp_acc = MAX(ctx->temp_acc, t);
+        ctx->humi_acc = MAX(ctx->humi_acc, h);
+        ctx->lux_acc = MAX(ctx->lux_acc, l);
+        break;
+    default:
+        break;
+    }
+    ctx->count++;
+    return 0;
+}
+
+static int parse_agg(const char *arg, enum query_agg *agg)
+{
+    static const char *const names[] = {"none", "avg", "min", "max", "count"};
+
+    for (int i = 0; i < ARRAY_SIZE(names); i++) {
+        if (strcmp(arg, names[i]) == 0) {
+            *agg = (enum query_agg)i;
+            return 0;
+        }
+    }
+    return -EINVAL;
+}
+
+/* 时间参数支持绝对秒数，或者 "now" / "now-<秒>" 这种相对写法 */
+static int parse_ts(const char *arg, uint32_t *ts)
+{
+    char *end;
+
+    if (strncmp(arg, "now", 3) == 0) {
+        uint32_t now = log_store_now();
+
+        if (arg[3] == '\0') {
+            *ts = now;
+            return 0;
+        }
+        if (arg[3] == '-') {
+            uint32_t back = strtoul(&arg[4], &end, 10);
+
+            if (*end == '\0') {
+                *ts = (back > now) ? 0 : now - back;
+                return 0;
+            }
+        }
+        return -EINVAL;
+    }
+
+    *ts = strtoul(arg, &end, 10);
+    return (*end == '\0') ? 0 : -EINVAL;
+}
+
+static int cmd_datalog_query(const struct shell *sh, size_t argc, char **argv)
+{
+    struct query_ctx ctx = {.sh = sh, .agg = QUERY_AGG_NONE};
+    uint32_t from, to;
+    int64_t t0;
+    int ret;
+
+    if (parse_ts(argv[1], &from) < 0 || parse_ts(argv[2], &to) < 0) {
+        shell_error(sh, "时间格式错误: <秒> | now | now-<秒>");
+        return -EINVAL;
+    }
+    if (argc > 3 && parse_agg(argv[3], &ctx.agg) < 0) {
+        shell_error(sh, "聚合方式: none | avg | min | max | count");
+        return -EINVAL;
+    }
+
+    if (ctx.agg == QUERY_AGG_MIN) {
+        ctx.temp_acc = ctx.humi_acc = ctx.lux_acc = DBL_MAX;
+    } else if (ctx.agg == QUERY_AGG_MAX) {
+        ctx.temp_acc = ctx.humi_acc = ctx.lux_acc = -DBL_MAX;
+    }
+
+    t0 = k_uptime_get();
+    ret = log_store_query(from, to,
+                          (ctx.agg == QUERY_AGG_NONE) ? query_print_cb : query_agg_cb, &ctx);
+    if (ret < 0) {
+        shell_error(sh, "查询失败: %d", ret);
+        return ret;
+    }
+
+    if (ctx.agg == QUERY_AGG_AVG && ctx.count > 0) {
+        ctx.temp_acc /= ctx.count;
+        ctx.humi_acc /= ctx.count;
+        ctx.lux_acc /= ctx.count;
+    }
+    if (ctx.agg != QUERY_AGG_NONE && ctx.agg != QUERY_AGG_COUNT && ctx.count > 0) {
+        shell_print(sh, "temp=%.2f humi=%.2f lux=%.1f", ctx.temp_acc, ctx.humi_acc, ctx.lux_acc);
+    }
+    shell_print(sh, "匹配 %d 条记录, 耗时 %lld ms", ret, k_uptime_get() - t0);
+    return 0;
+}
+
+static int cmd_datalog_info(const struct shell *sh, size_t argc, char **argv)
+{
+    uint32_t segments, bytes;
+
+    log_store_usage(&segments, &bytes);
+    shell_print(sh, "目录: %s", LOG_STORE_DIR);
+    shell_print(sh, "分段: %u 个, 共 %u 字节 (配额 %u 字节)", segments, bytes,
+                (uint32_t)LOG_STORE_QUOTA_BYTES);
+    shell_print(sh, "当前时间戳: %u", log_store_now());
+    return 0;
+}
+
+/* 伪随机序列 (LCG)，保证每次基准测试的输入完全相同 */
+static uint32_t bench_rand(uint32_t *state)
+{
+    *state = *state * 1103515245u + 12345u;
+    return *state >> 16;
+}
+
+static int bench_count_cb(const struct log_record *rec, void *user_data)
+{
+    (*(uint32_t *)user_data)++;
+    return 0;
+}
+
+/*
+ * 压缩器基准：模拟 5 分钟周期、温湿度缓慢漂移、光照偶尔跳变的数据。
+ * 与 log_store 相同，帧满或帧跨度达到 age 秒时落盘 (默认 LOG_FRAME_MAX_AGE_S)；
+ * age 为 0 时只在帧满时落盘，得到的是压缩器本身的极限。
+ */
+static int cmd_datalog_bench(const struct shell *sh, size_t argc, char **argv)
+{
+    static struct ts_encoder bench_enc;
+    struct log_record rec = {.ts = 1760000000, .temperature = 22.5f, .humidity = 45.0f, .lux = 120};
+    uint32_t n = (argc > 1) ? strtoul(argv[1], NULL, 10) : 1000;
+    uint32_t age = (argc > 2) ? strtoul(argv[2], NULL, 10) : LOG_FRAME_MAX_AGE_S;
+    uint32_t seed = 1, decoded = 0, frames = 0, bytes = 0;
+    uint64_t enc_cycles = 0, dec_cycles = 0;
+    uint32_t t0;
+    size_t len;
+
+    if (n == 0) {
+        return -EINVAL;
+    }
+
+    ts_encoder_reset(&bench_enc);
+    for (uint32_t i = 0; i <= n; i++) {
+        bool pending = false;    // 这条记录因帧满没有写入，落盘后写入新帧
+
+        if (i < n) {
+            rec.ts += 300 + ((bench_rand(&seed) % 8 == 0) ? (bench_rand(&seed) % 3) - 1 : 0);
+            rec.temperature += ((int)(bench_rand(&seed) % 5) - 2) * 0.01f;
+            rec.humidity += ((int)(bench_rand(&seed) % 3) - 1) * 0.05f;
+            if (bench_rand(&seed) % 10 == 0) {
+                rec.lux = bench_rand(&seed) % 1000;
+            }
+
+            t0 = k_cycle_get_32();
+            int ret = ts_encoder_add(&bench_enc, &rec);
+
+            enc_cycles += k_cycle_get_32() - t0;
+            pending = (ret != 0);
+            if (!pending && (age == 0 || rec.ts - bench_enc.first_ts < age)) {
+                continue;
+            }
+        }
+
+        /* 帧满、帧跨度到期或最后一帧：统计字节数并解码校验 */
+        t0 = k_cycle_get_32();
+        len = ts_encoder_finish(&bench_enc);
+        enc_cycles += k_cycle_get_32() - t0;
+
+        if (len > 0) {
+            t0 = k_cycle_get_32();
+            ts_decode_frame(bench_enc.frame, len, bench_count_cb, &decoded);
+            dec_cycles += k_cycle_get_32() - t0;
+
+            frames++;
+            bytes += len;
+        }
+        ts_encoder_reset(&bench_enc);
+        if (pending) {
+            ts_encoder_add(&bench_enc, &rec);
+        }
+    }
+
+    shell_print(sh, "记录: %u, 解码: %u, 帧: %u (%.1f 条/帧, 帧跨度上限 %u s)", n, decoded, frames,
+                (double)n / frames, age);
+    shell_print(sh, "压缩后 %u 字节 (%.2f B/条), CSV 约 %u 字节, 压缩比 %.1f",
+                bytes, (double)bytes / n, n * CSV_BYTES_PER_RECORD,
+                (double)(n * CSV_BYTES_PER_RECORD) / bytes);
+    shell_print(sh, "编码 %u ns/条, 解码 %u ns/条",
+                (uint32_t)(k_cyc_to_ns_floor64(enc_cycles) / n),
+                (uint32_t)(k_cyc_to_ns_floor64(dec_cycles) / n));
+    return 0;
+}
+
+/* 二进制导出：输出的是 COBS 帧流，需配合 tools/log_export.py 接收 */
+static int cmd_datalog_export(const struct shell *sh, size_t argc, char **argv)
+{
+    uint32_t from_seg = (argc > 1) ? strtoul(argv[1], NULL, 10) : 0;
+    uint32_t offset = (argc > 2) ? strtoul(argv[2], NULL, 10) : 0;
+    int ret = log_export_run(sh, from_seg, offset);
+
+    if (ret == -EBUSY) {
+        shell_error(sh, "已有导出正在进行");
+    }
+    return ret;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_datalog,
+    SHELL_CMD(info, NULL, "显示日志分段占用情况", cmd_datalog_info),
+    SHELL_CMD_ARG(query, NULL,
+                  "按时间范围查询: query <from> <to> [none|avg|min|max|count]",
+                  cmd_datalog_query, 3, 1),
+    SHELL_CMD_ARG(bench, NULL, "压缩器基准测试: bench [记录数] [帧跨度秒, 0 只按帧满]",
+                  cmd_datalog_bench, 1, 2),
+    SHELL_CMD_ARG(export, NULL, "二进制导出 (配合 tools/log_export.py): export [分段] [偏移]",
+                  cmd_datalog_export, 1, 2),
+    SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(datalog, &sub_datalog, "传感器日志命令", NULL);
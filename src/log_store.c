@@ -0,0 +1,598 @@
+/*
+ * application/src/log_store.c
+ * 分段日志存储：定长分段 + 按大小/时间轮转 + 配额回收
+ *
+ * LittleFS 对单个不断增长的文件追加时，CTZ 跳表越来越长，追加成本随之上升；
+ * 把数据切成固定大小的分段后，每次追加只作用于一个小文件，成本保持恒定。
+ *
+ * 分段内容是一串 ts_codec 压缩帧：记录先在 RAM 中编码，帧写满或帧跨度超过
+ * LOG_FRAME_MAX_AGE_S 时才落盘，稀疏索引点总是落在帧边界上。
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/fs/fs.h>
+#include <zephyr/drivers/rtc.h>
+#include <zephyr/sys/timeutil.h>
+#include <zephyr/logging/log.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include "log_store.h"
+#include "ts_codec.h"
+
+LOG_MODULE_REGISTER(LOG_STORE, LOG_LEVEL_INF);
+
+#define RTC_NODE DT_NODELABEL(rtc)
+
+#if defined(CONFIG_RTC) && DT_NODE_HAS_STATUS(RTC_NODE, okay)
+static const struct device *rtc_dev = DEVICE_DT_GET(RTC_NODE);
+#endif
+
+/* 内存中的分段表，按起始时间升序排列 */
+struct log_segment {
+    uint32_t start;   // 分段起始时间戳 (即文件名)
+    uint32_t size;    // 分段当前字节数
+};
+
+static struct log_segment segs[LOG_STORE_MAX_SEGMENTS];
+static uint32_t seg_count;
+static uint32_t total_bytes;
+
+/* 当前正在追加的分段 (始终是 segs[seg_count - 1]) */
+static struct fs_file_t cur_file;
+static bool cur_open;
+static uint32_t cur_next_mark;    // 当前分段下一个索引点的偏移
+
+/* 稀疏索引项：分段内偏移 offset 处开始的记录时间戳为 ts */
+struct log_index_entry {
+    uint32_t ts;
+    uint32_t offset;
+};
+
+/* 没有有效 RTC 时使用的伪时间基准 */
+static uint32_t boot_base;
+
+/* 正在 RAM 中累积的压缩帧 */
+static struct ts_encoder enc;
+
+static K_MUTEX_DEFINE(store_lock);
+
+/* 查询使用的帧缓冲区较大，放在静态区，多个查询串行执行 */
+static uint8_t query_frame[TS_FRAME_SIZE];
+static struct ts_encoder query_enc;
+static K_MUTEX_DEFINE(query_lock);
+
+/* 查询过滤器：把帧解码结果限制在 [from, to] 内 */
+struct query_filter {
+    uint32_t from;
+    uint32_t to;
+    log_query_cb_t cb;
+    void *user_data;
+    int matched;
+};
+
+static void seg_path(uint32_t start, char *path)
+{
+    snprintf(path, LOG_SEG_PATH_MAX, LOG_STORE_DIR "/%010u.ts", start);
+}
+
+static void idx_path(uint32_t start, char *path)
+{
+    snprintf(path, LOG_SEG_PATH_MAX, LOG_STORE_DIR "/%010u.idx", start);
+}
+
+uint32_t log_store_now(void)
+{
+#if defined(CONFIG_RTC) && DT_NODE_HAS_STATUS(RTC_NODE, okay)
+    struct rtc_time tm;
+
+    // RTC 未设置时 rtc_get_time 返回 -ENODATA，此时退回伪时间
+    if (device_is_ready(rtc_dev) && rtc_get_time(rtc_dev, &tm) == 0) {
+        return (uint32_t)timeutil_timegm(rtc_time_to_tm(&tm));
+    }
+#endif
+    return boot_base + (uint32_t)k_uptime_seconds();
+}
+
+/* 插入排序：分段数量很少 (约百个)，且扫描时目录本身基本有序 */
+static int seg_insert(uint32_t start, uint32_t size)
+{
+    uint32_t i;
+
+    if (seg_count >= LOG_STORE_MAX_SEGMENTS) {
+        return -ENOMEM;
+    }
+
+    for (i = seg_count; i > 0 && segs[i - 1].start > start; i--) {
+        segs[i] = segs[i - 1];
+    }
+    segs[i].start = start;
+    segs[i].size = size;
+    seg_count++;
+    total_bytes += size;
+    return 0;
+}
+
+/* 删除最旧的分段，释放配额 */
+static int seg_drop_oldest(void)
+{
+    char path[LOG_SEG_PATH_MAX];
+    int ret;
+
+    // 当前正在写的分段不能删除
+    if (seg_count <= 1) {
+        return -ENOSPC;
+    }
+
+    seg_path(segs[0].start, path);
+    ret = fs_unlink(path);
+    if (ret < 0 && ret != -ENOENT) {
+        LOG_ERR("删除分段 %s 失败: %d", path, ret);
+        return ret;
+    }
+
+    idx_path(segs[0].start, path);
+    fs_unlink(path);
+
+    LOG_INF("配额回收: 删除分段 %010u (%u 字节)", segs[0].start, segs[0].size);
+    total_bytes -= segs[0].size;
+    memmove(&segs[0], &segs[1], (seg_count - 1) * sizeof(segs[0]));
+    seg_count--;
+    return 0;
+}
+
+static void seg_close_current(void)
+{
+    if (cur_open) {
+        fs_close(&cur_file);
+        cur_open = false;
+    }
+}
+
+/* 打开最新分段用于追加 (重启后继续写上次未写满的分段) */
+static int seg_open_current(void)
+{
+    char path[LOG_SEG_PATH_MAX];
+    int ret;
+
+    seg_path(segs[seg_count - 1].start, path);
+    fs_file_t_init(&cur_file);
+    ret = fs_open(&cur_file, path, FS_O_CREATE | FS_O_WRITE | FS_O_APPEND);
+    if (ret < 0) {
+        LOG_ERR("打开分段 %s 失败: %d", path, ret);
+        return ret;
+    }
+    cur_open = true;
+    cur_next_mark = (segs[seg_count - 1].size / LOG_INDEX_STRIDE + 1) * LOG_INDEX_STRIDE;
+    return 0;
+}
+
+/* 当前分段越过一个索引点后，为即将写入的记录追加一条索引 */
+static void seg_index_mark(uint32_t ts)
+{
+    const struct log_segment *cur = &segs[seg_count - 1];
+    struct log_index_entry entry = {.ts = ts, .offset = cur->size};
+    char path[LOG_SEG_PATH_MAX];
+    struct fs_file_t file;
+
+    if (cur->size < cur_next_mark) {
+        return;
+    }
+    cur_next_mark = (cur->size / LOG_INDEX_STRIDE + 1) * LOG_INDEX_STRIDE;
+
+    idx_path(cur->start, path);
+    fs_file_t_init(&file);
+    if (fs_open(&file, path, FS_O_CREATE | FS_O_WRITE | FS_O_APPEND) == 0) {
+        fs_write(&file, &entry, sizeof(entry));
+        fs_close(&file);
+    }
+}
+
+/* 在分段的稀疏索引中找到 ts 之前最近的索引点，返回可以直接 seek 的偏移 */
+static off_t seg_index_lookup(uint32_t start, uint32_t ts)
+{
+    struct log_index_entry entry;
+    char path[LOG_SEG_PATH_MAX];
+    struct fs_file_t file;
+    off_t off = 0;
+
+    idx_path(start, path);
+    fs_file_t_init(&file);
+    if (fs_open(&file, path, FS_O_READ) < 0) {
+        return 0;
+    }
+    // 每个分段最多 LOG_SEG_MAX_BYTES / LOG_INDEX_STRIDE 条索引，顺序读即可
+    while (fs_read(&file, &entry, sizeof(entry)) == sizeof(entry)) {
+        if (entry.ts > ts) {
+            break;
+        }
+        off = entry.offset;
+    }
+    fs_close(&file);
+    return off;
+}
+
+/* 返回非 0 时解码器停止：越过 to，或者用户回调要求停止 */
+static int query_filter_cb(const struct log_record *rec, void *user_data)
+{
+    struct query_filter *f = user_data;
+
+    if (rec->ts < f->from) {
+        return 0;
+    }
+    if (rec->ts > f->to) {
+        return 1;
+    }
+    f->matched++;
+    return f->cb(rec, f->user_data);
+}
+
+/* 读取一个分段中 [from, to] 范围内的记录；返回值 > 0 表示已越过 to，可以停止 (持 query_lock) */
+static int seg_query(uint32_t start, struct query_filter *f)
+{
+    struct ts_frame_hdr *hdr = (struct ts_frame_hdr *)query_frame;
+    char path[LOG_SEG_PATH_MAX];
+    struct fs_file_t file;
+    ssize_t n;
+    int ret;
+
+    seg_path(start, path);
+    fs_file_t_init(&file);
+    ret = fs_open(&file, path, FS_O_READ);
+    if (ret < 0) {
+        // 查询期间分段可能刚被配额回收，跳过即可
+        return 0;
+    }
+
+    ret = fs_seek(&file, seg_index_lookup(start, f->from), FS_SEEK_SET);
+    if (ret < 0) {
+        goto out;
+    }
+
+    while (1) {
+        n = fs_read(&file, hdr, sizeof(*hdr));
+        if (n < (ssize_t)sizeof(*hdr)) {
+            ret = (n < 0) ? (int)n : 0;
+            break;
+        }
+        if (hdr->magic != TS_FRAME_MAGIC || hdr->len < sizeof(*hdr) || hdr->len > TS_FRAME_SIZE) {
+            LOG_WRN("分段 %010u 中帧头损坏，跳过剩余部分", start);
+            ret = 0;
+            break;
+        }
+
+        /* 整帧早于 from：不解码，直接跳过 */
+        if (hdr->last_ts < f->from) {
+            ret = fs_seek(&file, hdr->len - sizeof(*hdr), FS_SEEK_CUR);
+            if (ret < 0) {
+                break;
+            }
+            continue;
+        }
+        if (hdr->first_ts > f->to) {
+            ret = 1;
+            break;
+        }
+
+        n = fs_read(&file, query_frame + sizeof(*hdr), hdr->len - sizeof(*hdr));
+        if (n != hdr->len - sizeof(*hdr)) {
+            ret = (n < 0) ? (int)n : 0;
+            break;
+        }
+        ret = ts_decode_frame(query_frame, hdr->len, query_filter_cb, f);
+        if (ret == -ECANCELED) {
+            ret = 1;
+            break;
+        }
+        if (ret < 0) {
+            LOG_WRN("分段 %010u 中的帧校验失败", start);
+        }
+    }
+
+out:
+    fs_close(&file);
+    return ret;
+}
+
+/* 开启新分段，起始时间必须严格大于上一个分段，保证文件名唯一且有序 */
+static int seg_rotate(uint32_t ts)
+{
+    int ret;
+
+    seg_close_current();
+
+    if (seg_count > 0 && ts <= segs[seg_count - 1].start) {
+        ts = segs[seg_count - 1].start + 1;
+    }
+
+    if (seg_count >= LOG_STORE_MAX_SEGMENTS) {
+        ret = seg_drop_oldest();
+        if (ret < 0) {
+            return ret;
+        }
+    }
+
+    ret = seg_insert(ts, 0);
+    if (ret < 0) {
+        return ret;
+    }
+
+    LOG_INF("新分段: " LOG_STORE_DIR "/%010u.ts", ts);
+    return seg_open_current();
+}
+
+static bool seg_needs_rotate(uint32_t ts, size_t len)
+{
+    const struct log_segment *cur;
+
+    if (seg_count == 0) {
+        return true;
+    }
+
+    cur = &segs[seg_count - 1];
+    return (cur->size + len > LOG_SEG_MAX_BYTES) ||
+           (ts >= cur->start + LOG_SEG_MAX_AGE_S);
+}
+
+int log_store_init(void)
+{
+    struct fs_dir_t dir;
+    struct fs_dirent entry;
+    int ret;
+
+    ret = fs_mkdir(LOG_STORE_DIR);
+    if (ret < 0 && ret != -EEXIST) {
+        LOG_ERR("创建目录 %s 失败: %d", LOG_STORE_DIR, ret);
+        return ret;
+    }
+
+    k_mutex_lock(&store_lock, K_FOREVER);
+
+    seg_close_current();
+    seg_count = 0;
+    total_bytes = 0;
+
+    fs_dir_t_init(&dir);
+    ret = fs_opendir(&dir, LOG_STORE_DIR);
+    if (ret < 0) {
+        LOG_ERR("打开目录失败: %d", ret);
+        goto out;
+    }
+
+    while (fs_readdir(&dir, &entry) == 0 && entry.name[0] != '\0') {
+        char *end;
+        uint32_t start;
+
+        if (entry.type != FS_DIR_ENTRY_FILE) {
+            continue;
+        }
+        // 只认 "<10 位时间戳>.ts" 形式的文件
+        start = strtoul(entry.name, &end, 10);
+        if (end != entry.name + 10 || strcmp(end, ".ts") != 0) {
+            continue;
+        }
+        if (seg_insert(start, entry.size) < 0) {
+            LOG_WRN("分段数量超过上限，忽略 %s", entry.name);
+        }
+    }
+    fs_closedir(&dir);
+
+    /* 伪时间从最新分段可能覆盖的最后时刻之后开始，保证跨重启单调 */
+    if (seg_count > 0) {
+        boot_base = segs[seg_count - 1].start + LOG_SEG_MAX_AGE_S;
+    }
+
+    ts_encoder_reset(&enc);
+
+    LOG_INF("日志存储就绪: %u 个分段, 共 %u 字节", seg_count, total_bytes);
+    ret = 0;
+
+out:
+    k_mutex_unlock(&store_lock);
+    return ret;
+}
+
+/* 把 RAM 中的压缩帧写入当前分段 (调用方持 store_lock) */
+static int frame_flush(void)
+{
+    ssize_t written;
+    size_t len;
+    uint32_t ts = enc.first_ts;
+    int ret = 0;
+
+    len = ts_encoder_finish(&enc);
+    if (len == 0) {
+        return 0;
+    }
+
+    if (seg_needs_rotate(ts, len)) {
+        ret = seg_rotate(ts);
+    } else if (!cur_open) {
+        ret = seg_open_current();
+    }
+    if (ret < 0) {
+        goto out;
+    }
+
+    seg_index_mark(ts);
+
+    written = fs_write(&cur_file, enc.frame, len);
+    if (written == -ENOSPC && seg_drop_oldest() == 0) {
+        // 文件系统已满：先腾出最旧的分段再重试一次
+        written = fs_write(&cur_file, enc.frame, len);
+    }
+    if (written < 0) {
+        ret = (int)written;
+        LOG_ERR("写入分段失败: %d", ret);
+        goto out;
+    }
+
+    // 保持文件打开，每帧只同步一次，避免每次都重新查找路径
+    ret = fs_sync(&cur_file);
+
+    segs[seg_count - 1].size += written;
+    total_bytes += written;
+
+    while (total_bytes > LOG_STORE_QUOTA_BYTES) {
+        if (seg_drop_oldest() < 0) {
+            break;
+        }
+    }
+
+out:
+    // 写入失败时也丢弃该帧，避免编码器一直处于“已满”状态
+    ts_encoder_reset(&enc);
+    return ret;
+}
+
+int log_store_append(const struct log_record *rec)
+{
+    int ret = 0;
+
+    k_mutex_lock(&store_lock, K_FOREVER);
+
+    if (ts_encoder_add(&enc, rec) == -ENOSPC) {
+        ret = frame_flush();
+        ts_encoder_add(&enc, rec);
+    }
+
+    /* 帧跨度过长时提前落盘，限制掉电时丢失的数据量 */
+    if (rec->ts - enc.first_ts >= LOG_FRAME_MAX_AGE_S) {
+        ret = frame_flush();
+    }
+
+    k_mutex_unlock(&store_lock);
+    return ret;
+}
+
+int log_store_flush(void)
+{
+    int ret;
+
+    k_mutex_lock(&store_lock, K_FOREVER);
+    ret = frame_flush();
+    k_mutex_unlock(&store_lock);
+    return ret;
+}
+
+/* 二分查找最后一个 start <= ts 的分段；ts 早于所有分段时返回最旧的分段 (调用方持锁) */
+static int seg_lookup(uint32_t ts)
+{
+    uint32_t lo = 0, hi = seg_count;
+
+    if (seg_count == 0) {
+        return -ENOENT;
+    }
+
+    while (lo < hi) {
+        uint32_t mid = (lo + hi) / 2;
+
+        if (segs[mid].start <= ts) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return (lo == 0) ? 0 : (int)(lo - 1);
+}
+
+int log_store_find_segment(uint32_t ts, char *path)
+{
+    int idx;
+
+    k_mutex_lock(&store_lock, K_FOREVER);
+    idx = seg_lookup(ts);
+    if (idx >= 0) {
+        seg_path(segs[idx].start, path);
+    }
+    k_mutex_unlock(&store_lock);
+    return idx;
+}
+
+int log_store_query(uint32_t from, uint32_t to, log_query_cb_t cb, void *user_data)
+{
+    struct query_filter f = {
+        .from = from, .to = to, .cb = cb, .user_data = user_data,
+    };
+    uint32_t start;
+    size_t len;
+    int idx, ret = 0;
+
+    if (from > to) {
+        return -EINVAL;
+    }
+
+    k_mutex_lock(&query_lock, K_FOREVER);
+
+    k_mutex_lock(&store_lock, K_FOREVER);
+    idx = seg_lookup(from);
+    start = (idx >= 0) ? segs[idx].start : 0;
+    k_mutex_unlock(&store_lock);
+
+    while (idx >= 0 && start <= to) {
+        // 只在读取分段表时持锁，读文件期间存储线程照常写入
+        ret = seg_query(start, &f);
+        if (ret != 0) {
+            goto out;
+        }
+
+        /* 下一个分段：按起始时间定位，容忍查询期间发生的轮转和回收 */
+        k_mutex_lock(&store_lock, K_FOREVER);
+        idx = seg_lookup(start);
+        if (idx >= 0 && segs[idx].start <= start) {
+            idx++;
+        }
+        if (idx < 0 || idx >= (int)seg_count) {
+            idx = -ENOENT;
+        } else {
+            start = segs[idx].start;
+        }
+        k_mutex_unlock(&store_lock);
+    }
+
+    /* 最后是尚未落盘、仍在 RAM 中的帧 */
+    k_mutex_lock(&store_lock, K_FOREVER);
+    query_enc = enc;
+    k_mutex_unlock(&store_lock);
+
+    len = ts_encoder_finish(&query_enc);
+    if (len > 0 && query_enc.first_ts <= to) {
+        ret = ts_decode_frame(query_enc.frame, len, query_filter_cb, &f);
+    }
+
+out:
+    k_mutex_unlock(&query_lock);
+    return (ret < 0 && ret != -ECANCELED) ? ret : f.matched;
+}
+
+int log_store_next_segment(uint32_t from, uint32_t *start, uint32_t *size)
+{
+    int ret = -ENOENT;
+
+    k_mutex_lock(&store_lock, K_FOREVER);
+    for (uint32_t i = 0; i < seg_count; i++) {
+        if (segs[i].start >= from) {
+            *start = segs[i].start;
+            *size = segs[i].size;
+            ret = 0;
+            break;
+        }
+    }
+    k_mutex_unlock(&store_lock);
+    return ret;
+}
+
+void log_store_segment_path(uint32_t start, char *path)
+{
+    seg_path(start, path);
+}
+
+void log_store_usage(uint32_t *segments, uint32_t *bytes)
+{
+    k_mutex_lock(&store_lock, K_FOREVER);
+    *segments = seg_count;
+    *bytes = total_bytes;
+    k_mutex_unlock(&store_lock);
+}
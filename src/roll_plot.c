@@ -0,0 +1,163 @@
+/*
+ * application/src/roll_plot.c
+ * 整屏滚动光照曲线：每个采样只发送一列像素，靠 ST7789V 的硬件滚动移动画面
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/display.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/logging/log.h>
+#include <lvgl.h>
+
+#include "roll_plot.h"
+#include "lcd_flush.h"
+#include "display_thread.h"
+#include "ap3216c.h"
+#include "st7789v.h"
+
+LOG_MODULE_REGISTER(ROLL_PLOT, LOG_LEVEL_INF);
+
+/* 颜色 (RGB565)，写入前转换为线上字节序 */
+#define ROLL_COLOR_BG     0x0000
+#define ROLL_COLOR_GRID   0x2104
+#define ROLL_COLOR_LINE   0xFFE0     // 黄色，与仪表盘的光照曲线一致
+
+static atomic_t want;
+static bool active;
+
+static uint16_t col_buf[ST7789V_RAM_COLS];
+static uint16_t width;              // 滚动方向 (时间轴) 的列数
+static uint16_t height;             // 每列像素数
+static uint16_t pos;                // 下一个采样写入的列
+static uint32_t samples;
+static int prev_y;
+
+static int draw_column(const struct device *dev, int y)
+{
+    struct display_buffer_descriptor desc = {
+        .buf_size = height * sizeof(uint16_t),
+        .width = 1,
+        .height = height,
+        .pitch = 1,
+    };
+    uint16_t bg = sys_cpu_to_be16((samples % ROLL_PLOT_GRID_COLS == 0) ? ROLL_COLOR_GRID
+                                                                        : ROLL_COLOR_BG);
+
+    for (uint16_t i = 0; i < height; i++) {
+        col_buf[i] = bg;
+    }
+    for (uint32_t v = ROLL_PLOT_GRID_VALUE; v < ROLL_PLOT_RANGE; v += ROLL_PLOT_GRID_VALUE) {
+        col_buf[height - 1 - v * (height - 1) / ROLL_PLOT_RANGE] = sys_cpu_to_be16(ROLL_COLOR_GRID);
+    }
+
+    /* 与上一个点连成竖线，曲线在快速变化时不断开 */
+    if (y >= 0) {
+        int from = (prev_y >= 0) ? MIN(prev_y, y) : y;
+        int to = (prev_y >= 0) ? MAX(prev_y, y) : y;
+
+        for (int i = from; i <= to; i++) {
+            col_buf[i] = sys_cpu_to_be16(ROLL_COLOR_LINE);
+        }
+    }
+
+    return display_write(dev, pos, 0, &desc, col_buf);
+}
+
+static int roll_push(const struct device *dev, uint16_t lux)
+{
+    int y = height - 1 - MIN(lux, ROLL_PLOT_RANGE) * (height - 1) / ROLL_PLOT_RANGE;
+    int ret;
+
+    ret = draw_column(dev, y);
+    if (ret < 0) {
+        return ret;
+    }
+    prev_y = y;
+    samples++;
+    pos = (pos + 1) % width;
+
+    /* 最新的一列在最右侧 */
+    return st7789v_scroll_to(dev, pos);
+}
+
+static int roll_enter(const struct device *dev)
+{
+    struct display_capabilities cap;
+    int ret;
+
+    /* LVGL 最后一块像素发送完之后才能改方向 */
+    lcd_flush_wait();
+    ret = st7789v_scroll_begin(dev);
+    if (ret < 0) {
+        return ret;
+    }
+
+    display_get_capabilities(dev, &cap);
+    width = cap.x_resolution;
+    height = MIN(cap.y_resolution, ARRAY_SIZE(col_buf));
+    pos = 0;
+    samples = 1;
+    prev_y = -1;
+
+    /* 整屏画一次背景网格，之后每个采样只写一列 */
+    for (uint16_t i = 0; i < width && ret == 0; i++) {
+        ret = draw_column(dev, -1);
+        samples++;
+        pos++;
+    }
+    pos = 0;
+    samples = 0;
+    k_msgq_purge(&als_msgq);
+    return ret;
+}
+
+void roll_plot_request(bool on)
+{
+    atomic_set(&want, on);
+    display_wake(DISPLAY_EVT_CMD);
+}
+
+bool roll_plot_is_active(void)
+{
+    return active;
+}
+
+bool roll_plot_poll(const struct device *dev)
+{
+    bool on = atomic_get(&want) != 0;
+    uint16_t lux;
+    int ret;
+
+    if (on && !active) {
+        ret = roll_enter(dev);
+        if (ret < 0) {
+            LOG_ERR("进入滚动图模式失败: %d", ret);
+            st7789v_scroll_end(dev);
+            atomic_set(&want, 0);
+            lv_obj_invalidate(lv_screen_active());
+            return false;
+        }
+        active = true;
+        LOG_INF("滚动图模式 %ux%u", width, height);
+    } else if (!on && active) {
+        st7789v_scroll_end(dev);
+        active = false;
+        /* 恢复方向后整屏重绘仪表盘 */
+        lv_obj_invalidate(lv_screen_active());
+        return false;
+    }
+
+    if (!active) {
+        return false;
+    }
+
+    /* 光照采样由本模式接收，仪表盘的定时器此时不运行 */
+    while (k_msgq_get(&als_msgq, &lux, K_NO_WAIT) == 0) {
+        ret = roll_push(dev, lux);
+        if (ret < 0) {
+            LOG_WRN("滚动图写入失败: %d", ret);
+            break;
+        }
+    }
+    return true;
+}
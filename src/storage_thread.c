@@ -1,48 +1,118 @@
 #include <zephyr/kernel.h>
-#include <zephyr/fs/fs.h>
 #include <zephyr/logging/log.h>
-#include <stdio.h>
+#include <math.h>
 #include <string.h>
 
 #include "data_center.h"
+#include "log_store.h"
+#include "flash_stats.h"
+#include "boot_prof.h"
 
 LOG_MODULE_REGISTER(STORAGE_TASK, LOG_LEVEL_INF);
 
-#define SAVE_INTERVAL_MS  (5 * 60 * 1000) // 正式使用设为 5 分钟
-#define CSV_FILE_PATH     "/lfs/data.csv"
+/* ---------------- 配置参数 ---------------- */
+/*
+ * 变化驱动 (死区) 记录策略：
+ * 某个通道的值偏离上次记录值超过该通道的死区，或距离上次记录超过最长静默时间，
+ * 就写一条记录。稳定时几乎不写，瞬变按传感器采样分辨率记录。
+ *
+ * 每条记录都包含全部通道，任何一次写入都同时刷新所有通道的记录值，
+ * 所以静默时间只有一个：按通道分别设置时，起作用的永远是其中最短的那个。
+ */
+#define DEADBAND_TEMP_C         0.2f                 // 温度死区 (°C)
+#define DEADBAND_HUMI_RH        1.0f                 // 湿度死区 (%RH)
+#define DEADBAND_LUX            20                   // 光照死区 (原始值)
+#define MAX_SILENCE_MS          (30 * 60 * 1000)     // 最长静默时间 (所有通道共用)
+
+enum log_channel {
+    CH_TEMP,
+    CH_HUMI,
+    CH_LUX,
+    CH_COUNT,
+};
+
+static const float deadband[CH_COUNT] = {
+    [CH_TEMP] = DEADBAND_TEMP_C,
+    [CH_HUMI] = DEADBAND_HUMI_RH,
+    [CH_LUX] = DEADBAND_LUX,
+};
+
+static void snapshot_values(const system_data_t *snap, float val[CH_COUNT])
+{
+    val[CH_TEMP] = snap->env.temperature;
+    val[CH_HUMI] = snap->env.humidity;
+    val[CH_LUX] = snap->lux;
+}
+
+/* 距离静默超时还有多久 */
+static k_timeout_t next_deadline(int64_t last_write)
+{
+    int64_t remain = last_write + MAX_SILENCE_MS - k_uptime_get();
+
+    return K_MSEC(MAX(remain, 0));
+}
 
 void storage_thread_entry(void *p1, void *p2, void *p3)
 {
     int ret;
-    struct fs_file_t file;
-    fs_file_t_init(&file);
+    bool have_last = false;
+    float last_val[CH_COUNT] = {0};
+    float val[CH_COUNT];
+    int64_t last_write = 0;
+    uint32_t events, seen = 0;
 
-    LOG_INF("数据存储线程已就绪 (CSV 格式)");
+    /* 等待文件系统挂载完成，再扫描分段目录 */
+    boot_ready_wait(BOOT_READY_FS, K_FOREVER);
+    ret = log_store_init();
+    if (ret < 0) {
+        LOG_ERR("日志存储初始化失败: %d", ret);
+        return;
+    }
+
+    LOG_INF("数据存储线程已就绪 (死区记录模式)");
 
     while (1) {
-        /* 1. 周期性等待 */
-        k_msleep(SAVE_INTERVAL_MS);
+        /* 1. 等待温湿度/光照更新，或最早的静默超时 */
+        events = data_center_wait(DC_EVT_ENV | DC_EVT_LUX,
+                                  have_last ? next_deadline(last_write) : K_FOREVER);
+
+        /* 两类数据都到齐之后才写第一条，避免记下未初始化的 0 值 */
+        seen |= events;
+        if (!have_last && seen != (DC_EVT_ENV | DC_EVT_LUX)) {
+            continue;
+        }
 
         system_data_t snap;
         data_center_get_snapshot(&snap);
+        snapshot_values(&snap, val);
+
+        /* 2. 判断是否需要记录 */
+        bool due = !have_last || k_uptime_get() - last_write >= MAX_SILENCE_MS;
+
+        for (int i = 0; i < CH_COUNT && !due; i++) {
+            due = fabsf(val[i] - last_val[i]) > deadband[i];
+        }
+        if (!due) {
+            continue;
+        }
+
+        struct log_record rec = {
+            .ts = log_store_now(),
+            .temperature = snap.env.temperature,
+            .humidity = snap.env.humidity,
+            .lux = snap.lux,
+        };
 
-        /* 构造 CSV 数据行 */
-        char row[128];
-        // 确保 prj.conf 中有 CONFIG_CBPRINTF_FP_SUPPORT=y
-        snprintf(row, sizeof(row), "%u,%.2f,%.2f,%u\n", 
-                 (uint32_t)(k_uptime_get() / 1000), 
-                 (double)snap.env.temperature, 
-                 (double)snap.env.humidity, 
-                 snap.lux);
-
-        /* 4. 执行文件写入 */
-        ret = fs_open(&file, CSV_FILE_PATH, FS_O_CREATE | FS_O_WRITE | FS_O_APPEND);
+        /* 3. 追加到当前分段 (自动轮转、索引与配额回收) */
+        ret = log_store_append(&rec);
         if (ret == 0) {
-            fs_write(&file, row, strlen(row));
-            fs_close(&file);
-            LOG_DBG("[存储成功] 内容: %s", row);
+            LOG_DBG("[存储成功] ts=%u (事件 0x%x)", rec.ts, events);
+            flash_stats_note_record(sizeof(rec));
+            memcpy(last_val, val, sizeof(last_val));
+            last_write = k_uptime_get();
+            have_last = true;
         } else {
-            LOG_ERR("文件打开失败: %d", ret);
+            LOG_ERR("记录写入失败: %d", ret);
         }
     }
 }
@@ -52,6 +122,6 @@ void storage_thread_entry(void *p1, void *p2, void *p3)
 #define STORAGE_PRIORITY 12
 #define STORAGE_STACK_SIZE 2048
 
-K_THREAD_DEFINE(storage_tid, STORAGE_STACK_SIZE, 
-                storage_thread_entry, NULL, NULL, NULL, 
-                STORAGE_PRIORITY, 0, 0);
\ No newline at end of file
+K_THREAD_DEFINE(storage_tid, STORAGE_STACK_SIZE,
+                storage_thread_entry, NULL, NULL, NULL,
+                STORAGE_PRIORITY, 0, 0);
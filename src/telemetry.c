@@ -0,0 +1,232 @@
+/*
+ * application/src/telemetry.c
+ * 实时遥测：二进制帧 → 双缓冲 → UART 异步 API (DMA)
+ *
+ * 缓冲区所有权：
+ *   - fill_idx 指向的缓冲区由采样线程追加帧；
+ *   - 另一个缓冲区 (tx_busy 时) 正在由 DMA 发送。
+ * 发送完成回调 (中断上下文) 里如果填充缓冲区有数据就立即交换并继续发送，
+ * 两者之间的交接用自旋锁保护。
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/uart.h>
+#include <zephyr/sys/crc.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/logging/log.h>
+#include <string.h>
+
+#include "telemetry.h"
+#include "data_center.h"
+
+LOG_MODULE_REGISTER(TELEMETRY, LOG_LEVEL_INF);
+
+/* ---------------- 配置参数 ---------------- */
+/* 遥测串口由 chosen 节点 app,telemetry-uart 指定，需要配置 DMA */
+#define TELEM_UART_NODE   DT_CHOSEN(app_telemetry_uart)
+
+/*
+ * 遥测串口不能是控制台或 Shell 串口：异步回调会替换 Shell 的中断回调 (Shell 失去响应)，
+ * 日志输出也会混进二进制帧
+ */
+#define TELEM_UART_IS(chosen) \
+    COND_CODE_1(DT_HAS_CHOSEN(chosen), (DT_SAME_NODE(TELEM_UART_NODE, DT_CHOSEN(chosen))), (0))
+#define TELEM_UART_SHARED  (TELEM_UART_IS(zephyr_console) || TELEM_UART_IS(zephyr_shell_uart))
+
+#define TELEM_SYNC0       0xA5
+#define TELEM_SYNC1       0x5A
+#define TELEM_HDR_SIZE    12
+#define TELEM_FRAME_MAX   (TELEM_HDR_SIZE + 12 + 4 + 2 + 2)
+
+static const struct device *const uart_dev = DEVICE_DT_GET(TELEM_UART_NODE);
+
+static uint8_t bufs[2][TELEM_BUF_SIZE] __aligned(4);
+static uint8_t fill_idx;
+static size_t fill_len;
+static bool tx_busy;
+static struct k_spinlock lock;
+
+static volatile bool running;
+static bool cb_ready;
+static uint8_t ch_mask;
+static uint16_t decimation;
+static uint16_t decim_cnt;
+
+static uint32_t seq;
+static uint32_t stat_dropped;
+static uint32_t stat_bytes;
+static uint32_t stat_tx_errors;
+
+/* 交换缓冲区并启动 DMA 发送 (调用方持锁) */
+static void tx_kick_locked(void)
+{
+    uint8_t idx = fill_idx;
+    size_t len = fill_len;
+
+    fill_idx ^= 1;
+    fill_len = 0;
+    tx_busy = true;
+
+    if (uart_tx(uart_dev, bufs[idx], len, SYS_FOREVER_US) < 0) {
+        tx_busy = false;
+        stat_tx_errors++;
+    }
+}
+
+static void uart_cb(const struct device *dev, struct uart_event *evt, void *user_data)
+{
+    k_spinlock_key_t key;
+
+    switch (evt->type) {
+    case UART_TX_DONE:
+    case UART_TX_ABORTED:
+        key = k_spin_lock(&lock);
+        stat_bytes += evt->data.tx.len;
+        tx_busy = false;
+        if (running && fill_len > 0) {
+            tx_kick_locked();
+        }
+        k_spin_unlock(&lock, key);
+        break;
+    default:
+        break;
+    }
+}
+
+/* 按通道掩码打包一帧，返回帧长度 */
+static size_t frame_build(uint8_t *f, const int16_t raw[7])
+{
+    uint8_t *p = f + TELEM_HDR_SIZE;
+
+    if (ch_mask & TELEM_CH_IMU) {
+        sys_put_le16(raw[0], p);
+        sys_put_le16(raw[1], p + 2);
+        sys_put_le16(raw[2], p + 4);
+        sys_put_le16(raw[4], p + 6);
+        sys_put_le16(raw[5], p + 8);
+        sys_put_le16(raw[6], p + 10);
+        p += 12;
+    }
+    /* 1 kHz 路径上不拿数据中心的互斥锁，读无锁副本 */
+    if (ch_mask & TELEM_CH_ENV) {
+        int16_t temp;
+        uint16_t humi;
+
+        data_center_peek_env(&temp, &humi);
+        sys_put_le16(temp, p);
+        sys_put_le16(humi, p + 2);
+        p += 4;
+    }
+    if (ch_mask & TELEM_CH_LUX) {
+        sys_put_le16(data_center_peek_lux(), p);
+        p += 2;
+    }
+
+    f[0] = TELEM_SYNC0;
+    f[1] = TELEM_SYNC1;
+    f[2] = ch_mask;
+    f[3] = (uint8_t)(p - f - TELEM_HDR_SIZE);
+    sys_put_le32(seq, &f[4]);
+    sys_put_le32((uint32_t)k_cyc_to_us_floor64(k_cycle_get_64()), &f[8]);
+    sys_put_le16(crc16_ccitt(0xFFFF, f + 2, p - f - 2), p);
+
+    return p - f + 2;
+}
+
+void telemetry_push_imu(const int16_t raw[7])
+{
+    uint8_t frame[TELEM_FRAME_MAX];
+    k_spinlock_key_t key;
+    size_t len;
+
+    if (!running || ++decim_cnt < decimation) {
+        return;
+    }
+    decim_cnt = 0;
+
+    len = frame_build(frame, raw);
+    seq++;
+
+    key = k_spin_lock(&lock);
+    if (fill_len + len <= TELEM_BUF_SIZE) {
+        memcpy(&bufs[fill_idx][fill_len], frame, len);
+        fill_len += len;
+    } else {
+        stat_dropped++;
+    }
+    if (!tx_busy && fill_len > 0) {
+        tx_kick_locked();
+    }
+    k_spin_unlock(&lock, key);
+}
+
+uint16_t telemetry_wanted_odr(void)
+{
+    return (running && (ch_mask & TELEM_CH_IMU)) ? TELEM_DEFAULT_ODR_HZ : 0;
+}
+
+int telemetry_start(uint8_t mask, uint16_t decim)
+{
+    int ret;
+
+    if (mask == 0 || (mask & ~TELEM_CH_ALL) || decim == 0) {
+        return -EINVAL;
+    }
+    if (TELEM_UART_SHARED) {
+        LOG_ERR("遥测串口 %s 同时是控制台/Shell 串口", uart_dev->name);
+        return -EBUSY;
+    }
+    if (!device_is_ready(uart_dev)) {
+        return -ENODEV;
+    }
+    if (!cb_ready) {
+        ret = uart_callback_set(uart_dev, uart_cb, NULL);
+        if (ret < 0) {
+            LOG_ERR("UART 不支持异步 API: %d", ret);
+            return -ENODEV;
+        }
+        cb_ready = true;
+    }
+
+    telemetry_stop();
+
+    k_spinlock_key_t key = k_spin_lock(&lock);
+
+    ch_mask = mask;
+    decimation = decim;
+    decim_cnt = 0;
+    seq = 0;
+    stat_dropped = 0;
+    stat_bytes = 0;
+    stat_tx_errors = 0;
+    fill_len = 0;
+    running = true;
+    k_spin_unlock(&lock, key);
+
+    LOG_INF("遥测开始: mask=0x%x, 抽取 1/%u", mask, decim);
+    return 0;
+}
+
+void telemetry_stop(void)
+{
+    if (!running) {
+        return;
+    }
+    running = false;
+    uart_tx_abort(uart_dev);
+}
+
+void telemetry_get_stats(struct telemetry_stats *stats)
+{
+    struct uart_config cfg;
+
+    stats->running = running;
+    stats->mask = ch_mask;
+    stats->decimation = decimation;
+    stats->frames = seq;
+    stats->dropped = stat_dropped;
+    stats->bytes = stat_bytes;
+    stats->tx_errors = stat_tx_errors;
+    stats->baudrate = (uart_config_get(uart_dev, &cfg) == 0) ? cfg.baudrate : 0;
+}
@@ -0,0 +1,60 @@
+/*
+ * application/src/telemetry_shell.c
+ * 遥测 Shell 命令：telem start / stop / status
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+#include <stdlib.h>
+
+#include "telemetry.h"
+
+static int cmd_telem_start(const struct shell *sh, size_t argc, char **argv)
+{
+    uint32_t mask = (argc > 1) ? strtoul(argv[1], NULL, 0) : TELEM_CH_ALL;
+    uint32_t decim = (argc > 2) ? strtoul(argv[2], NULL, 10) : 1;
+    int ret;
+
+    ret = telemetry_start((uint8_t)mask, (uint16_t)decim);
+    if (ret == -EINVAL) {
+        shell_error(sh, "参数错误: mask 取 0x1(IMU)|0x2(温湿度)|0x4(光照)，抽取 >= 1");
+    } else if (ret == -EBUSY) {
+        shell_error(sh, "遥测串口与控制台/Shell 是同一个串口，请在设备树中另选 app,telemetry-uart");
+    } else if (ret < 0) {
+        shell_error(sh, "遥测启动失败: %d", ret);
+    } else {
+        shell_print(sh, "遥测已开始，在遥测串口上用 tools/telemetry_rx.py 接收");
+    }
+    return ret;
+}
+
+static int cmd_telem_stop(const struct shell *sh, size_t argc, char **argv)
+{
+    telemetry_stop();
+    return 0;
+}
+
+static int cmd_telem_status(const struct shell *sh, size_t argc, char **argv)
+{
+    struct telemetry_stats st;
+
+    telemetry_get_stats(&st);
+    shell_print(sh, "状态: %s, mask=0x%x, 抽取 1/%u", st.running ? "运行" : "停止",
+                st.mask, st.decimation);
+    shell_print(sh, "帧: %u, 丢弃: %u, 发送字节: %u, 发送错误: %u",
+                st.frames, st.dropped, st.bytes, st.tx_errors);
+    if (st.baudrate > 0) {
+        /* 8N1: 每字节 10 bit */
+        shell_print(sh, "线路容量: %u B/s", st.baudrate / 10);
+    }
+    return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_telem,
+    SHELL_CMD_ARG(start, NULL, "开始遥测: start [通道掩码] [抽取]", cmd_telem_start, 1, 2),
+    SHELL_CMD(stop, NULL, "停止遥测", cmd_telem_stop),
+    SHELL_CMD(status, NULL, "遥测统计", cmd_telem_status),
+    SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(telem, &sub_telem, "实时遥测命令", NULL);
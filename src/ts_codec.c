@@ -0,0 +1,295 @@
+/*
+ * application/src/ts_codec.c
+ * Gorilla 风格的传感器时间序列压缩
+ *
+ * 时间戳二阶差分前缀码 (zz = zigzag(dod)):
+ *   '0'                 dod == 0
+ *   '10'   + 7 bit      zz < 128
+ *   '110'  + 9 bit      zz < 512
+ *   '1110' + 12 bit     zz < 4096
+ *   '1111' + 32 bit     其他
+ * 数值一阶差分前缀码 (zz = zigzag(delta)):
+ *   '0'                 delta == 0
+ *   '10'   + 6 bit      zz < 64
+ *   '110'  + 12 bit     zz < 4096
+ *   '111'  + 32 bit     其他
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/crc.h>
+#include <string.h>
+#include <math.h>
+#include <errno.h>
+
+#include "ts_codec.h"
+
+#define VAL_CHANNELS  3
+
+static inline uint32_t zigzag(int32_t v)
+{
+    return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+static inline int32_t unzigzag(uint32_t v)
+{
+    return (int32_t)(v >> 1) ^ -(int32_t)(v & 1);
+}
+
+/* 量化：温湿度保留两位小数，光照本身就是整数 */
+static void quantise(const struct log_record *rec, int32_t q[VAL_CHANNELS])
+{
+    q[0] = (int32_t)roundf(rec->temperature * 100.0f);
+    q[1] = (int32_t)roundf(rec->humidity * 100.0f);
+    q[2] = rec->lux;
+}
+
+/* ---------------- 比特读写 (MSB first) ---------------- */
+
+static void bits_put(uint8_t *buf, uint32_t *pos, uint32_t val, uint8_t nbits)
+{
+    while (nbits > 0) {
+        uint8_t room = 8 - (*pos & 7);
+        uint8_t take = MIN(room, nbits);
+        uint8_t bits = (val >> (nbits - take)) & BIT_MASK(take);
+
+        buf[*pos >> 3] |= bits << (room - take);
+        *pos += take;
+        nbits -= take;
+    }
+}
+
+static uint32_t bits_get(const uint8_t *buf, uint32_t *pos, uint8_t nbits)
+{
+    uint32_t val = 0;
+
+    while (nbits > 0) {
+        uint8_t room = 8 - (*pos & 7);
+        uint8_t take = MIN(room, nbits);
+        uint8_t bits = (buf[*pos >> 3] >> (room - take)) & BIT_MASK(take);
+
+        val = (val << take) | bits;
+        *pos += take;
+        nbits -= take;
+    }
+    return val;
+}
+
+/* ---------------- 前缀码 ---------------- */
+
+/* 时间戳二阶差分的编码长度 (比特) */
+static uint8_t ts_code_bits(uint32_t zz)
+{
+    if (zz == 0) {
+        return 1;
+    } else if (zz < 128) {
+        return 2 + 7;
+    } else if (zz < 512) {
+        return 3 + 9;
+    } else if (zz < 4096) {
+        return 4 + 12;
+    }
+    return 4 + 32;
+}
+
+static void ts_code_put(uint8_t *buf, uint32_t *pos, uint32_t zz)
+{
+    if (zz == 0) {
+        bits_put(buf, pos, 0x0, 1);
+    } else if (zz < 128) {
+        bits_put(buf, pos, 0x2, 2);
+        bits_put(buf, pos, zz, 7);
+    } else if (zz < 512) {
+        bits_put(buf, pos, 0x6, 3);
+        bits_put(buf, pos, zz, 9);
+    } else if (zz < 4096) {
+        bits_put(buf, pos, 0xE, 4);
+        bits_put(buf, pos, zz, 12);
+    } else {
+        bits_put(buf, pos, 0xF, 4);
+        bits_put(buf, pos, zz, 32);
+    }
+}
+
+static uint32_t ts_code_get(const uint8_t *buf, uint32_t *pos)
+{
+    if (bits_get(buf, pos, 1) == 0) {
+        return 0;
+    }
+    if (bits_get(buf, pos, 1) == 0) {
+        return bits_get(buf, pos, 7);
+    }
+    if (bits_get(buf, pos, 1) == 0) {
+        return bits_get(buf, pos, 9);
+    }
+    if (bits_get(buf, pos, 1) == 0) {
+        return bits_get(buf, pos, 12);
+    }
+    return bits_get(buf, pos, 32);
+}
+
+static uint8_t val_code_bits(uint32_t zz)
+{
+    if (zz == 0) {
+        return 1;
+    } else if (zz < 64) {
+        return 2 + 6;
+    } else if (zz < 4096) {
+        return 3 + 12;
+    }
+    return 3 + 32;
+}
+
+static void val_code_put(uint8_t *buf, uint32_t *pos, uint32_t zz)
+{
+    if (zz == 0) {
+        bits_put(buf, pos, 0x0, 1);
+    } else if (zz < 64) {
+        bits_put(buf, pos, 0x2, 2);
+        bits_put(buf, pos, zz, 6);
+    } else if (zz < 4096) {
+        bits_put(buf, pos, 0x6, 3);
+        bits_put(buf, pos, zz, 12);
+    } else {
+        bits_put(buf, pos, 0x7, 3);
+        bits_put(buf, pos, zz, 32);
+    }
+}
+
+static uint32_t val_code_get(const uint8_t *buf, uint32_t *pos)
+{
+    if (bits_get(buf, pos, 1) == 0) {
+        return 0;
+    }
+    if (bits_get(buf, pos, 1) == 0) {
+        return bits_get(buf, pos, 6);
+    }
+    if (bits_get(buf, pos, 1) == 0) {
+        return bits_get(buf, pos, 12);
+    }
+    return bits_get(buf, pos, 32);
+}
+
+/* 帧 CRC：帧头 (crc 字段按 0 计算) + 比特流 */
+static uint16_t frame_crc(const struct ts_frame_hdr *hdr, const uint8_t *payload, size_t len)
+{
+    struct ts_frame_hdr h = *hdr;
+
+    h.crc = 0;
+    return crc16_ccitt(crc16_ccitt(0xFFFF, (const uint8_t *)&h, sizeof(h)), payload, len);
+}
+
+/* ---------------- 编码器 ---------------- */
+
+void ts_encoder_reset(struct ts_encoder *enc)
+{
+    memset(enc, 0, sizeof(*enc));
+}
+
+int ts_encoder_add(struct ts_encoder *enc, const struct log_record *rec)
+{
+    uint8_t *payload = enc->frame + sizeof(struct ts_frame_hdr);
+    int32_t q[VAL_CHANNELS];
+    uint32_t zz_ts, zz_val[VAL_CHANNELS];
+    int32_t delta = 0;
+    uint32_t need;
+
+    quantise(rec, q);
+
+    /* 帧内第一条记录：时间戳在帧头里，数值相对 0 编码，帧因此可以独立解码 */
+    if (enc->count > 0) {
+        delta = (int32_t)(rec->ts - enc->prev_ts);
+    }
+    zz_ts = zigzag(delta - enc->prev_delta);
+    need = (enc->count > 0) ? ts_code_bits(zz_ts) : 0;
+
+    for (int i = 0; i < VAL_CHANNELS; i++) {
+        zz_val[i] = zigzag(q[i] - enc->prev_val[i]);
+        need += val_code_bits(zz_val[i]);
+    }
+
+    /* 先算长度再写，保证帧满时不会留下半条记录 */
+    if (enc->bit_pos + need > TS_FRAME_PAYLOAD * 8) {
+        return -ENOSPC;
+    }
+
+    if (enc->count > 0) {
+        ts_code_put(payload, &enc->bit_pos, zz_ts);
+        enc->prev_delta = delta;
+    } else {
+        enc->first_ts = rec->ts;
+    }
+    for (int i = 0; i < VAL_CHANNELS; i++) {
+        val_code_put(payload, &enc->bit_pos, zz_val[i]);
+        enc->prev_val[i] = q[i];
+    }
+
+    enc->prev_ts = rec->ts;
+    enc->count++;
+    return 0;
+}
+
+size_t ts_encoder_finish(struct ts_encoder *enc)
+{
+    struct ts_frame_hdr hdr;
+    uint32_t payload_len = DIV_ROUND_UP(enc->bit_pos, 8);
+
+    if (enc->count == 0) {
+        return 0;
+    }
+
+    hdr.magic = TS_FRAME_MAGIC;
+    hdr.count = enc->count;
+    hdr.len = sizeof(hdr) + payload_len;
+    hdr.first_ts = enc->first_ts;
+    hdr.last_ts = enc->prev_ts;
+    hdr.crc = frame_crc(&hdr, enc->frame + sizeof(hdr), payload_len);
+    memcpy(enc->frame, &hdr, sizeof(hdr));
+
+    return hdr.len;
+}
+
+/* ---------------- 解码器 ---------------- */
+
+int ts_decode_frame(const uint8_t *frame, size_t len, log_query_cb_t cb, void *user_data)
+{
+    const uint8_t *payload = frame + sizeof(struct ts_frame_hdr);
+    struct ts_frame_hdr hdr;
+    struct log_record rec;
+    int32_t val[VAL_CHANNELS] = {0};
+    int32_t delta = 0;
+    uint32_t pos = 0;
+    uint32_t bit_len;
+
+    if (len < sizeof(hdr)) {
+        return -EBADMSG;
+    }
+    memcpy(&hdr, frame, sizeof(hdr));
+    if (hdr.magic != TS_FRAME_MAGIC || hdr.len > len || hdr.len < sizeof(hdr) ||
+        hdr.crc != frame_crc(&hdr, payload, hdr.len - sizeof(hdr))) {
+        return -EBADMSG;
+    }
+    bit_len = (hdr.len - sizeof(hdr)) * 8;
+
+    rec.ts = hdr.first_ts;
+    for (uint16_t n = 0; n < hdr.count; n++) {
+        if (n > 0) {
+            delta += unzigzag(ts_code_get(payload, &pos));
+            rec.ts += delta;
+        }
+        for (int i = 0; i < VAL_CHANNELS; i++) {
+            val[i] += unzigzag(val_code_get(payload, &pos));
+        }
+        if (pos > bit_len) {
+            return -EBADMSG;
+        }
+
+        rec.temperature = val[0] / 100.0f;
+        rec.humidity = val[1] / 100.0f;
+        rec.lux = (uint16_t)val[2];
+        if (cb(&rec, user_data) != 0) {
+            return -ECANCELED;
+        }
+    }
+
+    return hdr.count;
+}
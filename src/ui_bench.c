@@ -0,0 +1,252 @@
+/*
+ * application/src/ui_bench.c
+ * 仪表盘离屏渲染基准测试：真实界面代码 + 只记账的 flush 回调 + 脚本化的数据和按键
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <lvgl.h>
+#include <lvgl_mem.h>
+
+#include "ui_bench.h"
+#include "asset_store.h"
+#include "dashboard.h"
+#include "display_thread.h"
+#include "lcd_flush.h"
+#include "roll_plot.h"
+
+LOG_MODULE_REGISTER(UI_BENCH, LOG_LEVEL_INF);
+
+/* ---------------- 配置参数 ---------------- */
+#define UI_BENCH_TIMEOUT_MS  120000
+
+static K_SEM_DEFINE(bench_req, 0, 1);
+static K_SEM_DEFINE(bench_done, 0, 1);
+static K_MUTEX_DEFINE(bench_lock);
+static struct ui_bench_result bench;
+static int bench_ret;
+
+/* 当前一帧 / 一步的计数，只在显示线程中访问 */
+static uint32_t frame_bytes;
+static uint32_t frame_flushes;
+static uint32_t frame_px;
+static uint32_t step_inv_px;
+static uint32_t step_inv_areas;
+
+static void frame_reset(void)
+{
+    frame_bytes = 0;
+    frame_flushes = 0;
+    frame_px = 0;
+    step_inv_px = 0;
+    step_inv_areas = 0;
+}
+
+/* 离屏显示的 flush：只记录区域和字节数 */
+static void bench_flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
+{
+    uint32_t px = lv_area_get_size(area);
+
+    ARG_UNUSED(px_map);
+    frame_px += px;
+    frame_bytes += px * lv_color_format_get_size(lv_display_get_color_format(disp));
+    frame_flushes++;
+    lv_display_flush_ready(disp);
+}
+
+/* 每次失效请求 (LVGL 合并相交区域之前) */
+static void bench_invalidate_cb(lv_event_t *e)
+{
+    const lv_area_t *area = lv_event_get_param(e);
+
+    step_inv_px += lv_area_get_size(area);
+    step_inv_areas++;
+}
+
+/* 第 i 步注入的数据：IMU 每步一个采样，光照/温湿度按各自传感器线程的周期，按键定期切换焦点 */
+static void script_step(uint32_t i)
+{
+    int32_t tri = (int32_t)(i % 40) - 20;
+    icm20608_data_t imu = {
+        .accel_x = tri / 40.0f,
+        .accel_y = -tri / 80.0f,
+        .accel_z = 0.95f,
+        .temp = 30.0f + (i % 10) / 10.0f,
+    };
+
+    ui_apply_imu(&imu);
+    if (i % UI_BENCH_LUX_STEPS == 0) {
+        ui_apply_lux(100 + (i / UI_BENCH_LUX_STEPS * 37) % 300);
+    }
+    if (i % UI_BENCH_ENV_STEPS == 0) {
+        aht10_data_t env = {
+            .temperature = 20.0f + (i / UI_BENCH_ENV_STEPS) % 10,
+            .humidity = 40.0f + (i / UI_BENCH_ENV_STEPS * 7) % 30,
+        };
+
+        ui_apply_env(&env);
+    }
+    if (i % UI_BENCH_KEY_STEPS == UI_BENCH_KEY_STEPS / 2) {
+        lv_group_send_data(lv_group_get_default(), LV_KEY_NEXT);
+    }
+}
+
+static uint32_t cyc_to_us(uint32_t cycles)
+{
+    return (uint32_t)k_cyc_to_us_floor64(cycles);
+}
+
+static int bench_run(lv_display_t *live, struct ui_bench_result *r)
+{
+    struct sys_memory_stats heap;
+    lv_display_t *disp;
+    lv_draw_buf_t *vdb;
+    uint32_t t0;
+    bool xip;
+
+    /* 借用实际屏幕的绘图缓冲，先等最后一块像素发送完 */
+    lcd_flush_wait();
+    vdb = lv_display_get_buf_active(live);
+    if (vdb == NULL) {
+        return -ENODEV;
+    }
+
+    /* 先删除实际屏幕上的仪表盘，LVGL 堆里只剩离屏的那一份 */
+    ui_clear_dashboard();
+    lvgl_heap_stats(&heap);
+    r->heap_base = heap.allocated_bytes;
+
+    disp = lv_display_create(lv_display_get_horizontal_resolution(live),
+                             lv_display_get_vertical_resolution(live));
+    if (disp == NULL) {
+        return -ENOMEM;
+    }
+    lv_display_set_color_format(disp, LV_COLOR_FORMAT_RGB565);
+    lv_display_set_buffers(disp, vdb->data, NULL, vdb->data_size, LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_flush_cb(disp, bench_flush_cb);
+    lv_display_add_event_cb(disp, bench_invalidate_cb, LV_EVENT_INVALIDATE_AREA, NULL);
+    /* 离屏显示只由本函数用 lv_refr_now() 渲染 */
+    lv_timer_pause(lv_display_get_refr_timer(disp));
+    lv_display_set_default(disp);
+
+    /* 建界面和渲染会读取映射窗口中的资源；测试耗时较长，逐段加锁，段间让出给 Flash 写入/擦除 */
+    xip = asset_xip_lock_if_mapped();
+    t0 = k_cycle_get_32();
+    setup_pandora_dashboard();
+    r->build_us = cyc_to_us(k_cycle_get_32() - t0);
+    lvgl_heap_stats(&heap);
+    r->heap_built = heap.allocated_bytes;
+
+    /* 首帧不计 (含字形缓存预热)，之后测整屏重绘 */
+    lv_refr_now(disp);
+    if (xip) {
+        asset_xip_unlock();
+    }
+    frame_reset();
+    t0 = k_cycle_get_32();
+    for (int i = 0; i < UI_BENCH_FULL_FRAMES; i++) {
+        xip = asset_xip_lock_if_mapped();
+        lv_obj_invalidate(lv_screen_active());
+        lv_refr_now(disp);
+        if (xip) {
+            asset_xip_unlock();
+        }
+    }
+    r->full_us = cyc_to_us(k_cycle_get_32() - t0) / UI_BENCH_FULL_FRAMES;
+    r->full_bytes = frame_bytes / UI_BENCH_FULL_FRAMES;
+    r->full_flushes = frame_flushes / UI_BENCH_FULL_FRAMES;
+
+    for (uint32_t i = 0; i < r->steps; i++) {
+        uint32_t us;
+
+        frame_reset();
+        xip = asset_xip_lock_if_mapped();
+        script_step(i);
+        t0 = k_cycle_get_32();
+        lv_refr_now(disp);
+        us = cyc_to_us(k_cycle_get_32() - t0);
+        if (xip) {
+            asset_xip_unlock();
+        }
+
+        r->inv_px += step_inv_px;
+        r->inv_areas += step_inv_areas;
+        if (frame_flushes) {
+            r->frames++;
+            r->render_us_sum += us;
+            r->render_us_max = MAX(r->render_us_max, us);
+        }
+        r->flush_bytes += frame_bytes;
+        r->flushes += frame_flushes;
+        r->flush_px += frame_px;
+    }
+
+    lvgl_heap_stats(&heap);
+    r->heap_peak = heap.max_allocated_bytes;
+
+    /* 删除离屏显示 (连同上面的仪表盘)，回到实际屏幕 */
+    lv_display_delete(disp);
+    lv_display_set_default(live);
+    return 0;
+}
+
+int ui_bench_measure(uint32_t steps, struct ui_bench_result *out)
+{
+    *out = (struct ui_bench_result){ .steps = steps };
+    return bench_run(lv_display_get_default(), out);
+}
+
+int ui_bench_run(uint32_t steps, struct ui_bench_result *out)
+{
+    int ret;
+
+    if (roll_plot_is_active()) {
+        return -EBUSY;
+    }
+    if (k_mutex_lock(&bench_lock, K_NO_WAIT) < 0) {
+        return -EBUSY;
+    }
+
+    k_sem_reset(&bench_done);
+    bench = (struct ui_bench_result){ .steps = steps };
+    k_sem_give(&bench_req);
+    display_wake(DISPLAY_EVT_CMD);
+
+    ret = k_sem_take(&bench_done, K_MSEC(UI_BENCH_TIMEOUT_MS));
+    if (ret == 0) {
+        ret = bench_ret;
+        *out = bench;
+    } else {
+        // 显示线程超时后仍会完成这次测试，结果丢弃
+        ret = -ETIMEDOUT;
+    }
+    k_mutex_unlock(&bench_lock);
+    return ret;
+}
+
+void ui_bench_poll(void)
+{
+    lv_display_t *live = lv_display_get_default();
+
+    if (k_sem_take(&bench_req, K_NO_WAIT) < 0) {
+        return;
+    }
+
+    bench_ret = bench_run(live, &bench);
+    if (bench_ret < 0) {
+        LOG_ERR("离屏测试失败: %d", bench_ret);
+    }
+
+    /* 在实际屏幕上重建仪表盘 */
+    bool xip = asset_xip_lock_if_mapped();
+
+    ui_clear_dashboard();
+    setup_pandora_dashboard();
+    ui_restore_values();
+    lv_obj_invalidate(lv_screen_active());
+    if (xip) {
+        asset_xip_unlock();
+    }
+
+    k_sem_give(&bench_done);
+}
@@ -0,0 +1,63 @@
+/*
+ * application/src/ui_shell.c
+ * 界面 Shell 命令：ui bench [步数]
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+#include <stdlib.h>
+
+#include "ui_bench.h"
+
+void ui_bench_print(const struct shell *sh, const struct ui_bench_result *r)
+{
+    uint32_t sim_ms = r->steps * UI_BENCH_STEP_MS;
+
+    shell_print(sh, "仪表盘构建 %u us, LVGL 堆 %u -> %u 字节 (+%u), 开机以来峰值 %u 字节",
+                r->build_us, r->heap_base, r->heap_built, r->heap_built - r->heap_base,
+                r->heap_peak);
+    shell_print(sh, "整屏重绘 %u us, %u 字节, %u 次 flush", r->full_us, r->full_bytes,
+                r->full_flushes);
+    shell_print(sh, "脚本 %u 步 (模拟 %u.%u s), %u 帧有输出", r->steps, sim_ms / 1000,
+                sim_ms / 100 % 10, r->frames);
+    if (r->frames) {
+        shell_print(sh, "  每帧渲染 平均 %u us, 最大 %u us", r->render_us_sum / r->frames,
+                    r->render_us_max);
+        shell_print(sh, "  每帧 flush %u 字节 (%u 次, %u 像素)", r->flush_bytes / r->frames,
+                    r->flushes / r->frames, r->flush_px / r->frames);
+    }
+    shell_print(sh, "  每步失效 %u 像素 (%u 个区域, 合并前), 输出 %u 字节/秒 (按模拟时间)",
+                r->inv_px / r->steps, r->inv_areas / r->steps,
+                (uint32_t)((uint64_t)r->flush_bytes * 1000 / sim_ms));
+}
+
+static int cmd_ui_bench(const struct shell *sh, size_t argc, char **argv)
+{
+    int steps = (argc > 1) ? atoi(argv[1]) : UI_BENCH_DEFAULT_STEPS;
+    struct ui_bench_result r;
+    int ret;
+
+    if (steps < 1 || steps > UI_BENCH_MAX_STEPS) {
+        shell_error(sh, "步数范围 1..%d", UI_BENCH_MAX_STEPS);
+        return -EINVAL;
+    }
+
+    ret = ui_bench_run(steps, &r);
+    if (ret == -EBUSY) {
+        shell_error(sh, "已有测试在进行，或滚动图模式占用屏幕 (lcd roll off)");
+        return ret;
+    } else if (ret < 0) {
+        shell_error(sh, "测试失败: %d", ret);
+        return ret;
+    }
+
+    ui_bench_print(sh, &r);
+    return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_ui,
+    SHELL_CMD_ARG(bench, NULL, "仪表盘离屏渲染基准测试: bench [步数]", cmd_ui_bench, 1, 1),
+    SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(ui, &sub_ui, "仪表盘界面", NULL);
@@ -0,0 +1,94 @@
+/*
+ * application/src/warm_start.c
+ * 热启动快照的 Flash 副本
+ *
+ * 数据中心在 __noinit RAM 中维护最近的温湿度/光照快照，软件复位后开机即可恢复；
+ * 断电后 RAM 内容丢失，这里把快照定期保存到 /lfs，开机挂载后用它恢复
+ * (只填充 RAM 快照和实时数据都还没有覆盖的通道)。
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/fs/fs.h>
+#include <zephyr/logging/log.h>
+#include <string.h>
+
+#include "data_center.h"
+#include "boot_prof.h"
+
+LOG_MODULE_REGISTER(WARM_START, LOG_LEVEL_INF);
+
+/* ---------------- 配置参数 ---------------- */
+#define WARM_START_FILE           "/lfs/warm_start.bin"
+#define WARM_START_SAVE_INTERVAL  (10 * 60 * 1000)   // 保存周期 (ms)，值不变时不写
+#define WARM_START_STACK_SIZE     1536
+#define WARM_START_PRIORITY       14
+
+static int snapshot_load(struct dc_snapshot *snap)
+{
+    struct fs_file_t file;
+    ssize_t n;
+    int ret;
+
+    fs_file_t_init(&file);
+    ret = fs_open(&file, WARM_START_FILE, FS_O_READ);
+    if (ret < 0) {
+        return ret;
+    }
+    n = fs_read(&file, snap, sizeof(*snap));
+    fs_close(&file);
+    return (n == sizeof(*snap)) ? 0 : -EIO;
+}
+
+static int snapshot_save(const struct dc_snapshot *snap)
+{
+    struct fs_file_t file;
+    ssize_t n;
+    int ret;
+
+    fs_file_t_init(&file);
+    ret = fs_open(&file, WARM_START_FILE, FS_O_CREATE | FS_O_WRITE | FS_O_TRUNC);
+    if (ret < 0) {
+        return ret;
+    }
+    n = fs_write(&file, snap, sizeof(*snap));
+    ret = fs_close(&file);
+    if (n != sizeof(*snap)) {
+        return (n < 0) ? (int)n : -ENOSPC;
+    }
+    return ret;
+}
+
+void warm_start_thread_entry(void *p1, void *p2, void *p3)
+{
+    struct dc_snapshot saved = {0}, snap;
+    int ret;
+
+    boot_ready_wait(BOOT_READY_FS, K_FOREVER);
+
+    if (snapshot_load(&saved) == 0) {
+        ret = data_center_restore_snapshot(&saved);
+        if (ret > 0) {
+            LOG_INF("已从 Flash 恢复上次的数据 (通道 0x%x)", ret);
+        } else if (ret < 0) {
+            LOG_WRN("热启动快照文件无效");
+        }
+    }
+
+    while (1) {
+        k_msleep(WARM_START_SAVE_INTERVAL);
+
+        if (data_center_export_snapshot(&snap) < 0 || memcmp(&snap, &saved, sizeof(snap)) == 0) {
+            continue;
+        }
+        ret = snapshot_save(&snap);
+        if (ret == 0) {
+            saved = snap;
+        } else {
+            LOG_ERR("保存热启动快照失败: %d", ret);
+        }
+    }
+}
+
+K_THREAD_DEFINE(warm_start_tid, WARM_START_STACK_SIZE,
+                warm_start_thread_entry, NULL, NULL, NULL,
+                WARM_START_PRIORITY, 0, 0);
@@ -0,0 +1,200 @@
+/*
+ * tests/asset_store/src/main.c
+ * 资源包测试 (native_sim + Flash 模拟器)
+ *
+ * 用与 tools/asset_pack.py 相同的格式在测试中拼出一个只含两个字形的字体资源包，
+ * 写进 font_partition，再按开机流程检查、建立 LVGL 字体并查询字形。
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/storage/flash_map.h>
+
+/* 直接包含被测源文件，测试可以重置并检查其中的静态状态 */
+#include "../../../src/asset_store.c"
+
+#define FONT_NAME     "dash_value"
+#define GLYPH_W       6
+#define GLYPH_H       8
+#define GLYPH_BYTES   (GLYPH_W * GLYPH_H / 8)   // 1 bpp
+
+static const struct flash_area *font_fa;
+
+/* 测试镜像不链接 glyph_cache.c (其缓存区在 SRAM1 段中)，字体保持原始的位图回调 */
+int glyph_cache_attach(lv_font_t *font)
+{
+    ARG_UNUSED(font);
+    return 0;
+}
+
+/* 字体资源：头部 + 字形描述表 ([0] 保留) + 1 段字符映射 + 位图，偏移相对字体资源起始 */
+static size_t build_font(uint8_t *buf)
+{
+    struct asset_font_hdr hdr = {
+        .line_height = GLYPH_H + 2,
+        .base_line = 1,
+        .bpp = 1,
+        .cmap_num = 1,
+        .glyph_count = 3,
+        .flags = LV_FONT_FMT_TXT_LARGE ? ASSET_FONT_FLAG_LARGE : 0,
+    };
+    lv_font_fmt_txt_glyph_dsc_t glyphs[3] = {0};
+    struct asset_font_cmap cmap = {
+        .range_start = '0',
+        .range_length = 2,
+        .glyph_id_start = 1,
+        .type = LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY,
+    };
+    size_t off = ROUND_UP(sizeof(hdr), 4);
+
+    for (int i = 1; i < 3; i++) {
+        glyphs[i].bitmap_index = (i - 1) * GLYPH_BYTES;
+        glyphs[i].adv_w = (GLYPH_W + 1 + i) * 16;   // 1/16 像素单位，两个字形不同
+        glyphs[i].box_w = GLYPH_W;
+        glyphs[i].box_h = GLYPH_H;
+    }
+
+    hdr.glyph_dsc_off = off;
+    memcpy(buf + off, glyphs, sizeof(glyphs));
+    off = ROUND_UP(off + sizeof(glyphs), 4);
+
+    hdr.cmaps_off = off;
+    memcpy(buf + off, &cmap, sizeof(cmap));
+    off = ROUND_UP(off + sizeof(cmap), 4);
+
+    hdr.bitmap_off = off;
+    memset(buf + off, 0xA5, 2 * GLYPH_BYTES);
+    off = ROUND_UP(off + 2 * GLYPH_BYTES, 4);
+
+    memcpy(buf, &hdr, sizeof(hdr));
+    return off;
+}
+
+/* 拼出资源包写进分区；crc_xor 非 0 时写入错误的 CRC */
+static void write_pack(uint32_t crc_xor)
+{
+    static uint8_t pack_buf[512];
+    struct asset_pack_hdr hdr = {
+        .magic = ASSET_PACK_MAGIC,
+        .version = ASSET_PACK_VERSION,
+        .count = 1,
+    };
+    struct asset_entry e = {
+        .name = FONT_NAME,
+        .type = ASSET_TYPE_FONT,
+        .offset = ROUND_UP(sizeof(hdr) + sizeof(e), 4),
+    };
+
+    memset(pack_buf, 0, sizeof(pack_buf));
+    e.size = build_font(pack_buf + e.offset);
+    hdr.total_size = e.offset + e.size;
+    memcpy(pack_buf + sizeof(hdr), &e, sizeof(e));
+    hdr.crc = crc32_ieee(pack_buf + sizeof(hdr), hdr.total_size - sizeof(hdr)) ^ crc_xor;
+    memcpy(pack_buf, &hdr, sizeof(hdr));
+
+    zassert_ok(flash_area_write(font_fa, 0, pack_buf, hdr.total_size));
+}
+
+/* 模拟重新开机：丢弃已建立的字体描述，按开机流程检查分区 */
+static int reinit(void)
+{
+    pack = NULL;
+    pack_hdr = NULL;
+    entries = NULL;
+    font_count = 0;
+    image_count = 0;
+    return asset_store_init();
+}
+
+static void *suite_setup(void)
+{
+    zassert_ok(flash_area_open(FIXED_PARTITION_ID(font_partition), &font_fa));
+    return NULL;
+}
+
+static void before(void *fixture)
+{
+    ARG_UNUSED(fixture);
+    zassert_ok(flash_area_erase(font_fa, 0, 4096));
+    reinit();
+}
+
+ZTEST(asset_store, test_no_pack)
+{
+    zassert_equal(reinit(), -ENOENT);
+    zassert_false(asset_store_ready());
+    zassert_false(asset_xip_lock_if_mapped(), "没有资源包时不应加锁");
+    zassert_is_null(asset_font_get(FONT_NAME), "没有资源包时应回退到默认字体");
+}
+
+ZTEST(asset_store, test_pack_mapped)
+{
+    write_pack(0);
+    zassert_ok(reinit());
+    zassert_true(asset_store_ready());
+    zassert_ok(asset_store_verify());
+
+    /* 资源直接在映射窗口 (模拟器内存) 中访问，不复制到 RAM */
+    const struct asset_entry *e = asset_store_entry(0);
+
+    zassert_not_null(e);
+    zassert_equal_ptr(e, asset_xip_ptr(FIXED_PARTITION_OFFSET(font_partition)) +
+                         sizeof(struct asset_pack_hdr));
+    zassert_is_null(asset_store_entry(1));
+
+    zassert_true(asset_xip_lock_if_mapped());
+    asset_xip_unlock();
+}
+
+ZTEST(asset_store, test_font_glyphs)
+{
+    lv_font_glyph_dsc_t g;
+    const lv_font_t *font;
+    const uint8_t *bitmap_base;
+
+    write_pack(0);
+    zassert_ok(reinit());
+
+    font = asset_font_get(FONT_NAME);
+    zassert_not_null(font);
+    zassert_equal_ptr(asset_font_get(FONT_NAME), font, "第二次应返回同一个字体对象");
+    zassert_is_null(asset_font_get("missing"));
+    zassert_equal(font->line_height, GLYPH_H + 2);
+
+    /* 字形位图指向映射窗口中的资源数据 */
+    bitmap_base = ((const lv_font_fmt_txt_dsc_t *)font->dsc)->glyph_bitmap;
+    zassert_true(bitmap_base > pack && bitmap_base < pack + pack_hdr->total_size);
+
+    zassert_true(lv_font_get_glyph_dsc(font, &g, '0', 0));
+    zassert_equal(g.box_w, GLYPH_W);
+    zassert_equal(g.box_h, GLYPH_H);
+    zassert_equal(g.adv_w, GLYPH_W + 2);
+
+    zassert_true(lv_font_get_glyph_dsc(font, &g, '1', 0));
+    zassert_equal(g.adv_w, GLYPH_W + 3);
+
+    /* 范围外的字符：字体中没有 */
+    zassert_false(lv_font_get_glyph_dsc(font, &g, '2', 0));
+}
+
+ZTEST(asset_store, test_crc_mismatch)
+{
+    /* 开机只检查头部，全量 CRC 由 asset verify 按需校验 */
+    write_pack(0x1);
+    zassert_ok(reinit(), "头部仍然有效");
+    zassert_equal(asset_store_verify(), -EBADMSG);
+}
+
+ZTEST(asset_store, test_bad_header)
+{
+    struct asset_pack_hdr hdr = {
+        .magic = ASSET_PACK_MAGIC,
+        .version = ASSET_PACK_VERSION + 1,
+        .total_size = sizeof(hdr),
+    };
+
+    zassert_ok(flash_area_write(font_fa, 0, &hdr, sizeof(hdr)));
+    zassert_equal(reinit(), -EINVAL);
+    zassert_false(asset_store_ready());
+}
+
+ZTEST_SUITE(asset_store, NULL, suite_setup, before, NULL, NULL);
@@ -0,0 +1,59 @@
+/*
+ * tests/flash_bench/src/main.c
+ * 执行一次 norflash bench，把 Shell 输出打印到控制台
+ *
+ * 测试镜像里没有资源包 (不链接 asset_store.c 和 LVGL)，这里提供 bench 用到的
+ * 映射窗口接口：锁照常互斥，映射窗口就是 Flash 模拟器的内存。
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/drivers/flash/flash_simulator.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/shell/shell_dummy.h>
+
+#include "asset_store.h"
+
+#define BENCH_CMD  "norflash bench 3"
+
+static K_MUTEX_DEFINE(xip_lock);
+
+void asset_xip_lock(void)
+{
+    k_mutex_lock(&xip_lock, K_FOREVER);
+}
+
+void asset_xip_unlock(void)
+{
+    k_mutex_unlock(&xip_lock);
+}
+
+void asset_xip_remap(void)
+{
+}
+
+const uint8_t *asset_xip_ptr(off_t off)
+{
+    size_t size;
+    uint8_t *mem = flash_simulator_get_memory(FIXED_PARTITION_DEVICE(bench_partition), &size);
+
+    return (mem != NULL && off >= 0 && off < size) ? mem + off : NULL;
+}
+
+int main(void)
+{
+    const struct shell *sh = shell_backend_dummy_get_ptr();
+    const char *out;
+    size_t len;
+    int ret;
+
+    /* 让哑后端的 Shell 线程先完成初始化 */
+    k_msleep(10);
+
+    shell_backend_dummy_clear_output(sh);
+    ret = shell_execute_cmd(sh, BENCH_CMD);
+    out = shell_backend_dummy_get_output(sh, &len);
+    printk("%.*s\n", (int)len, out);
+    printk("norflash bench 完成: %d\n", ret);
+    return 0;
+}
@@ -0,0 +1,379 @@
+/*
+ * tests/flash_ring/src/main.c
+ * 裸 Flash 环形日志测试 (native_sim + Flash 模拟器)
+ *
+ * 掉电用“直接改写 Flash 内容 + 重新挂载”模拟，重新挂载走与开机相同的恢复流程。
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/util.h>
+
+/* 直接包含被测源文件，测试可以重置并检查其中的静态状态 */
+#include "../../../src/flash_ring.c"
+
+#define TEST_SECTORS  (FIXED_PARTITION_SIZE(storage_partition) / FLASH_RING_SECTOR_SIZE)
+#define REC_MIN_LEN   100
+#define REC_MAX_LEN   199      // 长度不对齐，覆盖末尾补齐的写入路径
+
+struct rec_loc {
+    uint32_t sector;
+    uint32_t offset;
+};
+
+static uint8_t rec_buf[FLASH_RING_MAX_RECORD];
+static uint8_t read_buf[FLASH_RING_MAX_RECORD];
+static uint32_t ids[4096];
+
+/* 恢复期间读到的扇区 */
+static bool count_reads;
+static bool touched[TEST_SECTORS];
+
+int __real_flash_area_read(const struct flash_area *area, off_t off, void *dst, size_t len);
+
+int __wrap_flash_area_read(const struct flash_area *area, off_t off, void *dst, size_t len)
+{
+    if (count_reads && area == fa && off >= 0 && off < fa->fa_size) {
+        touched[off / FLASH_RING_SECTOR_SIZE] = true;
+    }
+    return __real_flash_area_read(area, off, dst, len);
+}
+
+/* 模拟掉电重启：丢弃内存中的状态，按开机流程恢复；返回恢复时读过的扇区数 */
+static uint32_t remount(void)
+{
+    uint32_t n = 0;
+
+    memset(touched, 0, sizeof(touched));
+    ring_ready = false;
+    count_reads = true;
+    zassert_ok(flash_ring_init(), "恢复失败");
+    count_reads = false;
+
+    for (size_t i = 0; i < ARRAY_SIZE(touched); i++) {
+        n += touched[i];
+    }
+    return n;
+}
+
+static size_t rec_len(uint32_t idx)
+{
+    return REC_MIN_LEN + idx % (REC_MAX_LEN - REC_MIN_LEN + 1);
+}
+
+/* 模拟部分写入：按写入对齐粒度补 0xFF 后写到 addr */
+static void write_padded(off_t addr, const void *data, size_t len)
+{
+    static uint8_t buf[FLASH_RING_SECTOR_SIZE];
+
+    memset(buf, 0xFF, ROUND_UP(len, align));
+    memcpy(buf, data, len);
+    zassert_ok(flash_area_write(fa, addr, buf, ROUND_UP(len, align)));
+}
+
+static void rec_fill(uint32_t idx, uint8_t *buf, size_t len)
+{
+    sys_put_le32(idx, buf);
+    for (size_t i = 4; i < len; i++) {
+        buf[i] = (uint8_t)(idx * 31 + i);
+    }
+}
+
+/* 追加第 idx 条记录，返回它写入的位置 */
+static struct rec_loc put(uint32_t idx)
+{
+    struct flash_ring_info info;
+    size_t len = rec_len(idx);
+
+    rec_fill(idx, rec_buf, len);
+    zassert_ok(flash_ring_append(rec_buf, len), "追加记录 %u 失败", idx);
+    flash_ring_get_info(&info);
+    return (struct rec_loc){info.head_sector, info.write_offset - record_span(len)};
+}
+
+/* 从最旧的记录读到末尾，校验每条内容，返回记录条数，序号依次存入 ids */
+static uint32_t read_ids(void)
+{
+    struct flash_ring_cursor cur;
+    uint32_t n = 0;
+    int len;
+
+    flash_ring_cursor_init(&cur);
+    while ((len = flash_ring_read(&cur, read_buf, sizeof(read_buf))) > 0) {
+        uint32_t idx = sys_get_le32(read_buf);
+
+        zassert_equal(len, rec_len(idx), "记录 %u 长度 %d", idx, len);
+        rec_fill(idx, rec_buf, len);
+        zassert_mem_equal(read_buf, rec_buf, len, "记录 %u 内容不符", idx);
+        zassert_true(n < ARRAY_SIZE(ids));
+        ids[n++] = idx;
+    }
+    zassert_equal(len, -ENOENT, "读取结束于 %d", len);
+    return n;
+}
+
+static void assert_consecutive(uint32_t n, uint32_t first, uint32_t last)
+{
+    zassert_equal(n, last - first + 1, "读到 %u 条，应为 %u..%u", n, first, last);
+    for (uint32_t i = 0; i < n; i++) {
+        zassert_equal(ids[i], first + i, "第 %u 条是 %u", i, ids[i]);
+    }
+}
+
+static void assert_same_position(const struct flash_ring_info *a, const struct flash_ring_info *b)
+{
+    zassert_equal(a->head_sector, b->head_sector);
+    zassert_equal(a->head_seq, b->head_seq);
+    zassert_equal(a->tail_sector, b->tail_sector);
+    zassert_equal(a->write_offset, b->write_offset);
+}
+
+ZTEST(flash_ring, test_append_read)
+{
+    struct flash_ring_info before, after;
+
+    for (uint32_t i = 0; i < 50; i++) {
+        put(i);
+    }
+    assert_consecutive(read_ids(), 0, 49);
+
+    /* 重启后位置不变，可以接着追加 */
+    flash_ring_get_info(&before);
+    remount();
+    flash_ring_get_info(&after);
+    assert_same_position(&before, &after);
+
+    for (uint32_t i = 50; i < 60; i++) {
+        put(i);
+    }
+    assert_consecutive(read_ids(), 0, 59);
+}
+
+ZTEST(flash_ring, test_write_alignment)
+{
+    struct ring_record_hdr hdr;
+    struct rec_loc loc;
+
+    /* 扇区头、记录头、payload 都落在写入对齐粒度上 (write_align_16 场景下为 16) */
+    zassert_equal(align, MAX(flash_area_align(fa), 4u));
+    zassert_equal(first_off % align, 0);
+    zassert_equal(rec_hdr_span % align, 0);
+    for (uint32_t i = 0; i < 20; i++) {
+        loc = put(i);
+        zassert_equal(loc.offset % align, 0, "记录 %u 在偏移 %u", i, loc.offset);
+        zassert_ok(flash_area_read(fa, sector_addr(loc.sector) + loc.offset, &hdr, sizeof(hdr)));
+        zassert_equal(hdr.len, rec_len(i));
+    }
+    assert_consecutive(read_ids(), 0, 19);
+
+    /* 最大长度的记录恰好能放进一个新扇区 */
+    memset(rec_buf, 0x5A, FLASH_RING_MAX_RECORD);
+    sys_put_le32(UINT32_MAX, rec_buf);
+    zassert_ok(flash_ring_append(rec_buf, FLASH_RING_MAX_RECORD));
+    zassert_equal(flash_ring_append(rec_buf, FLASH_RING_MAX_RECORD + 1), -EINVAL);
+}
+
+ZTEST(flash_ring, test_wrap_around)
+{
+    struct flash_ring_info info = {0}, after;
+    uint32_t idx = 0, laps = 0, prev_head = 0, n;
+
+    /* 写满两圈多，最旧的扇区被不断回收 */
+    while (laps < 2 || info.head_sector < sector_count / 2) {
+        put(idx++);
+        flash_ring_get_info(&info);
+        if (info.head_sector < prev_head) {
+            laps++;
+        }
+        prev_head = info.head_sector;
+    }
+
+    /* 头部之后是预擦除扇区，再之后是最旧的数据 */
+    zassert_equal(info.tail_sector, ring_next(ring_next(info.head_sector)));
+    n = read_ids();
+    zassert_true(ids[0] > 0, "最旧的记录没有被回收");
+    assert_consecutive(n, ids[0], idx - 1);
+
+    remount();
+    flash_ring_get_info(&after);
+    assert_same_position(&info, &after);
+    assert_consecutive(read_ids(), ids[0], idx - 1);
+}
+
+ZTEST(flash_ring, test_recover_reads_log_sectors)
+{
+    uint32_t bound = 2 * LOG2CEIL(sector_count) + 4;
+    uint32_t idx = 0, laps = 0;
+    struct flash_ring_info info, after;
+
+    /* 头部停在每个扇区 (含回绕之后) 时重启，恢复都只读 O(log n) 个扇区 */
+    flash_ring_get_info(&info);
+    while (laps < 2) {
+        uint32_t head_before = info.head_sector;
+        uint32_t reads;
+
+        while (put(idx++).sector == head_before) {
+        }
+        flash_ring_get_info(&info);
+        if (info.head_sector < head_before) {
+            laps++;
+        }
+
+        reads = remount();
+        zassert_true(reads <= bound, "头部在扇区 %u 时恢复读了 %u 个扇区 (上限 %u)",
+                     info.head_sector, reads, bound);
+        flash_ring_get_info(&after);
+        assert_same_position(&info, &after);
+    }
+    zassert_true(bound < sector_count);
+}
+
+ZTEST(flash_ring, test_torn_record)
+{
+    struct ring_record_hdr hdr = {.len = 120, .reserved = 0xFFFF};
+    struct flash_ring_info info;
+    off_t addr;
+
+    for (uint32_t i = 0; i < 10; i++) {
+        put(i);
+    }
+    flash_ring_get_info(&info);
+
+    /* 掉电：记录头 (含 CRC) 已写入，payload 只写了一半 */
+    rec_fill(10, rec_buf, hdr.len);
+    hdr.crc = crc32_ieee(rec_buf, hdr.len);
+    addr = sector_addr(info.head_sector) + info.write_offset;
+    write_padded(addr, &hdr, sizeof(hdr));
+    write_padded(addr + rec_hdr_span, rec_buf, ROUND_DOWN(hdr.len / 2, align));
+
+    remount();
+    assert_consecutive(read_ids(), 0, 9);
+
+    /* 残缺记录所在扇区视为写满，新记录写到下一个扇区 */
+    zassert_equal(put(11).sector, ring_next(info.head_sector));
+    zassert_equal(read_ids(), 11);
+    zassert_equal(ids[10], 11);
+}
+
+ZTEST(flash_ring, test_crc_corrupt_record)
+{
+    struct ring_record_hdr hdr = {.len = 150, .reserved = 0xFFFF};
+    struct flash_ring_info info;
+    uint32_t first_sector, idx, n;
+    off_t addr;
+
+    for (idx = 0; idx < 3; idx++) {
+        put(idx);
+    }
+    flash_ring_get_info(&info);
+    first_sector = info.head_sector;
+
+    /* 一条完整写入但 CRC 对不上的记录 (例如数据位翻转) */
+    rec_fill(idx, rec_buf, hdr.len);
+    hdr.crc = crc32_ieee(rec_buf, hdr.len) ^ 1;
+    addr = sector_addr(info.head_sector) + info.write_offset;
+    write_padded(addr, &hdr, sizeof(hdr));
+    write_padded(addr + rec_hdr_span, rec_buf, hdr.len);
+    write_off += record_span(hdr.len);
+    idx++;
+
+    /* 同一扇区再写几条，然后进入下一个扇区 */
+    while (put(idx++).sector == first_sector) {
+    }
+    for (uint32_t i = 0; i < 5; i++) {
+        put(idx++);
+    }
+
+    /* 损坏记录之后的同扇区记录无法定位，读取跳到下一个扇区 */
+    n = read_ids();
+    zassert_true(n > 3 + 5);
+    assert_consecutive(3, 0, 2);
+    for (uint32_t i = 3; i < n; i++) {
+        zassert_equal(ids[i], ids[3] + (i - 3));
+    }
+    zassert_equal(ids[n - 1], idx - 1);
+
+    /* 重启后结果相同 */
+    remount();
+    zassert_equal(read_ids(), n);
+}
+
+ZTEST(flash_ring, test_torn_sector_header)
+{
+    struct ring_sector_hdr hdr = {.magic = RING_MAGIC};
+    struct flash_ring_info info, after;
+    uint32_t pre, idx;
+
+    for (idx = 0; idx < 5; idx++) {
+        put(idx);
+    }
+    flash_ring_get_info(&info);
+    pre = ring_next(info.head_sector);
+
+    /* 掉电：切换扇区时新扇区头只写入了 magic 和 seq，CRC 还没写 */
+    hdr.seq = seq_next(info.head_seq);
+    write_padded(sector_addr(pre), &hdr, offsetof(struct ring_sector_hdr, reserved));
+
+    remount();
+    flash_ring_get_info(&after);
+    assert_same_position(&info, &after);
+    zassert_true(sector_is_blank(pre), "写了一半的扇区头没有被擦除");
+
+    /* 写满当前扇区，切换到该扇区不能失败 */
+    while (put(idx++).sector == info.head_sector) {
+    }
+    flash_ring_get_info(&after);
+    zassert_equal(after.head_sector, pre);
+    zassert_equal(after.head_seq, seq_next(info.head_seq));
+    assert_consecutive(read_ids(), 0, idx - 1);
+}
+
+ZTEST(flash_ring, test_seq_rollover)
+{
+    struct flash_ring_info info;
+    uint32_t seq = UINT32_MAX - (sector_count - 2);
+    uint32_t expect_seq = UINT32_MAX;
+    uint32_t idx = 0;
+
+    /* 环形已写满一圈，头部在最后一个扇区，序号即将回绕 */
+    zassert_ok(flash_area_erase(fa, 0, fa->fa_size));
+    for (uint32_t s = 1; s < sector_count; s++) {
+        zassert_ok(sector_write_hdr(s, seq++));
+    }
+
+    remount();
+    flash_ring_get_info(&info);
+    zassert_equal(info.head_sector, sector_count - 1);
+    zassert_equal(info.head_seq, UINT32_MAX);
+    zassert_equal(info.tail_sector, 1);
+
+    /* 每切换一个扇区重启一次，头部位置和序号都要接得上，序号跳过 0 */
+    for (int k = 0; k < 4; k++) {
+        uint32_t head_before = info.head_sector;
+
+        while (put(idx++).sector == head_before) {
+        }
+        expect_seq = seq_next(expect_seq);
+
+        remount();
+        flash_ring_get_info(&info);
+        zassert_equal(info.head_sector, ring_next(head_before), "第 %d 次切换后头部在 %u",
+                      k, info.head_sector);
+        zassert_equal(info.head_seq, expect_seq);
+        zassert_not_equal(info.head_seq, RING_SEQ_INVALID);
+        zassert_equal(info.tail_sector, ring_next(ring_next(info.head_sector)));
+    }
+    zassert_equal(expect_seq, 4);
+    assert_consecutive(read_ids(), 0, idx - 1);
+}
+
+static void wipe(void *fixture)
+{
+    ARG_UNUSED(fixture);
+
+    zassert_ok(flash_ring_init());
+    zassert_ok(flash_area_erase(fa, 0, fa->fa_size));
+    remount();
+}
+
+ZTEST_SUITE(flash_ring, NULL, NULL, wipe, NULL, NULL);
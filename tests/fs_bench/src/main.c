@@ -0,0 +1,35 @@
+/*
+ * tests/fs_bench/src/main.c
+ * 等待 fs_thread 挂载 /lfs 后执行一次 lfs bench，把 Shell 输出打印到控制台
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/shell/shell_dummy.h>
+
+#include "boot_prof.h"
+
+#define BENCH_CMD  "lfs bench 256"
+
+int main(void)
+{
+    const struct shell *sh = shell_backend_dummy_get_ptr();
+    const char *out;
+    size_t len;
+    int ret;
+
+    if (boot_ready_wait(BOOT_READY_FS, K_SECONDS(30)) < 0) {
+        printk("/lfs 挂载失败\n");
+        return 0;
+    }
+
+    /* 让哑后端的 Shell 线程先完成初始化 */
+    k_msleep(10);
+
+    shell_backend_dummy_clear_output(sh);
+    ret = shell_execute_cmd(sh, BENCH_CMD);
+    out = shell_backend_dummy_get_output(sh, &len);
+    printk("%.*s\n", (int)len, out);
+    printk("lfs bench 完成: %d\n", ret);
+    return 0;
+}
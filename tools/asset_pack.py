@@ -0,0 +1,265 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+字体/图片资源包打包工具 (对应固件 include/asset_store.h)
+
+用法:
+    # 字体先用 lv_font_conv 生成 LVGL C 文件 (不要字距表):
+    #   lv_font_conv --bpp 4 --size 16 --no-compress --no-kerning --format lvgl \\
+    #       --font SourceHanSansCN.otf -r 0x20-0x7F --symbols "温度湿度..." -o cn16.c
+    python asset_pack.py -o assets.bin --font cn16=cn16.c --image logo=logo.png
+    python asset_pack.py -o assets.bin --font cn16=cn16.c --image icon=icon.png:alpha
+
+    # 仪表盘圆环中的数值字体 (固件按名称 dash_value 查找，没有时使用默认字体):
+    #   lv_font_conv --bpp 4 --size 24 --no-compress --no-kerning --format lvgl \
+    #       --font Montserrat-Medium.ttf -r 0x2D-0x39 -o dash_value.c
+    python asset_pack.py -o assets.bin --font dash_value=dash_value.c --font cn16=cn16.c
+
+    # 硬件: 烧录到 font_partition (W25Q128 偏移 0x200000)
+    # native_sim: 直接写进 Flash 模拟器的后备文件 (运行参数 --flash=flash.bin)
+    python asset_pack.py -o assets.bin --font cn16=cn16.c --flash-image flash.bin
+
+资源包格式 (小端):
+    [magic u32][version u16][count u16][total_size u32][crc u32]
+    [name 24s][type u8][reserved 3s][offset u32][size u32] * count
+    各资源数据，4 字节对齐
+字形描述表按 LVGL 的 lv_font_fmt_txt_glyph_dsc_t 布局写出，固件直接使用；
+固件开启 LV_FONT_FMT_TXT_LARGE 时需要加 --large。
+图片需要 Pillow: pip install pillow
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+import zlib
+
+PACK_MAGIC = 0x50545341
+PACK_VERSION = 1
+NAME_LEN = 24
+PACK_HDR = struct.Struct("<IHHII")
+ENTRY = struct.Struct("<%dsB3sII" % NAME_LEN)
+FONT_HDR = struct.Struct("<HhbBBBHHB3sIII")
+FONT_CMAP = struct.Struct("<IHHIIHBB")
+IMAGE_HDR = struct.Struct("<BBHHHI")
+
+TYPE_FONT = 1
+TYPE_IMAGE = 2
+FONT_FLAG_LARGE = 0x01
+
+# lv_color_format_t
+CF_RGB565 = 0x12
+CF_RGB565A8 = 0x14
+
+CMAP_TYPES = {
+    "LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL": 0,
+    "LV_FONT_FMT_TXT_CMAP_SPARSE_FULL": 1,
+    "LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY": 2,
+    "LV_FONT_FMT_TXT_CMAP_SPARSE_TINY": 3,
+}
+
+FLASH_SIZE = 16 * 1024 * 1024
+FONT_PARTITION_OFFSET = 0x200000
+FONT_PARTITION_SIZE = 0x5A0000
+
+
+def align4(buf):
+    buf += b"\x00" * (-len(buf) % 4)
+    return buf
+
+
+def c_array(src, name):
+    """取出 C 数组 name[] = { ... } 的内容"""
+    m = re.search(r"\b%s\s*\[\s*\]\s*=\s*\{(.*?)\};" % re.escape(name), src, re.S)
+    if not m:
+        return None
+    return re.sub(r"/\*.*?\*/", "", m.group(1), flags=re.S)
+
+
+def c_numbers(body):
+    return [int(x, 0) for x in re.findall(r"-?(?:0x[0-9a-fA-F]+|\d+)", body)]
+
+
+def c_field(src, field, default=None):
+    m = re.search(r"\.%s\s*=\s*(-?(?:0x[0-9a-fA-F]+|\d+))" % field, src)
+    if not m:
+        if default is None:
+            raise ValueError("找不到字段 .%s" % field)
+        return default
+    return int(m.group(1), 0)
+
+
+def pack_font(path, large):
+    src = open(path, encoding="utf-8").read()
+
+    if re.search(r"\.kern_dsc\s*=\s*&", src):
+        print("警告: %s 带有字距表，资源包中会忽略 (建议 --no-kerning)" % path, file=sys.stderr)
+    if c_field(src, "bitmap_format", 0) != 0:
+        print("警告: %s 是压缩位图，渲染时需要额外解压 (建议 --no-compress)" % path, file=sys.stderr)
+
+    bitmap = bytes(c_numbers(c_array(src, "glyph_bitmap")))
+
+    glyphs = []
+    dsc_body = c_array(src, "glyph_dsc")
+    for m in re.finditer(r"\{([^{}]*)\}", dsc_body):
+        g = dict((k, int(v, 0)) for k, v in
+                 re.findall(r"\.(\w+)\s*=\s*(-?(?:0x[0-9a-fA-F]+|\d+))", m.group(1)))
+        glyphs.append(g)
+
+    dsc = bytearray()
+    for g in glyphs:
+        if large:
+            dsc += struct.pack("<IIHHhh", g["bitmap_index"], g["adv_w"],
+                               g["box_w"], g["box_h"], g["ofs_x"], g["ofs_y"])
+        else:
+            if g["bitmap_index"] >= 1 << 20 or g["adv_w"] >= 1 << 12:
+                raise ValueError("%s: 位图超过 1MB 或字宽过大，需要 --large" % path)
+            dsc += struct.pack("<IBBbb", g["bitmap_index"] | (g["adv_w"] << 20),
+                               g["box_w"], g["box_h"], g["ofs_x"], g["ofs_y"])
+
+    cmaps = []
+    cmap_body = c_array(src, "cmaps")
+    for m in re.finditer(r"\{([^{}]*)\}", cmap_body):
+        body = m.group(1)
+        ul = re.search(r"\.unicode_list\s*=\s*(\w+)", body).group(1)
+        ol = re.search(r"\.glyph_id_ofs_list\s*=\s*(\w+)", body).group(1)
+        t = re.search(r"\.type\s*=\s*(\w+)", body).group(1)
+        cmaps.append({
+            "range_start": c_field(body, "range_start"),
+            "range_length": c_field(body, "range_length"),
+            "glyph_id_start": c_field(body, "glyph_id_start"),
+            "list_length": c_field(body, "list_length"),
+            "unicode_list": None if ul == "NULL" else c_numbers(c_array(src, ul)),
+            "glyph_id_ofs_list": None if ol == "NULL" else c_numbers(c_array(src, ol)),
+            "type": CMAP_TYPES[t],
+        })
+
+    # 布局: 头部 | 字形描述表 | 位图 | 字符映射表 | 各映射段的列表
+    out = bytearray(FONT_HDR.size)
+    align4(out)
+    glyph_dsc_off = len(out)
+    out += dsc
+    bitmap_off = len(out)
+    out += bitmap
+    align4(out)
+    cmaps_off = len(out)
+    out += bytes(FONT_CMAP.size * len(cmaps))
+    for i, c in enumerate(cmaps):
+        ul_off = ol_off = 0
+        if c["unicode_list"] is not None:
+            align4(out)
+            ul_off = len(out)
+            out += struct.pack("<%dH" % len(c["unicode_list"]), *c["unicode_list"])
+        if c["glyph_id_ofs_list"] is not None:
+            align4(out)
+            ol_off = len(out)
+            if c["type"] == CMAP_TYPES["LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL"]:
+                out += bytes(c["glyph_id_ofs_list"])
+            else:
+                out += struct.pack("<%dH" % len(c["glyph_id_ofs_list"]), *c["glyph_id_ofs_list"])
+        FONT_CMAP.pack_into(out, cmaps_off + i * FONT_CMAP.size,
+                            c["range_start"], c["range_length"], c["glyph_id_start"],
+                            ul_off, ol_off, c["list_length"], c["type"], 0)
+
+    FONT_HDR.pack_into(out, 0,
+                       c_field(src, "line_height"), c_field(src, "base_line"),
+                       c_field(src, "underline_position", 0), c_field(src, "underline_thickness", 0),
+                       c_field(src, "bpp"), c_field(src, "bitmap_format", 0),
+                       len(cmaps), len(glyphs), FONT_FLAG_LARGE if large else 0, b"",
+                       glyph_dsc_off, bitmap_off, cmaps_off)
+    print("字体 %s: %d 个字形, 位图 %d KB, %d 个映射段" %
+          (path, len(glyphs), len(bitmap) // 1024, len(cmaps)))
+    return bytes(align4(out))
+
+
+def pack_image(path, alpha):
+    from PIL import Image
+
+    img = Image.open(path).convert("RGBA")
+    w, h = img.size
+    px = img.load()
+    rgb = bytearray()
+    a = bytearray()
+    for y in range(h):
+        for x in range(w):
+            r, g, b, al = px[x, y]
+            rgb += struct.pack("<H", ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3))
+            a.append(al)
+    data = rgb + a if alpha else rgb
+    cf = CF_RGB565A8 if alpha else CF_RGB565
+    print("图片 %s: %dx%d %s, %d KB" % (path, w, h, "RGB565A8" if alpha else "RGB565",
+                                       len(data) // 1024))
+    return bytes(align4(bytearray(IMAGE_HDR.pack(cf, 0, w, h, w * 2, len(data)) + data)))
+
+
+def build(items):
+    table_size = PACK_HDR.size + ENTRY.size * len(items)
+    body = bytearray(ENTRY.size * len(items))
+    offset = PACK_HDR.size + len(body)
+    offset += -offset % 4
+    body += b"\x00" * (offset - table_size)
+
+    for i, (name, kind, data) in enumerate(items):
+        ENTRY.pack_into(body, i * ENTRY.size, name.encode("utf-8"), kind, b"", offset, len(data))
+        body += data
+        offset += len(data)
+
+    hdr = PACK_HDR.pack(PACK_MAGIC, PACK_VERSION, len(items), PACK_HDR.size + len(body),
+                        zlib.crc32(body) & 0xFFFFFFFF)
+    return hdr + bytes(body)
+
+
+def write_flash_image(path, offset, blob):
+    """写进 Flash 模拟器的后备文件，文件不存在时按擦除状态 (0xFF) 新建"""
+    if not os.path.exists(path):
+        with open(path, "wb") as f:
+            f.write(b"\xff" * FLASH_SIZE)
+    with open(path, "r+b") as f:
+        f.seek(offset)
+        f.write(blob)
+
+
+def name_arg(s):
+    name, sep, value = s.partition("=")
+    if not sep or not name or len(name.encode("utf-8")) >= NAME_LEN:
+        raise argparse.ArgumentTypeError("格式为 名称=文件，名称不超过 %d 字节" % (NAME_LEN - 1))
+    return name, value
+
+
+def main():
+    ap = argparse.ArgumentParser(description="打包字体/图片资源到 font_partition")
+    ap.add_argument("-o", "--out", default="assets.bin", help="资源包输出文件")
+    ap.add_argument("--font", action="append", default=[], type=name_arg,
+                    help="名称=lv_font_conv 生成的 .c 文件")
+    ap.add_argument("--image", action="append", default=[], type=name_arg,
+                    help="名称=图片文件[:alpha]")
+    ap.add_argument("--large", action="store_true", help="固件开启了 LV_FONT_FMT_TXT_LARGE")
+    ap.add_argument("--flash-image", help="同时写入 Flash 模拟器后备文件 (native_sim)")
+    ap.add_argument("--offset", type=lambda x: int(x, 0), default=FONT_PARTITION_OFFSET,
+                    help="分区偏移 (默认 0x%X)" % FONT_PARTITION_OFFSET)
+    args = ap.parse_args()
+
+    items = []
+    for name, path in args.font:
+        items.append((name, TYPE_FONT, pack_font(path, args.large)))
+    for name, spec in args.image:
+        path, _, opt = spec.partition(":")
+        items.append((name, TYPE_IMAGE, pack_image(path, opt == "alpha")))
+    if not items:
+        ap.error("至少需要一个 --font 或 --image")
+
+    blob = build(items)
+    if len(blob) > FONT_PARTITION_SIZE:
+        sys.exit("资源包 %d 字节，超过分区大小 %d" % (len(blob), FONT_PARTITION_SIZE))
+    with open(args.out, "wb") as f:
+        f.write(blob)
+    print("资源包 %s: %d 项, %d KB" % (args.out, len(items), len(blob) // 1024))
+
+    if args.flash_image:
+        write_flash_image(args.flash_image, args.offset, blob)
+        print("已写入 %s @ 0x%X" % (args.flash_image, args.offset))
+
+
+if __name__ == "__main__":
+    main()
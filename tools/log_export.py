@@ -0,0 +1,202 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+日志二进制导出的主机端接收工具 (对应固件 datalog export 命令)
+
+用法:
+    python log_export.py COM5                     # 导出全部，保存为 export.bin
+    python log_export.py /dev/pts/3 --csv out.csv # native_sim 的 UART 伪终端，同时解码为 CSV
+    python log_export.py COM5 --resume            # 从上次中断的位置续传
+
+协议 (见 include/log_export.h):
+    每帧 COBS 编码，以 0x00 结尾；解码后为
+    [type u8][version u8][len u16][seg u32][offset u32][data ...][crc32 u32]
+需要 pyserial: pip install pyserial
+"""
+
+import argparse
+import json
+import os
+import struct
+import sys
+import time
+import zlib
+
+import serial
+
+EXPORT_START = 1
+EXPORT_DATA = 2
+EXPORT_END = 3
+HDR = struct.Struct("<BBHII")
+
+TS_FRAME_MAGIC = 0x3254
+TS_HDR = struct.Struct("<HHHHII")
+
+
+def cobs_decode(buf):
+    out = bytearray()
+    i = 0
+    while i < len(buf):
+        code = buf[i]
+        if code == 0 or i + code > len(buf) + 1:
+            raise ValueError("bad cobs")
+        out += buf[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(buf):
+            out.append(0)
+    return bytes(out)
+
+
+def read_frames(port):
+    """逐帧产出 (type, seg, offset, data)，CRC 错误的帧 (例如命令回显) 直接丢弃"""
+    pending = bytearray()
+    while True:
+        chunk = port.read(4096)
+        if not chunk:
+            raise TimeoutError("串口超时，没有收到结束帧")
+        pending += chunk
+        while True:
+            end = pending.find(b"\x00")
+            if end < 0:
+                break
+            raw, pending = bytes(pending[:end]), pending[end + 1:]
+            if not raw:
+                continue
+            try:
+                frame = cobs_decode(raw)
+            except ValueError:
+                continue
+            if len(frame) < HDR.size + 4:
+                continue
+            body, crc = frame[:-4], struct.unpack("<I", frame[-4:])[0]
+            if zlib.crc32(body) != crc:
+                continue
+            ftype, _ver, length, seg, offset = HDR.unpack_from(body)
+            yield ftype, seg, offset, body[HDR.size:HDR.size + length]
+
+
+# ---------------- ts_codec 解码 (与 src/ts_codec.c 保持一致) ----------------
+
+class BitReader:
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def get(self, n):
+        v = 0
+        for _ in range(n):
+            byte = self.data[self.pos >> 3]
+            v = (v << 1) | ((byte >> (7 - (self.pos & 7))) & 1)
+            self.pos += 1
+        return v
+
+
+def unzigzag(v):
+    return (v >> 1) ^ -(v & 1)
+
+
+def decode_frames(stream):
+    """把分段原始内容解码为 (ts, temperature, humidity, lux)"""
+    pos = 0
+    while pos + TS_HDR.size <= len(stream):
+        magic, count, length, crc, first_ts, _last = TS_HDR.unpack_from(stream, pos)
+        if magic != TS_FRAME_MAGIC or length < TS_HDR.size or pos + length > len(stream):
+            pos += 1    # 损坏或不完整，逐字节重新同步
+            continue
+        payload = stream[pos + TS_HDR.size:pos + length]
+        # CRC 覆盖帧头 (crc 字段按 0 计算) 和比特流
+        hdr0 = TS_HDR.pack(magic, count, length, 0, first_ts, _last)
+        if _crc16_ccitt(payload, _crc16_ccitt(hdr0)) != crc:
+            pos += 1
+            continue
+        br = BitReader(payload)
+        ts, delta, val = first_ts, 0, [0, 0, 0]
+        for n in range(count):
+            if n > 0:
+                delta += unzigzag(_prefix(br, (7, 9, 12, 32)))
+                ts += delta
+            for i in range(3):
+                val[i] += unzigzag(_prefix(br, (6, 12, 32)))
+            yield ts & 0xFFFFFFFF, val[0] / 100.0, val[1] / 100.0, val[2] & 0xFFFF
+        pos += length
+
+
+def _prefix(br, widths):
+    """前缀码: '0' -> 0; '10'+w0; '110'+w1; ... 最后一级前缀没有结尾的 0"""
+    if br.get(1) == 0:
+        return 0
+    for level, width in enumerate(widths):
+        if level == len(widths) - 1 or br.get(1) == 0:
+            return br.get(width)
+    return 0
+
+
+def _crc16_ccitt(data, seed=0xFFFF):
+    # Zephyr crc16_ccitt: 多项式 0x1021，反射实现 (与 crc16_reflect 一致)
+    crc = seed
+    for b in data:
+        e = (crc ^ b) & 0xFF
+        f = (e ^ (e << 4)) & 0xFF
+        crc = ((crc >> 8) ^ (f << 8) ^ (f << 3) ^ (f >> 4)) & 0xFFFF
+    return crc
+
+
+def main():
+    ap = argparse.ArgumentParser(description="接收 datalog export 的二进制日志流")
+    ap.add_argument("port", help="串口，例如 COM5 或 /dev/pts/3 (native_sim)")
+    ap.add_argument("-b", "--baud", type=int, default=115200)
+    ap.add_argument("-o", "--out", default="export.bin", help="原始分段数据输出文件")
+    ap.add_argument("--csv", help="同时解码为 CSV")
+    ap.add_argument("--resume", action="store_true", help="从上次记录的位置续传")
+    args = ap.parse_args()
+
+    state_path = args.out + ".state"
+    seg, offset = 0, 0
+    if args.resume and os.path.exists(state_path):
+        with open(state_path) as f:
+            st = json.load(f)
+        seg, offset = st["seg"], st["offset"]
+
+    port = serial.Serial(args.port, args.baud, timeout=5)
+    port.reset_input_buffer()
+    port.write(f"datalog export {seg} {offset}\r\n".encode())
+
+    mode = "ab" if args.resume else "wb"
+    received = 0
+    t0 = time.monotonic()
+    with open(args.out, mode) as out:
+        for ftype, fseg, foff, data in read_frames(port):
+            if ftype == EXPORT_START:
+                segments, total = struct.unpack("<II", data[:8])
+                print(f"开始导出: {segments} 个分段, {total} 字节")
+            elif ftype == EXPORT_DATA:
+                out.write(data)
+                received += len(data)
+                with open(state_path, "w") as f:
+                    json.dump({"seg": fseg, "offset": foff + len(data)}, f)
+                sys.stdout.write(f"\r已接收 {received} 字节")
+                sys.stdout.flush()
+            elif ftype == EXPORT_END:
+                sent, ms, status = struct.unpack("<IIi", data[:12])
+                break
+
+    elapsed = time.monotonic() - t0
+    print()
+    print(f"设备发送 {sent} 字节, 设备耗时 {ms} ms, 状态 {status}")
+    if elapsed > 0:
+        rate = received / elapsed
+        line = args.baud / 10
+        print(f"吞吐量 {rate:.0f} B/s, 线路速率 {line:.0f} B/s ({rate / line * 100:.1f}%)")
+
+    if args.csv:
+        with open(args.out, "rb") as f:
+            stream = f.read()
+        with open(args.csv, "w") as f:
+            f.write("timestamp,temperature,humidity,lux\n")
+            for ts, t, h, l in decode_frames(stream):
+                f.write(f"{ts},{t:.2f},{h:.2f},{l}\n")
+        print(f"已解码到 {args.csv}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,116 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+实时遥测流的主机端接收工具 (对应固件 telem start 命令)
+
+用法:
+    python telemetry_rx.py COM5                  # 打印统计
+    python telemetry_rx.py COM5 --csv imu.csv    # 同时保存样本
+
+帧格式见 include/telemetry.h：
+    [0xA5 0x5A][mask u8][len u8][seq u32][ts_us u32][payload][crc16 u16]
+遥测使用独立串口 (Pandora 上是 usart2, PA2/PA3, 921600)，不是 Shell 串口；
+按同步字重新同步，CRC 不对的数据 (例如线路误码) 直接跳过；
+序号缺口即为丢帧 (设备端缓冲区满或串口传输出错)。
+需要 pyserial: pip install pyserial
+"""
+
+import argparse
+import struct
+import time
+
+import serial
+
+SYNC = b"\xA5\x5A"
+HDR = struct.Struct("<BBII")   # mask, len, seq, ts_us (同步字之后)
+CH_IMU, CH_ENV, CH_LUX = 0x1, 0x2, 0x4
+
+
+def crc16_ccitt(data, seed=0xFFFF):
+    # 与 Zephyr crc16_ccitt 相同的实现
+    crc = seed
+    for b in data:
+        e = (crc ^ b) & 0xFF
+        f = (e ^ (e << 4)) & 0xFF
+        crc = ((crc >> 8) ^ (f << 8) ^ (f << 3) ^ (f >> 4)) & 0xFFFF
+    return crc
+
+
+def parse(buf):
+    """从缓冲区中解析出所有完整帧，返回 (帧列表, 剩余数据)"""
+    frames = []
+    while True:
+        start = buf.find(SYNC)
+        if start < 0:
+            return frames, buf[-1:]
+        if len(buf) - start < 2 + HDR.size:
+            return frames, buf[start:]
+        mask, length, seq, ts = HDR.unpack_from(buf, start + 2)
+        end = start + 2 + HDR.size + length + 2
+        if end > len(buf):
+            return frames, buf[start:]
+        body = buf[start + 2:end - 2]
+        if crc16_ccitt(body) == struct.unpack_from("<H", buf, end - 2)[0]:
+            frames.append((mask, seq, ts, body[HDR.size:]))
+            buf = buf[end:]
+        else:
+            buf = buf[start + 1:]
+
+
+def decode_payload(mask, payload):
+    fields, p = [], 0
+    if mask & CH_IMU:
+        fields += struct.unpack_from("<6h", payload, p)
+        p += 12
+    if mask & CH_ENV:
+        t, h = struct.unpack_from("<2h", payload, p)
+        fields += [t / 100.0, h / 100.0]
+        p += 4
+    if mask & CH_LUX:
+        fields += struct.unpack_from("<H", payload, p)
+    return fields
+
+
+def main():
+    ap = argparse.ArgumentParser(description="接收 telem 二进制遥测流")
+    ap.add_argument("port")
+    ap.add_argument("-b", "--baud", type=int, default=921600)
+    ap.add_argument("--csv", help="保存样本到 CSV")
+    args = ap.parse_args()
+
+    port = serial.Serial(args.port, args.baud, timeout=0.2)
+    out = open(args.csv, "w") if args.csv else None
+    buf = b""
+    last_seq = None
+    frames = lost = nbytes = 0
+    t_report = t0 = time.monotonic()
+
+    try:
+        while True:
+            chunk = port.read(4096)
+            nbytes += len(chunk)
+            found, buf = parse(buf + chunk)
+            for mask, seq, ts, payload in found:
+                if last_seq is not None and seq != (last_seq + 1) & 0xFFFFFFFF:
+                    lost += (seq - last_seq - 1) & 0xFFFFFFFF
+                last_seq = seq
+                frames += 1
+                if out:
+                    out.write(",".join(str(v) for v in [seq, ts] + decode_payload(mask, payload)) + "\n")
+
+            now = time.monotonic()
+            if now - t_report >= 1.0:
+                rate = frames / (now - t0)
+                loss = lost / max(frames + lost, 1) * 100
+                print(f"帧 {frames} ({rate:.0f}/s), 丢帧 {lost} ({loss:.2f}%), "
+                      f"{nbytes / (now - t0):.0f} B/s")
+                t_report = now
+    except KeyboardInterrupt:
+        pass
+    finally:
+        if out:
+            out.close()
+
+
+if __name__ == "__main__":
+    main()